@@ -20,6 +20,9 @@ class IRenderer {
   public:
     virtual ~IRenderer() = default;
 
+    // Takes effect on the next Initialize (backends may ignore options they do not support).
+    virtual void SetOptions(const RendererOptions&) {}
+
     virtual void Initialize(GLFWwindow* window, const Environment& environment,
                             const Model& model) = 0;
     virtual void Shutdown() {}
@@ -29,4 +32,7 @@ class IRenderer {
     virtual void ReloadShaders() {}
     virtual void UpdateModel(const Model&) {}
     virtual void UpdateEnvironment(const Environment&) {}
+
+    // Backends that do not count anything report zeros.
+    virtual FrameStats GetFrameStats() const { return {}; }
 };
@@ -3,6 +3,9 @@
 
 #pragma once
 
+// Standard Library Headers
+#include <cstdint>
+
 // Third-Party Library Headers
 #include <glm/glm.hpp>
 
@@ -11,3 +14,30 @@ struct CameraUniformsInput {
     glm::mat4 projectionMatrix{};
     glm::vec3 cameraPosition{};
 };
+
+// Backend-independent rendering options, set before IRenderer::Initialize.
+struct RendererOptions {
+    bool packedVertices{false};     // Upload quantized 28-byte vertices instead of Model::Vertex
+    bool splitVertexStreams{false}; // Positions in their own stream, attributes in a second one
+    bool depthPrepass{false};       // Lay down opaque depth with position-only draws first
+    bool meshletCulling{false};     // Cull opaque meshlets on the GPU (needs Model meshlets)
+    bool frustumCulling{true};      // Skip submeshes whose bounds are outside the view frustum
+    bool gpuDrivenDraws{false};     // Cull opaque draws on the GPU and replay them indirectly
+    bool occlusionCulling{false};   // Test GPU-driven draws against a Hi-Z pyramid (needs them)
+    bool renderBundles{false};      // Replay opaque draws from bundles recorded at load; without
+                                    // GPU-driven draws they skip CPU culling and LOD selection
+};
+
+// Counters of the most recently rendered frame.
+struct FrameStats {
+    uint32_t subMeshes{0};           // Opaque and transparent submeshes in the model
+    uint32_t culledSubMeshes{0};     // Skipped because all their instances were outside the frustum
+    uint32_t drawCalls{0};           // Submesh draws encoded in the main pass
+    uint32_t opaqueMaterialBinds{0}; // Material bind group changes among the opaque draws
+    float encodeMilliseconds{0.0f};  // CPU time culling, sorting and recording the frame
+
+    // Occlusion culling, as of the last periodic read from the GPU: draws in the frustum that the
+    // Hi-Z test skipped, and the triangles they would have rasterized.
+    uint32_t occludedSubMeshes{0};
+    uint32_t occludedTriangles{0};
+};
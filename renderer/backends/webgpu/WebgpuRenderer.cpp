@@ -3,10 +3,15 @@
 
 // Standard Library Headers
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <chrono>
 #include <cmath>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 // Third-Party Library Headers
@@ -31,10 +36,14 @@
 #include "BackendRegistry.h"
 #include "Environment.h"
 #include "EnvironmentPreprocessor.h"
+#include "MeshUtils.h"
 #include "MipmapGenerator.h"
 #include "Model.h"
 #include "PanoramaToCubemapConverter.h"
 #include "ShaderUtils.h"
+#include "TextureCodecs.h"
+#include "VertexKernels.h"
+#include "VertexPacking.h"
 #include "WebgpuConfig.h"
 
 //----------------------------------------------------------------------
@@ -54,6 +63,123 @@ constexpr uint32_t kIrradianceMapSize = 64;
 constexpr uint32_t kPrecomputedSpecularMapSize = 512;
 constexpr uint32_t kBRDFIntegrationLUTMapSize = 128;
 
+// Frames between reads of the meshlet culling results.
+constexpr uint32_t kMeshletStatsInterval = 300;
+
+// Must match WORKGROUP_SIZE in draw_cull.wgsl and hiz_build.wgsl.
+constexpr uint32_t kDrawCullWorkgroupSize = 64;
+constexpr uint32_t kHiZWorkgroupSize = 8;
+
+// WebGPU's default maxComputeWorkgroupsPerDimension.
+constexpr uint32_t kMaxWorkgroupsPerDimension = 65535;
+
+// LOD selection: the coarsest level whose simplification error projects below this many pixels,
+// with a band around the threshold that a level must cross before it switches back.
+constexpr float kLodErrorPixels = 1.0f;
+constexpr float kLodHysteresis = 0.25f;
+
+double ToMegabytes(size_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+// Creates a buffer holding a copy of `data`.
+template <typename T>
+wgpu::Buffer CreateBufferFromData(wgpu::Device device, wgpu::BufferUsage usage,
+                                  const std::vector<T>& data) {
+    wgpu::BufferDescriptor descriptor{};
+    descriptor.size = data.size() * sizeof(T);
+    descriptor.usage = usage | wgpu::BufferUsage::CopyDst;
+    descriptor.mappedAtCreation = true;
+
+    wgpu::Buffer buffer = device.CreateBuffer(&descriptor);
+    std::memcpy(buffer.GetMappedRange(), data.data(), descriptor.size);
+    buffer.Unmap();
+    return buffer;
+}
+
+// Inverse transpose of the upper 3x3 of `matrix`, in a mat4 for the shaders.
+glm::mat4 GetNormalMatrix(const glm::mat4& matrix) {
+    const glm::mat3 normalMatrix3x3 = glm::transpose(glm::inverse(glm::mat3(matrix)));
+    glm::mat4 normalMatrix(1.0f);
+    normalMatrix[0] = glm::vec4(normalMatrix3x3[0], 0.0f);
+    normalMatrix[1] = glm::vec4(normalMatrix3x3[1], 0.0f);
+    normalMatrix[2] = glm::vec4(normalMatrix3x3[2], 0.0f);
+    return normalMatrix;
+}
+
+// Largest factor by which `matrix` stretches a length.
+float GetMaxScale(const glm::mat4& matrix) {
+    return std::max({glm::length(glm::vec3(matrix[0])), glm::length(glm::vec3(matrix[1])),
+                     glm::length(glm::vec3(matrix[2]))});
+}
+
+// Normalized planes (left, right, bottom, top, near, far) bounding the clip volume of `matrix`,
+// in the space it transforms from, with xyz pointing inwards. Assumes [0, 1] clip depth.
+void ExtractFrustumPlanes(const glm::mat4& matrix, glm::vec4 planes[6]) {
+    const glm::mat4 rows = glm::transpose(matrix);
+    planes[0] = rows[3] + rows[0];
+    planes[1] = rows[3] - rows[0];
+    planes[2] = rows[3] + rows[1];
+    planes[3] = rows[3] - rows[1];
+    planes[4] = rows[2];
+    planes[5] = rows[3] - rows[2];
+    for (int i = 0; i < 6; ++i) {
+        planes[i] /= glm::length(glm::vec3(planes[i]));
+    }
+}
+
+// Opaque draw sort keys, most significant field first. Masked materials share the opaque pipeline
+// but discard, which turns off early depth testing, so they go after the opaque ones. Then come
+// the material, the index format, and the view depth's top 16 float bits (about 1% steps), so
+// state changes are grouped and each group draws front to back.
+constexpr int kSortKeyMaskedShift = 60;
+constexpr int kSortKeyMaterialShift = 32;
+constexpr uint64_t kSortKeyMaterialMask = (uint64_t{1} << 28) - 1;
+constexpr int kSortKeyIndexFormatShift = 31;
+
+uint64_t MakeOpaqueSortKey(bool masked, int materialIndex, bool is16Bit, float depth) {
+    const uint32_t depthBits = std::bit_cast<uint32_t>(std::max(depth, 0.0f)) >> 16;
+    return (uint64_t{masked} << kSortKeyMaskedShift) |
+           ((static_cast<uint64_t>(materialIndex) & kSortKeyMaterialMask)
+            << kSortKeyMaterialShift) |
+           (uint64_t{!is16Bit} << kSortKeyIndexFormatShift) | depthBits;
+}
+
+// Stable LSD radix sort of `items` by their 64-bit _key, one byte per pass. Passes where every key
+// has the same byte are skipped, which leaves about four for typical keys. `scratch` is reused.
+template <typename Item>
+void RadixSortByKey(std::vector<Item>& items, std::vector<Item>& scratch) {
+    if (items.size() < 2) {
+        return;
+    }
+
+    std::array<std::array<uint32_t, 256>, 8> histograms{};
+    for (const Item& item : items) {
+        for (int pass = 0; pass < 8; ++pass) {
+            ++histograms[pass][(item._key >> (8 * pass)) & 0xFF];
+        }
+    }
+
+    scratch.resize(items.size());
+    for (int pass = 0; pass < 8; ++pass) {
+        std::array<uint32_t, 256>& offsets = histograms[pass];
+        if (offsets[(items[0]._key >> (8 * pass)) & 0xFF] == items.size()) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (uint32_t& count : offsets) {
+            const uint32_t bucketSize = count;
+            count = offset;
+            offset += bucketSize;
+        }
+        for (const Item& item : items) {
+            scratch[offsets[(item._key >> (8 * pass)) & 0xFF]++] = item;
+        }
+        items.swap(scratch);
+    }
+}
+
 int FloorPow2(int x) {
     int power = 1;
     while (power * 2 <= x) {
@@ -62,10 +188,155 @@ int FloorPow2(int x) {
     return power;
 }
 
+// Textures whose mip chain came with the model (KTX2 files or import-time compression), by how
+// they reached the GPU.
+struct TextureUploadStats {
+    size_t _direct{0};        // Uploaded in their own format (block-compressed or RGBA8)
+    size_t _decoded{0};       // Expanded to RGBA8 on the CPU (device lacks the format)
+    size_t _unsupported{0};   // Neither; the slot's default texture is used instead
+    size_t _uploadedBytes{0}; // Bytes written for the above
+    size_t _rgba8Bytes{0};    // What the same textures cost as RGBA8 with a full mip chain
+};
+
+// WebGPU format for a block-compressed texture, in the color space `rgba8Format` (the slot's
+// RGBA8 format) asks for, and the device feature needed to sample it.
+bool GetCompressedFormat(Model::TextureFormat format, wgpu::TextureFormat rgba8Format,
+                         wgpu::TextureFormat& compressedFormat, wgpu::FeatureName& feature) {
+    using Format = Model::TextureFormat;
+    const bool srgb = rgba8Format == wgpu::TextureFormat::RGBA8UnormSrgb;
+    switch (format) {
+    case Format::BC1:
+        compressedFormat =
+            srgb ? wgpu::TextureFormat::BC1RGBAUnormSrgb : wgpu::TextureFormat::BC1RGBAUnorm;
+        feature = wgpu::FeatureName::TextureCompressionBC;
+        return true;
+    case Format::BC3:
+        compressedFormat =
+            srgb ? wgpu::TextureFormat::BC3RGBAUnormSrgb : wgpu::TextureFormat::BC3RGBAUnorm;
+        feature = wgpu::FeatureName::TextureCompressionBC;
+        return true;
+    case Format::BC4:
+        compressedFormat = wgpu::TextureFormat::BC4RUnorm;
+        feature = wgpu::FeatureName::TextureCompressionBC;
+        return true;
+    case Format::BC5:
+        compressedFormat = wgpu::TextureFormat::BC5RGUnorm;
+        feature = wgpu::FeatureName::TextureCompressionBC;
+        return true;
+    case Format::BC7:
+        compressedFormat =
+            srgb ? wgpu::TextureFormat::BC7RGBAUnormSrgb : wgpu::TextureFormat::BC7RGBAUnorm;
+        feature = wgpu::FeatureName::TextureCompressionBC;
+        return true;
+    case Format::ETC2RGB8:
+        compressedFormat =
+            srgb ? wgpu::TextureFormat::ETC2RGB8UnormSrgb : wgpu::TextureFormat::ETC2RGB8Unorm;
+        feature = wgpu::FeatureName::TextureCompressionETC2;
+        return true;
+    case Format::ETC2RGBA8:
+        compressedFormat =
+            srgb ? wgpu::TextureFormat::ETC2RGBA8UnormSrgb : wgpu::TextureFormat::ETC2RGBA8Unorm;
+        feature = wgpu::FeatureName::TextureCompressionETC2;
+        return true;
+    case Format::ASTC4x4:
+        compressedFormat =
+            srgb ? wgpu::TextureFormat::ASTC4x4UnormSrgb : wgpu::TextureFormat::ASTC4x4Unorm;
+        feature = wgpu::FeatureName::TextureCompressionASTC;
+        return true;
+    case Format::RGBA8:
+        break;
+    }
+    return false;
+}
+
+// Uploads a texture whose mip chain came with it, skipping mip generation. Block formats the
+// device samples are uploaded as they are; otherwise BC1-5 are expanded to RGBA8 on the CPU.
+// Returns false if the texture cannot be used on this device.
+bool CreateTextureFromLevels(const Model::Texture& textureInfo, wgpu::TextureFormat format,
+                             wgpu::Device device, TextureUploadStats& stats,
+                             wgpu::Texture& texture) {
+    const std::vector<Model::MipLevel>& levels = textureInfo._mipLevels;
+    const texture_codecs::BlockInfo block = texture_codecs::GetBlockInfo(textureInfo._format);
+
+    // Compressed textures must be whole blocks at level 0. RGBA8 levels are uploaded directly
+    // too, as 1x1 blocks.
+    wgpu::TextureFormat uploadFormat = format;
+    wgpu::FeatureName feature{};
+    const bool compressed =
+        GetCompressedFormat(textureInfo._format, format, uploadFormat, feature) &&
+        device.HasFeature(feature) && textureInfo._width % block._width == 0 &&
+        textureInfo._height % block._height == 0;
+    const bool direct = compressed || textureInfo._format == Model::TextureFormat::RGBA8;
+    if (!compressed) {
+        uploadFormat = format;
+        if (!texture_codecs::CanDecode(textureInfo._format)) {
+            ++stats._unsupported;
+            return false;
+        }
+    }
+
+    wgpu::TextureDescriptor textureDescriptor{};
+    textureDescriptor.size = {textureInfo._width, textureInfo._height, 1};
+    textureDescriptor.format = uploadFormat;
+    textureDescriptor.usage = wgpu::TextureUsage::TextureBinding | wgpu::TextureUsage::CopyDst;
+    textureDescriptor.mipLevelCount = static_cast<uint32_t>(levels.size());
+    texture = device.CreateTexture(&textureDescriptor);
+
+    std::vector<uint8_t> decoded;
+    for (uint32_t level = 0; level < levels.size(); ++level) {
+        const Model::MipLevel& mip = levels[level];
+        const uint8_t* data = textureInfo._data.data() + mip._offset;
+        size_t dataSize = mip._size;
+        wgpu::TexelCopyBufferLayout source{};
+        wgpu::Extent3D extent = {mip._width, mip._height, 1};
+        if (direct) {
+            // Copies cover whole blocks, so small levels use their physical (padded) size.
+            const uint32_t blocksWide = (mip._width + block._width - 1) / block._width;
+            const uint32_t blocksHigh = (mip._height + block._height - 1) / block._height;
+            source.bytesPerRow = blocksWide * block._bytes;
+            source.rowsPerImage = blocksHigh;
+            extent = {blocksWide * block._width, blocksHigh * block._height, 1};
+        } else {
+            decoded.resize(static_cast<size_t>(mip._width) * mip._height * 4);
+            texture_codecs::DecodeToRgba8(textureInfo._format, data, mip._width, mip._height,
+                                          decoded.data());
+            data = decoded.data();
+            dataSize = decoded.size();
+            source.bytesPerRow = 4 * mip._width;
+            source.rowsPerImage = mip._height;
+        }
+
+        wgpu::TexelCopyTextureInfo destination{};
+        destination.texture = texture;
+        destination.mipLevel = level;
+        destination.origin = {0, 0, 0};
+        destination.aspect = wgpu::TextureAspect::All;
+        device.GetQueue().WriteTexture(&destination, data, dataSize, &source, &extent);
+        stats._uploadedBytes += dataSize;
+    }
+
+    ++(direct ? stats._direct : stats._decoded);
+    stats._rgba8Bytes += static_cast<size_t>(textureInfo._width) * textureInfo._height * 4 * 4 / 3;
+    return true;
+}
+
 template <typename TextureInfo>
 void CreateTexture(const TextureInfo* textureInfo, wgpu::TextureFormat format,
                    glm::vec4 defaultValue, wgpu::Device device, MipmapGenerator& mipmapGenerator,
-                   MipmapGenerator::MipKind kind, wgpu::Texture& texture) {
+                   MipmapGenerator::MipKind kind, TextureUploadStats& stats,
+                   wgpu::Texture& texture) {
+    // Mip chains from the file are uploaded as they are; if the device can use neither the
+    // format nor a CPU-decoded copy, the slot gets its default value.
+    if (textureInfo && !textureInfo->_mipLevels.empty()) {
+        if (CreateTextureFromLevels(*textureInfo, format, device, stats, texture)) {
+            return;
+        }
+        WGPU_LOG_WARNING("Texture {} uses {}, which this device cannot sample",
+                         textureInfo->_name,
+                         texture_codecs::GetFormatName(textureInfo->_format));
+        textureInfo = nullptr;
+    }
+
     // Set default pixel value.
     const uint8_t defaultPixel[4] = {static_cast<uint8_t>(defaultValue.r * 255.0f),
                                      static_cast<uint8_t>(defaultValue.g * 255.0f),
@@ -178,6 +449,59 @@ void CreateTexture(const TextureInfo* textureInfo, wgpu::TextureFormat format,
     }
 }
 
+// Textures CreateMaterials has uploaded, one per glTF image and way of sampling it (format and
+// mip kind). Materials that share an image, and ORM-packed images used as both occlusion and
+// metallic-roughness, get the same texture and view instead of another upload and mip chain.
+class MaterialTextureCache {
+  public:
+    struct Entry {
+        int _image{-1};
+        wgpu::TextureFormat _format{wgpu::TextureFormat::Undefined};
+        MipmapGenerator::MipKind _kind{MipmapGenerator::MipKind::LinearUNorm2D};
+        wgpu::Texture _texture;
+        wgpu::TextureView _view;
+        size_t _uploadBytes{0}; // Written to the queue when the texture was created
+    };
+
+    // Returns the entry for `image`, creating the texture on first use.
+    Entry Acquire(const Model& model, int image, wgpu::TextureFormat format,
+                  glm::vec4 defaultValue, wgpu::Device device, MipmapGenerator& mipmapGenerator,
+                  MipmapGenerator::MipKind kind, TextureUploadStats& stats) {
+        for (const Entry& entry : _entries) {
+            if (entry._image == image && entry._format == format && entry._kind == kind) {
+                ++_reused;
+                _savedBytes += entry._uploadBytes;
+                return entry;
+            }
+        }
+
+        const Model::Texture* textureInfo = model.GetTexture(image);
+        Entry entry;
+        entry._image = image;
+        entry._format = format;
+        entry._kind = kind;
+        const size_t uploadedBefore = stats._uploadedBytes;
+        CreateTexture(textureInfo, format, defaultValue, device, mipmapGenerator, kind, stats,
+                      entry._texture);
+        entry._view = entry._texture.CreateView();
+        entry._uploadBytes = textureInfo->_mipLevels.empty()
+                                 ? static_cast<size_t>(textureInfo->_width) *
+                                       textureInfo->_height * 4
+                                 : stats._uploadedBytes - uploadedBefore;
+        _entries.push_back(entry);
+        return entry;
+    }
+
+    size_t GetCreatedCount() const noexcept { return _entries.size(); }
+    size_t GetReusedCount() const noexcept { return _reused; }
+    size_t GetSavedBytes() const noexcept { return _savedBytes; }
+
+  private:
+    std::vector<Entry> _entries;
+    size_t _reused{0};
+    size_t _savedBytes{0};
+};
+
 void CreateEnvironmentTexture(wgpu::Device device, wgpu::TextureViewDimension type,
                               wgpu::Extent3D size, bool mipmapping, wgpu::Texture& texture,
                               wgpu::TextureView& textureView) {
@@ -211,6 +535,10 @@ void CreateEnvironmentTexture(wgpu::Device device, wgpu::TextureViewDimension ty
 //----------------------------------------------------------------------
 // Renderer Class implementation
 
+void WebgpuRenderer::SetOptions(const RendererOptions& options) {
+    _options = options;
+}
+
 void WebgpuRenderer::Initialize(GLFWwindow* window, const Environment& environment,
                                 const Model& model) {
     _window = window;
@@ -262,6 +590,30 @@ void WebgpuRenderer::Initialize(GLFWwindow* window, const Environment& environme
         WGPU_LOG_WARNING("Failed to query adapter limits; using default device limits.");
     }
 
+    // Culled indirect draws carry the submesh's first instance record in firstInstance.
+    // GPU-driven draws replay each group with one call where multi-draw-indirect is available.
+    std::vector<wgpu::FeatureName> requiredFeatures;
+    if ((_options.meshletCulling || _options.gpuDrivenDraws) &&
+        _adapter.HasFeature(wgpu::FeatureName::IndirectFirstInstance)) {
+        requiredFeatures.push_back(wgpu::FeatureName::IndirectFirstInstance);
+    }
+#if !defined(__EMSCRIPTEN__)
+    if (_options.gpuDrivenDraws && _adapter.HasFeature(wgpu::FeatureName::MultiDrawIndirect)) {
+        requiredFeatures.push_back(wgpu::FeatureName::MultiDrawIndirect);
+    }
+#endif
+
+    // Block-compressed KTX2 textures are uploaded as they are when the device samples them.
+    for (wgpu::FeatureName feature : {wgpu::FeatureName::TextureCompressionBC,
+                                      wgpu::FeatureName::TextureCompressionETC2,
+                                      wgpu::FeatureName::TextureCompressionASTC}) {
+        if (_adapter.HasFeature(feature)) {
+            requiredFeatures.push_back(feature);
+        }
+    }
+    deviceDesc.requiredFeatureCount = requiredFeatures.size();
+    deviceDesc.requiredFeatures = requiredFeatures.data();
+
     deviceDesc.SetDeviceLostCallback(
         wgpu::CallbackMode::AllowSpontaneous,
         [](const wgpu::Device&, wgpu::DeviceLostReason reason, wgpu::StringView message) {
@@ -314,6 +666,32 @@ void WebgpuRenderer::Initialize(GLFWwindow* window, const Environment& environme
         });
     _instance.WaitAny(deviceFuture, UINT64_MAX);
 
+    if (_options.meshletCulling && !_device.HasFeature(wgpu::FeatureName::IndirectFirstInstance)) {
+        WGPU_LOG_WARNING("Meshlet culling needs indirect-first-instance, which the adapter "
+                         "lacks; culling disabled.");
+        _options.meshletCulling = false;
+    }
+    if (_options.gpuDrivenDraws && _options.meshletCulling) {
+        WGPU_LOG_WARNING("GPU-driven draws and meshlet culling both cull the opaque draws; "
+                         "using meshlet culling.");
+        _options.gpuDrivenDraws = false;
+    }
+    if (_options.gpuDrivenDraws && !_device.HasFeature(wgpu::FeatureName::IndirectFirstInstance)) {
+        WGPU_LOG_WARNING("GPU-driven draws need indirect-first-instance, which the adapter "
+                         "lacks; drawing from the CPU.");
+        _options.gpuDrivenDraws = false;
+    }
+    if (_options.occlusionCulling && !_options.gpuDrivenDraws) {
+        WGPU_LOG_WARNING("Occlusion culling tests the GPU-driven draws, which are off; "
+                         "occlusion culling disabled.");
+        _options.occlusionCulling = false;
+    }
+    _drawPhaseCount = _options.occlusionCulling ? 2 : 1;
+#if !defined(__EMSCRIPTEN__)
+    _multiDrawIndirect =
+        _options.gpuDrivenDraws && _device.HasFeature(wgpu::FeatureName::MultiDrawIndirect);
+#endif
+
     _isShutdown = false;
     InitGraphics(environment, model);
 }
@@ -341,25 +719,63 @@ void WebgpuRenderer::Shutdown() {
     _opaqueMeshes.clear();
     _transparentMeshes.clear();
     _transparentMeshesDepthSorted.clear();
+    _opaqueDrawQueue.clear();
 
     // Release GPU resources in reverse dependency order.
+    // Render bundles (they reference the pipelines, bind groups and buffers below).
+    _opaqueBundles[0] = nullptr;
+    _opaqueBundles[1] = nullptr;
+    _depthPrepassBundle = nullptr;
+
     // Pipelines and shader modules.
+    _modelPipelineDepth = nullptr;
     _modelPipelineOpaque = nullptr;
     _modelPipelineTransparent = nullptr;
     _modelShaderModule = nullptr;
     _environmentPipeline = nullptr;
     _environmentShaderModule = nullptr;
+    _meshletCullPipeline = nullptr;
+    _drawCullPipeline = nullptr;
+    _occlusionCullPipeline = nullptr;
+    _hiZCopyPipeline = nullptr;
+    _hiZDownsamplePipeline = nullptr;
 
     // Bind groups and layouts.
     _globalBindGroup = nullptr;
     _globalBindGroupLayout = nullptr;
     _modelBindGroupLayout = nullptr;
+    _meshletCullBindGroup = nullptr;
+    _meshletCullBindGroupLayout = nullptr;
+    _drawCullBindGroup = nullptr;
+    _drawCullBindGroupLayout = nullptr;
+    _hiZBindGroups.clear();
+    _hiZCullBindGroup = nullptr;
+    _hiZCopyBindGroupLayout = nullptr;
+    _hiZDownsampleBindGroupLayout = nullptr;
+    _hiZCullBindGroupLayout = nullptr;
 
     // Buffers.
     _vertexBuffer = nullptr;
-    _indexBuffer = nullptr;
+    _vertexAttributeBuffer = nullptr;
+    _dequantizationBuffer = nullptr;
+    _indexBuffer16 = nullptr;
+    _indexBuffer32 = nullptr;
     _globalUniformBuffer = nullptr;
     _modelUniformBuffer = nullptr;
+    _instanceBuffer = nullptr;
+    _meshletCullUniformBuffer = nullptr;
+    _meshletBuffer = nullptr;
+    _culledIndexBuffer = nullptr;
+    _culledDrawBuffer = nullptr;
+    _culledDrawReadbackBuffer = nullptr;
+    _meshletCount = 0;
+    _drawCullUniformBuffer = nullptr;
+    _drawRecordBuffer = nullptr;
+    _drawArgsBuffer = nullptr;
+    _drawCountBuffer = nullptr;
+    _drawCountReadbackBuffer = nullptr;
+    _drawVisibilityBuffer = nullptr;
+    _drawRecordCount = 0;
 
     // Samplers.
     _modelTextureSampler = nullptr;
@@ -386,7 +802,9 @@ void WebgpuRenderer::Shutdown() {
     _defaultCubeTextureView = nullptr;
     _defaultCubeTexture = nullptr;
 
-    // Depth texture.
+    // Depth texture and Hi-Z pyramid.
+    _hiZTexture = nullptr;
+    _depthSampleView = nullptr;
     _depthTextureView = nullptr;
     _depthTexture = nullptr;
 
@@ -403,11 +821,17 @@ void WebgpuRenderer::Resize() {
     CreateDepthTexture();
     ConfigureSurface();
     _depthAttachment.view = _depthTextureView;
+    CreateHiZResources();
 }
 
 void WebgpuRenderer::Render(const glm::mat4& modelMatrix, const CameraUniformsInput& camera) {
     UpdateUniforms(modelMatrix, camera);
+    const auto prepareStart = std::chrono::high_resolution_clock::now();
+    CullSubMeshes(modelMatrix, camera);
     SortTransparentMeshes(modelMatrix, camera.viewMatrix);
+    SelectLods(modelMatrix, camera);
+    BuildOpaqueDrawQueue(modelMatrix, camera.viewMatrix);
+    const auto prepareEnd = std::chrono::high_resolution_clock::now();
 
     wgpu::SurfaceTexture surfaceTexture;
     _surface.GetCurrentTexture(&surfaceTexture);
@@ -417,7 +841,20 @@ void WebgpuRenderer::Render(const glm::mat4& modelMatrix, const CameraUniformsIn
     }
     _colorAttachment.view = surfaceTexture.texture.CreateView();
 
+    const auto encodeStart = std::chrono::high_resolution_clock::now();
     wgpu::CommandEncoder encoder = _device.CreateCommandEncoder();
+
+    if (_meshletCount > 0) {
+        EncodeMeshletCulling(encoder, modelMatrix, camera);
+    }
+    if (_drawRecordCount > 0) {
+        EncodeDrawCulling(encoder, modelMatrix, camera);
+    }
+
+    if (_options.depthPrepass) {
+        EncodeDepthPrepass(encoder);
+    }
+
     wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&_renderPassDescriptor);
 
     pass.SetBindGroup(0, _globalBindGroup);
@@ -425,54 +862,654 @@ void WebgpuRenderer::Render(const glm::mat4& modelMatrix, const CameraUniformsIn
     pass.SetPipeline(_environmentPipeline);
     pass.Draw(3, 1, 0, 0);
 
-    pass.SetVertexBuffer(0, _vertexBuffer);
-    pass.SetIndexBuffer(_indexBuffer, wgpu::IndexFormat::Uint32);
+    EncodeOpaqueMeshes(pass, false);
 
-    pass.SetPipeline(_modelPipelineOpaque);
-    for (const auto& subMesh : _opaqueMeshes) {
-        pass.SetBindGroup(1, _materials[subMesh._materialIndex]._bindGroup);
-        pass.DrawIndexed(subMesh._indexCount, 1u, subMesh._firstIndex);
+    // The opaque draws so far were visible last frame. Their depth builds the Hi-Z pyramid that
+    // the other draws are tested against, and the newly visible ones are drawn in a second pass.
+    if (_options.occlusionCulling && _drawRecordCount > 0) {
+        pass.End();
+        EncodeOcclusionCulling(encoder);
+
+        wgpu::RenderPassColorAttachment colorAttachment = _colorAttachment;
+        colorAttachment.loadOp = wgpu::LoadOp::Load;
+        wgpu::RenderPassDepthStencilAttachment depthAttachment = _depthAttachment;
+        depthAttachment.depthLoadOp = wgpu::LoadOp::Load;
+        depthAttachment.stencilLoadOp = wgpu::LoadOp::Load;
+
+        wgpu::RenderPassDescriptor descriptor{};
+        descriptor.colorAttachmentCount = 1;
+        descriptor.colorAttachments = &colorAttachment;
+        descriptor.depthStencilAttachment = &depthAttachment;
+
+        pass = encoder.BeginRenderPass(&descriptor);
+        pass.SetBindGroup(0, _globalBindGroup);
+        EncodeOpaqueMeshes(pass, false, 1);
     }
 
+    wgpu::IndexFormat boundIndexFormat = wgpu::IndexFormat::Undefined;
+
     pass.SetPipeline(_modelPipelineTransparent);
     for (const auto& depthInfo : _transparentMeshesDepthSorted) {
         const SubMesh& subMesh = _transparentMeshes[depthInfo._meshIndex];
         pass.SetBindGroup(1, _materials[subMesh._materialIndex]._bindGroup);
-        pass.DrawIndexed(subMesh._indexCount, 1u, subMesh._firstIndex);
+        DrawSubMesh(pass, subMesh, boundIndexFormat);
     }
 
     pass.End();
 
+    ++_frameCount;
+    const bool readBackStats = _meshletCount > 0 && !_meshletStatsPending &&
+                               _frameCount % kMeshletStatsInterval == 0;
+    if (readBackStats) {
+        encoder.CopyBufferToBuffer(_culledDrawBuffer, 0, _culledDrawReadbackBuffer, 0,
+                                   _culledDrawBuffer.GetSize());
+    }
+    const bool readBackDrawStats = _drawRecordCount > 0 && !_drawStatsPending &&
+                                   _frameCount % kMeshletStatsInterval == 0;
+    if (readBackDrawStats) {
+        encoder.CopyBufferToBuffer(_drawCountBuffer, 0, _drawCountReadbackBuffer, 0,
+                                   _drawCountBuffer.GetSize());
+    }
+
     wgpu::CommandBuffer commands = encoder.Finish();
+    const auto encodeEnd = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double, std::milli> encodeTime =
+        (prepareEnd - prepareStart) + (encodeEnd - encodeStart);
+    _frameStats.encodeMilliseconds = static_cast<float>(encodeTime.count());
     _device.GetQueue().Submit(1, &commands);
 
+    if (readBackStats) {
+        ReadBackMeshletCullingStats();
+    }
+    if (readBackDrawStats) {
+        ReadBackDrawCullingStats();
+    }
+
 #if !defined(__EMSCRIPTEN__)
     _surface.Present();
     _instance.ProcessEvents();
 #endif
 }
 
+void WebgpuRenderer::EncodeDepthPrepass(wgpu::CommandEncoder& encoder) {
+    wgpu::RenderPassDepthStencilAttachment depthAttachment = _depthAttachment;
+    depthAttachment.depthLoadOp = wgpu::LoadOp::Clear;
+    depthAttachment.stencilLoadOp = wgpu::LoadOp::Clear;
+
+    wgpu::RenderPassDescriptor descriptor{};
+    descriptor.depthStencilAttachment = &depthAttachment;
+
+    wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&descriptor);
+    pass.SetBindGroup(0, _globalBindGroup);
+    EncodeOpaqueMeshes(pass, true);
+    pass.End();
+}
+
+void WebgpuRenderer::EncodeMeshletCulling(wgpu::CommandEncoder& encoder,
+                                          const glm::mat4& modelMatrix,
+                                          const CameraUniformsInput& camera) {
+    // Meshlet bounds stay in model space; the frustum and the eye are brought there instead.
+    // The model matrix is rigid, so the cone test is unaffected.
+    MeshletCullUniforms uniforms{};
+    ExtractFrustumPlanes(camera.projectionMatrix * camera.viewMatrix * modelMatrix,
+                         uniforms.frustumPlanes);
+    uniforms.cameraPosition =
+        glm::vec3(glm::inverse(modelMatrix) * glm::vec4(camera.cameraPosition, 1.0f));
+    uniforms.meshletCount = _meshletCount;
+
+    const wgpu::Queue queue = _device.GetQueue();
+    queue.WriteBuffer(_meshletCullUniformBuffer, 0, &uniforms, sizeof(MeshletCullUniforms));
+    queue.WriteBuffer(_culledDrawBuffer, 0, _culledDrawReset.data(),
+                      _culledDrawReset.size() * sizeof(DrawIndexedIndirectArgs));
+
+    const uint32_t workgroupCountX = std::min(_meshletCount, kMaxWorkgroupsPerDimension);
+    const uint32_t workgroupCountY = (_meshletCount + workgroupCountX - 1) / workgroupCountX;
+
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(_meshletCullPipeline);
+    pass.SetBindGroup(0, _meshletCullBindGroup);
+    pass.DispatchWorkgroups(workgroupCountX, workgroupCountY, 1);
+    pass.End();
+}
+
+void WebgpuRenderer::ReadBackMeshletCullingStats() {
+    _meshletStatsPending = true;
+    _culledDrawReadbackBuffer.MapAsync(
+        wgpu::MapMode::Read, 0, _culledDrawReadbackBuffer.GetSize(),
+        wgpu::CallbackMode::AllowSpontaneous,
+        [this, buffer = _culledDrawReadbackBuffer, drawCount = _culledDrawReset.size(),
+         triangleCount = _meshletTriangleCount](wgpu::MapAsyncStatus status, wgpu::StringView) {
+            _meshletStatsPending = false;
+            if (status != wgpu::MapAsyncStatus::Success) {
+                return;
+            }
+
+            const auto* draws =
+                static_cast<const DrawIndexedIndirectArgs*>(buffer.GetConstMappedRange());
+            uint64_t drawnTriangles = 0;
+            for (size_t i = 0; i < drawCount; ++i) {
+                drawnTriangles += draws[i].indexCount / 3;
+            }
+            buffer.Unmap();
+
+            const uint64_t rejected = triangleCount - std::min(drawnTriangles, triangleCount);
+            WGPU_LOG_INFO("Meshlet culling: {} of {} opaque triangles rejected ({:.1f}%)",
+                          rejected, triangleCount,
+                          100.0 * static_cast<double>(rejected) /
+                              static_cast<double>(std::max<uint64_t>(triangleCount, 1)));
+        });
+}
+
+void WebgpuRenderer::EncodeDrawCulling(wgpu::CommandEncoder& encoder,
+                                       const glm::mat4& modelMatrix,
+                                       const CameraUniformsInput& camera) {
+    // Record bounds stay in model space, like the meshlet bounds.
+    DrawCullUniforms uniforms{};
+    uniforms.modelViewProjection = camera.projectionMatrix * camera.viewMatrix * modelMatrix;
+    ExtractFrustumPlanes(uniforms.modelViewProjection, uniforms.frustumPlanes);
+    uniforms.drawCount = _drawRecordCount;
+    uniforms.groupCount = static_cast<uint32_t>(_drawGroups.size());
+    if (_hiZTexture) {
+        uniforms.hiZLevelCount = _hiZTexture.GetMipLevelCount();
+        uniforms.hiZSize = glm::vec2(_hiZTexture.GetWidth(), _hiZTexture.GetHeight());
+    }
+
+    // The counts buffer ends with the occluded draw and triangle totals when there are two phases.
+    const wgpu::Queue queue = _device.GetQueue();
+    queue.WriteBuffer(_drawCullUniformBuffer, 0, &uniforms, sizeof(DrawCullUniforms));
+    queue.WriteBuffer(_drawArgsBuffer, 0, _drawArgsReset.data(),
+                      _drawArgsReset.size() * sizeof(DrawIndexedIndirectArgs));
+    const std::vector<uint32_t> zeroCounts(_drawCountBuffer.GetSize() / sizeof(uint32_t), 0);
+    queue.WriteBuffer(_drawCountBuffer, 0, zeroCounts.data(), zeroCounts.size() * sizeof(uint32_t));
+
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(_drawCullPipeline);
+    pass.SetBindGroup(0, _drawCullBindGroup);
+    pass.DispatchWorkgroups((_drawRecordCount + kDrawCullWorkgroupSize - 1) /
+                            kDrawCullWorkgroupSize);
+    pass.End();
+}
+
+void WebgpuRenderer::EncodeOcclusionCulling(wgpu::CommandEncoder& encoder) {
+    // Each dispatch reads the level the previous one wrote; WebGPU orders them within the pass.
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    for (uint32_t level = 0; level < _hiZBindGroups.size(); ++level) {
+        const uint32_t width = std::max(_hiZTexture.GetWidth() >> level, 1u);
+        const uint32_t height = std::max(_hiZTexture.GetHeight() >> level, 1u);
+        pass.SetPipeline(level == 0 ? _hiZCopyPipeline : _hiZDownsamplePipeline);
+        pass.SetBindGroup(0, _hiZBindGroups[level]);
+        pass.DispatchWorkgroups((width + kHiZWorkgroupSize - 1) / kHiZWorkgroupSize,
+                                (height + kHiZWorkgroupSize - 1) / kHiZWorkgroupSize, 1);
+    }
+
+    pass.SetPipeline(_occlusionCullPipeline);
+    pass.SetBindGroup(0, _drawCullBindGroup);
+    pass.SetBindGroup(1, _hiZCullBindGroup);
+    pass.DispatchWorkgroups((_drawRecordCount + kDrawCullWorkgroupSize - 1) /
+                            kDrawCullWorkgroupSize);
+    pass.End();
+}
+
+void WebgpuRenderer::ReadBackDrawCullingStats() {
+    _drawStatsPending = true;
+    _drawCountReadbackBuffer.MapAsync(
+        wgpu::MapMode::Read, 0, _drawCountReadbackBuffer.GetSize(),
+        wgpu::CallbackMode::AllowSpontaneous,
+        [this, buffer = _drawCountReadbackBuffer, groupCount = _drawGroups.size(),
+         drawCount = _drawRecordCount,
+         phaseCount = _drawPhaseCount](wgpu::MapAsyncStatus status, wgpu::StringView) {
+            _drawStatsPending = false;
+            if (status != wgpu::MapAsyncStatus::Success) {
+                return;
+            }
+
+            const auto* counts = static_cast<const uint32_t*>(buffer.GetConstMappedRange());
+            uint32_t visible[2] = {0, 0};
+            for (size_t phase = 0; phase < phaseCount; ++phase) {
+                for (size_t i = 0; i < groupCount; ++i) {
+                    visible[phase] += counts[phase * groupCount + i];
+                }
+            }
+            if (phaseCount > 1) {
+                _occludedDraws = counts[2 * groupCount];
+                _occludedTriangles = counts[2 * groupCount + 1];
+            }
+            buffer.Unmap();
+
+            WGPU_LOG_INFO("GPU draw culling: {} of {} opaque draws visible in {} groups",
+                          visible[0] + visible[1], drawCount, groupCount);
+            if (phaseCount > 1) {
+                WGPU_LOG_INFO("Occlusion culling: {} draws kept from the last frame, {} newly "
+                              "visible, {} occluded ({} triangles skipped)",
+                              visible[0], visible[1], _occludedDraws, _occludedTriangles);
+            }
+        });
+}
+
+void WebgpuRenderer::EncodeOpaqueMeshes(const wgpu::RenderPassEncoder& pass, bool depthOnly,
+                                        uint32_t phase) const {
+    const wgpu::RenderBundle& bundle = depthOnly ? _depthPrepassBundle : _opaqueBundles[phase];
+    if (!bundle) {
+        pass.SetPipeline(depthOnly ? _modelPipelineDepth : _modelPipelineOpaque);
+        BindModelVertexBuffers(pass);
+        DrawOpaqueMeshes(pass, depthOnly, phase);
+        return;
+    }
+
+    // Executing bundles clears the pass state, which the transparent draws still need.
+    pass.ExecuteBundles(1, &bundle);
+    pass.SetBindGroup(0, _globalBindGroup);
+    BindModelVertexBuffers(pass);
+}
+
+template <typename Encoder>
+void WebgpuRenderer::BindModelVertexBuffers(const Encoder& pass) const {
+    uint32_t slot = 0;
+    pass.SetVertexBuffer(slot++, _vertexBuffer);
+    if (_options.packedVertices) {
+        pass.SetVertexBuffer(slot++, _dequantizationBuffer);
+    }
+    if (_options.splitVertexStreams) {
+        pass.SetVertexBuffer(slot++, _vertexAttributeBuffer);
+    }
+}
+
+template <typename Encoder>
+void WebgpuRenderer::DrawOpaqueMeshes(const Encoder& pass, bool depthOnly, uint32_t phase) const {
+    wgpu::IndexFormat boundIndexFormat = wgpu::IndexFormat::Undefined;
+
+    // GPU-driven draws: one material bind per group, whatever the number of submeshes. Slots past
+    // the group's visible count hold zeroed arguments, so replaying all of them is harmless.
+    if (_drawRecordCount > 0) {
+        for (size_t g = 0; g < _drawGroups.size(); ++g) {
+            const DrawGroup& group = _drawGroups[g];
+            const Material& material = _materials[group._materialIndex];
+            if (depthOnly && material._uniforms.alphaMode == int(Model::AlphaMode::Mask)) {
+                continue;
+            }
+
+            pass.SetBindGroup(1, material._bindGroup);
+            if (group._indexFormat != boundIndexFormat) {
+                const bool is16Bit = group._indexFormat == wgpu::IndexFormat::Uint16;
+                pass.SetIndexBuffer(is16Bit ? _indexBuffer16 : _indexBuffer32, group._indexFormat);
+                boundIndexFormat = group._indexFormat;
+            }
+
+            const uint64_t offset =
+                (static_cast<uint64_t>(phase) * _drawRecordCount + group._firstSlot) *
+                sizeof(DrawIndexedIndirectArgs);
+#if !defined(__EMSCRIPTEN__)
+            // Render bundles have no multi-draw; they are not recorded when it is in use.
+            if constexpr (std::is_same_v<Encoder, wgpu::RenderPassEncoder>) {
+                if (_multiDrawIndirect) {
+                    const uint64_t countOffset =
+                        (phase * _drawGroups.size() + g) * sizeof(uint32_t);
+                    pass.MultiDrawIndexedIndirect(_drawArgsBuffer, offset, group._drawCount,
+                                                  _drawCountBuffer, countOffset);
+                    continue;
+                }
+            }
+#endif
+            for (uint32_t i = 0; i < group._drawCount; ++i) {
+                pass.DrawIndexedIndirect(_drawArgsBuffer,
+                                         offset + i * sizeof(DrawIndexedIndirectArgs));
+            }
+        }
+        return;
+    }
+
+    if (_meshletCount > 0) {
+        pass.SetIndexBuffer(_culledIndexBuffer, wgpu::IndexFormat::Uint32);
+    }
+
+    // The queue holds the visible submeshes sorted by state, so the material only changes
+    // between runs of draws that share it.
+    int boundMaterialIndex = -1;
+    for (const OpaqueDraw& draw : _opaqueDrawQueue) {
+        const SubMesh& subMesh = _opaqueMeshes[draw._meshIndex];
+        const Material& material = _materials[subMesh._materialIndex];
+
+        // Alpha-masked surfaces need their texture to decide coverage, so they only write depth
+        // in the main pass.
+        if (depthOnly && material._uniforms.alphaMode == int(Model::AlphaMode::Mask)) {
+            continue;
+        }
+
+        if (subMesh._materialIndex != boundMaterialIndex) {
+            pass.SetBindGroup(1, material._bindGroup);
+            boundMaterialIndex = subMesh._materialIndex;
+        }
+        if (_meshletCount > 0) {
+            pass.DrawIndexedIndirect(_culledDrawBuffer,
+                                     draw._meshIndex * sizeof(DrawIndexedIndirectArgs));
+        } else {
+            DrawSubMesh(pass, subMesh, boundIndexFormat);
+        }
+    }
+}
+
+template <typename Encoder>
+void WebgpuRenderer::DrawSubMesh(const Encoder& pass, const SubMesh& subMesh,
+                                 wgpu::IndexFormat& boundIndexFormat) const {
+    if (subMesh._indexFormat != boundIndexFormat) {
+        const bool is16Bit = subMesh._indexFormat == wgpu::IndexFormat::Uint16;
+        pass.SetIndexBuffer(is16Bit ? _indexBuffer16 : _indexBuffer32, subMesh._indexFormat);
+        boundIndexFormat = subMesh._indexFormat;
+    }
+
+    uint32_t firstIndex = subMesh._firstIndex;
+    uint32_t indexCount = subMesh._indexCount;
+    if (subMesh._lod > 0) {
+        const SubMeshLod& lod = _lods[subMesh._firstLod + subMesh._lod - 1];
+        firstIndex = lod._firstIndex;
+        indexCount = lod._indexCount;
+    }
+
+    // The instance range starts at the submesh's first record in _instanceBuffer. Packed vertices
+    // also pick up their position decode from the instance-rate buffer, which repeats each
+    // submesh's entry once per instance.
+    pass.DrawIndexed(indexCount, subMesh._instanceCount, firstIndex, subMesh._baseVertex,
+                     subMesh._firstInstance);
+}
+
+void WebgpuRenderer::SelectLods(const glm::mat4& modelMatrix, const CameraUniformsInput& camera) {
+    if (_lods.empty()) {
+        return;
+    }
+
+    // Pixels covered by one world unit at unit distance, and model units to world units.
+    const float pixelsPerUnit = camera.projectionMatrix[1][1] * 0.5f *
+                                static_cast<float>(GetFramebufferSize().second);
+    const float modelScale = GetMaxScale(modelMatrix);
+
+    const auto select = [&](SubMesh& subMesh) {
+        if (!subMesh._visible) {
+            return;
+        }
+        if (subMesh._lodCount == 0) {
+            subMesh._lod = 0;
+            return;
+        }
+
+        // All instances draw the same level, so the one with the largest projected scale decides.
+        float scaleOverDistance = 0.0f;
+        for (uint32_t i = 0; i < subMesh._instanceCount; ++i) {
+            const glm::mat4& instanceMatrix = _instances[subMesh._firstInstance + i].modelMatrix;
+            const glm::vec3 center =
+                glm::vec3(modelMatrix * instanceMatrix * glm::vec4(subMesh._centroid, 1.0f));
+            const float instanceScale = modelScale * GetMaxScale(instanceMatrix);
+            const float distance =
+                glm::length(center - camera.cameraPosition) - subMesh._radius * instanceScale;
+            if (distance <= 0.0f) {
+                subMesh._lod = 0;
+                return;
+            }
+            scaleOverDistance = std::max(scaleOverDistance, instanceScale / distance);
+        }
+
+        // Projected error of a level, measured at the submesh's nearest point.
+        const float scale = pixelsPerUnit * scaleOverDistance;
+        const auto errorPixels = [&](uint32_t level) {
+            return level == 0 ? 0.0f : _lods[subMesh._firstLod + level - 1]._error * scale;
+        };
+
+        uint32_t lod = std::min(subMesh._lod, subMesh._lodCount);
+        while (lod < subMesh._lodCount &&
+               errorPixels(lod + 1) < kLodErrorPixels * (1.0f - kLodHysteresis)) {
+            ++lod;
+        }
+        while (lod > 0 && errorPixels(lod) > kLodErrorPixels * (1.0f + kLodHysteresis)) {
+            --lod;
+        }
+        subMesh._lod = lod;
+    };
+
+    // Meshlet-culled, GPU-driven and bundled draws always use the full-detail ranges.
+    if (_meshletCount == 0 && _drawRecordCount == 0 && !_opaqueBundles[0]) {
+        for (SubMesh& subMesh : _opaqueMeshes) {
+            select(subMesh);
+        }
+    }
+    for (SubMesh& subMesh : _transparentMeshes) {
+        select(subMesh);
+    }
+}
+
+void WebgpuRenderer::BuildOpaqueDrawQueue(const glm::mat4& modelMatrix,
+                                          const glm::mat4& viewMatrix) {
+    _opaqueDrawQueue.clear();
+    if (_opaqueBundles[0]) {
+        _frameStats.opaqueMaterialBinds = _opaqueBundleMaterialBinds;
+        return;
+    }
+    if (_drawRecordCount > 0) {
+        _frameStats.opaqueMaterialBinds =
+            static_cast<uint32_t>(_drawGroups.size()) * _drawPhaseCount;
+        return;
+    }
+
+    // An instanced draw sorts by its nearest instance; instances behind the eye count as depth 0.
+    const glm::mat4 modelView = viewMatrix * modelMatrix;
+    for (uint32_t i = 0; i < _opaqueMeshes.size(); ++i) {
+        const SubMesh& subMesh = _opaqueMeshes[i];
+        if (!subMesh._visible) {
+            continue;
+        }
+
+        float depth = std::numeric_limits<float>::max();
+        for (uint32_t j = 0; j < subMesh._instanceCount; ++j) {
+            const glm::mat4& instanceMatrix = _instances[subMesh._firstInstance + j].modelMatrix;
+            const glm::vec4 centroid =
+                modelView * instanceMatrix * glm::vec4(subMesh._centroid, 1.0f);
+            depth = std::min(depth, -centroid.z);
+        }
+
+        _opaqueDrawQueue.push_back(MakeOpaqueDraw(i, depth));
+    }
+    _frameStats.opaqueMaterialBinds = SortOpaqueDrawQueue();
+}
+
+WebgpuRenderer::OpaqueDraw WebgpuRenderer::MakeOpaqueDraw(uint32_t meshIndex, float depth) const {
+    const SubMesh& subMesh = _opaqueMeshes[meshIndex];
+    const bool masked =
+        _materials[subMesh._materialIndex]._uniforms.alphaMode == int(Model::AlphaMode::Mask);
+    const bool is16Bit = subMesh._indexFormat == wgpu::IndexFormat::Uint16;
+    return {._key = MakeOpaqueSortKey(masked, subMesh._materialIndex, is16Bit, depth),
+            ._meshIndex = meshIndex};
+}
+
+uint32_t WebgpuRenderer::SortOpaqueDrawQueue() {
+    RadixSortByKey(_opaqueDrawQueue, _opaqueDrawScratch);
+
+    uint32_t materialBinds = 0;
+    int boundMaterialIndex = -1;
+    for (const OpaqueDraw& draw : _opaqueDrawQueue) {
+        const int materialIndex = _opaqueMeshes[draw._meshIndex]._materialIndex;
+        materialBinds += materialIndex != boundMaterialIndex ? 1 : 0;
+        boundMaterialIndex = materialIndex;
+    }
+    return materialBinds;
+}
+
+void WebgpuRenderer::RecordOpaqueBundles() {
+    _opaqueBundles[0] = nullptr;
+    _opaqueBundles[1] = nullptr;
+    _depthPrepassBundle = nullptr;
+    _opaqueBundleMaterialBinds = 0;
+    if (!_options.renderBundles || !_vertexBuffer || _opaqueMeshes.empty()) {
+        return;
+    }
+    if (_drawRecordCount > 0 && _multiDrawIndirect) {
+        WGPU_LOG_INFO("Render bundles skipped: multi-draw-indirect already replays each draw "
+                      "group with one call.");
+        return;
+    }
+
+    // Bundled draws are not culled or LOD-selected on the CPU, so every opaque submesh is
+    // recorded at full detail, in state order. GPU-driven draws record their fixed groups.
+    if (_drawRecordCount == 0 && (_options.frustumCulling || !_lods.empty())) {
+        WGPU_LOG_WARNING("Render bundles replace CPU frustum culling and LOD selection of the "
+                         "opaque submeshes; all {} are drawn at full detail every frame.",
+                         _opaqueMeshes.size());
+    }
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    if (_drawRecordCount == 0) {
+        _opaqueDrawQueue.clear();
+        for (uint32_t i = 0; i < _opaqueMeshes.size(); ++i) {
+            _opaqueDrawQueue.push_back(MakeOpaqueDraw(i, 0.0f));
+        }
+        _opaqueBundleMaterialBinds = SortOpaqueDrawQueue();
+    } else {
+        _opaqueBundleMaterialBinds = static_cast<uint32_t>(_drawGroups.size()) * _drawPhaseCount;
+    }
+
+    _opaqueBundles[0] = RecordOpaqueBundle(false, 0);
+    if (_drawPhaseCount > 1) {
+        _opaqueBundles[1] = RecordOpaqueBundle(false, 1);
+    }
+    if (_options.depthPrepass) {
+        _depthPrepassBundle = RecordOpaqueBundle(true, 0);
+    }
+    _opaqueDrawQueue.clear();
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    WGPU_LOG_INFO("Recorded opaque render bundles ({} submeshes, {} material binds) in {:.2f}ms",
+                  _opaqueMeshes.size(), _opaqueBundleMaterialBinds,
+                  std::chrono::duration<double, std::milli>(t1 - t0).count());
+}
+
+wgpu::RenderBundle WebgpuRenderer::RecordOpaqueBundle(bool depthOnly, uint32_t phase) const {
+    // The formats must match the pass the bundle runs in; the prepass has no color target.
+    wgpu::RenderBundleEncoderDescriptor descriptor{};
+    descriptor.colorFormatCount = depthOnly ? 0 : 1;
+    descriptor.colorFormats = &_surfaceFormat;
+    descriptor.depthStencilFormat = wgpu::TextureFormat::Depth24PlusStencil8;
+
+    wgpu::RenderBundleEncoder encoder = _device.CreateRenderBundleEncoder(&descriptor);
+    encoder.SetBindGroup(0, _globalBindGroup);
+    encoder.SetPipeline(depthOnly ? _modelPipelineDepth : _modelPipelineOpaque);
+    BindModelVertexBuffers(encoder);
+    DrawOpaqueMeshes(encoder, depthOnly, phase);
+    return encoder.Finish();
+}
+
+void WebgpuRenderer::CullSubMeshes(const glm::mat4& modelMatrix,
+                                   const CameraUniformsInput& camera) {
+    _frameStats = {};
+    _frameStats.subMeshes = static_cast<uint32_t>(_opaqueMeshes.size() + _transparentMeshes.size());
+
+    // Bounds stay in model space; the frustum is brought there instead. Without culling every
+    // record keeps the visible flag it was created with.
+    if (_options.frustumCulling) {
+        glm::vec4 planes[6];
+        ExtractFrustumPlanes(camera.projectionMatrix * camera.viewMatrix * modelMatrix, planes);
+
+        const auto cull = [&](size_t first, size_t count) {
+            vertex_kernels::AabbArrays boxes;
+            for (int axis = 0; axis < 3; ++axis) {
+                boxes._min[axis] = _recordBounds[axis].data() + first;
+                boxes._max[axis] = _recordBounds[3 + axis].data() + first;
+            }
+            vertex_kernels::CullAabbs(boxes, count, planes, _recordVisible.data() + first);
+        };
+
+        // GPU-driven draws cull the opaque submeshes themselves and bundled ones are not culled;
+        // only transparent ones are left.
+        if (_drawRecordCount > 0 || _opaqueBundles[0]) {
+            for (const SubMesh& subMesh : _transparentMeshes) {
+                cull(subMesh._firstInstance, subMesh._instanceCount);
+            }
+        } else {
+            cull(0, _recordVisible.size());
+        }
+    }
+
+    // An instanced draw is kept while any of its instances is visible.
+    const auto update = [&](SubMesh& subMesh) {
+        const auto first = _recordVisible.begin() + subMesh._firstInstance;
+        const auto last = first + subMesh._instanceCount;
+        subMesh._visible = std::find(first, last, uint8_t{1}) != last;
+        _frameStats.culledSubMeshes += subMesh._visible ? 0 : 1;
+    };
+    if (_drawRecordCount > 0) {
+        for (const DrawGroup& group : _drawGroups) {
+            _frameStats.drawCalls += (_multiDrawIndirect ? 1 : group._drawCount) * _drawPhaseCount;
+        }
+        _frameStats.occludedSubMeshes = _occludedDraws;
+        _frameStats.occludedTriangles = _occludedTriangles;
+    } else if (_opaqueBundles[0]) {
+        _frameStats.drawCalls += static_cast<uint32_t>(_opaqueMeshes.size());
+    } else {
+        for (SubMesh& subMesh : _opaqueMeshes) {
+            update(subMesh);
+            _frameStats.drawCalls += subMesh._visible ? 1 : 0;
+        }
+    }
+    for (SubMesh& subMesh : _transparentMeshes) {
+        update(subMesh); // Counted as draws once sorted
+    }
+}
+
+FrameStats WebgpuRenderer::GetFrameStats() const {
+    return _frameStats;
+}
+
 void WebgpuRenderer::ReloadShaders() {
     _environmentPipeline = nullptr;
     _environmentShaderModule = nullptr;
+    _modelPipelineDepth = nullptr;
     _modelPipelineOpaque = nullptr;
     _modelPipelineTransparent = nullptr;
     _modelShaderModule = nullptr;
+    _meshletCullPipeline = nullptr;
+    _drawCullPipeline = nullptr;
+    _occlusionCullPipeline = nullptr;
+    _hiZCopyPipeline = nullptr;
+    _hiZDownsamplePipeline = nullptr;
 
     CreateEnvironmentRenderPipeline();
     CreateModelRenderPipelines();
+    CreateMeshletCullPipeline();
+    CreateDrawCullPipeline();
+    CreateHiZPipelines();
+    RecordOpaqueBundles();
 }
 
 void WebgpuRenderer::UpdateModel(const Model& model) {
     auto t0 = std::chrono::high_resolution_clock::now();
 
     _vertexBuffer = nullptr;
-    _indexBuffer = nullptr;
-
+    _vertexAttributeBuffer = nullptr;
+    _dequantizationBuffer = nullptr;
+    _indexBuffer16 = nullptr;
+    _indexBuffer32 = nullptr;
+    _instanceBuffer = nullptr;
+    _meshletCullBindGroup = nullptr;
+    _meshletBuffer = nullptr;
+    _culledIndexBuffer = nullptr;
+    _culledDrawBuffer = nullptr;
+    _culledDrawReadbackBuffer = nullptr;
+    _drawCullBindGroup = nullptr;
+    _drawRecordBuffer = nullptr;
+    _drawArgsBuffer = nullptr;
+    _drawCountBuffer = nullptr;
+    _drawCountReadbackBuffer = nullptr;
+    _drawVisibilityBuffer = nullptr;
+    _occludedDraws = 0;
+    _occludedTriangles = 0;
+
+    CreateInstanceBuffer(model);
     CreateVertexBuffer(model);
-    CreateIndexBuffer(model);
-    CreateSubMeshes(model);
+    const mesh_utils::IndexBuffers indexBuffers =
+        mesh_utils::BuildIndexBuffers(model.GetSubMeshes(), model.GetLods(), model.GetIndices());
+    CreateIndexBuffer(model, indexBuffers);
+    CreateSubMeshes(model, indexBuffers);
+    CreateMeshletCullResources(model, indexBuffers);
+    CreateDrawCullResources();
     CreateMaterials(model);
+    RecordOpaqueBundles();
 
     auto t1 = std::chrono::high_resolution_clock::now();
     double totalMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
@@ -493,6 +1530,7 @@ void WebgpuRenderer::UpdateEnvironment(const Environment& environment) {
 
     CreateEnvironmentTextures(environment);
     CreateGlobalBindGroup();
+    RecordOpaqueBundles();
 
     auto t1 = std::chrono::high_resolution_clock::now();
     double totalMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
@@ -513,6 +1551,10 @@ void WebgpuRenderer::InitGraphics(const Environment& environment, const Model& m
 
     CreateModelRenderPipelines();
     CreateEnvironmentRenderPipeline();
+    CreateMeshletCullPipeline();
+    CreateDrawCullPipeline();
+    CreateHiZPipelines();
+    CreateHiZResources();
 
     CreateUniformBuffers();
 
@@ -634,9 +1676,18 @@ void WebgpuRenderer::CreateDepthTexture() {
     depthTextureDescriptor.size = {width, height, 1};
     depthTextureDescriptor.format = wgpu::TextureFormat::Depth24PlusStencil8;
     depthTextureDescriptor.usage = wgpu::TextureUsage::RenderAttachment;
+    if (_options.occlusionCulling) {
+        depthTextureDescriptor.usage |= wgpu::TextureUsage::TextureBinding;
+    }
 
     _depthTexture = _device.CreateTexture(&depthTextureDescriptor);
     _depthTextureView = _depthTexture.CreateView();
+    _depthSampleView = nullptr;
+    if (_options.occlusionCulling) {
+        wgpu::TextureViewDescriptor viewDescriptor{};
+        viewDescriptor.aspect = wgpu::TextureAspect::DepthOnly;
+        _depthSampleView = _depthTexture.CreateView(&viewDescriptor);
+    }
 }
 
 void WebgpuRenderer::CreateBindGroupLayouts() {
@@ -693,7 +1744,7 @@ void WebgpuRenderer::CreateBindGroupLayouts() {
 
     _globalBindGroupLayout = _device.CreateBindGroupLayout(&globalBindGroupLayoutDescriptor);
 
-    wgpu::BindGroupLayoutEntry modelLayoutEntries[8]{};
+    wgpu::BindGroupLayoutEntry modelLayoutEntries[9]{};
 
     // 0: Model uniforms
     modelLayoutEntries[0].binding = 0;
@@ -724,8 +1775,15 @@ void WebgpuRenderer::CreateBindGroupLayouts() {
         modelLayoutEntries[binding].texture.multisampled = false;
     }
 
+    // 8: Instance transforms
+    modelLayoutEntries[8].binding = 8;
+    modelLayoutEntries[8].visibility = wgpu::ShaderStage::Vertex;
+    modelLayoutEntries[8].buffer.type = wgpu::BufferBindingType::ReadOnlyStorage;
+    modelLayoutEntries[8].buffer.hasDynamicOffset = false;
+    modelLayoutEntries[8].buffer.minBindingSize = sizeof(InstanceData);
+
     wgpu::BindGroupLayoutDescriptor modelBindGroupLayoutDescriptor{};
-    modelBindGroupLayoutDescriptor.entryCount = 8;
+    modelBindGroupLayoutDescriptor.entryCount = 9;
     modelBindGroupLayoutDescriptor.entries = modelLayoutEntries;
 
     _modelBindGroupLayout = _device.CreateBindGroupLayout(&modelBindGroupLayoutDescriptor);
@@ -775,12 +1833,14 @@ void WebgpuRenderer::CreateRenderPassDescriptor() {
     _colorAttachment.storeOp = wgpu::StoreOp::Store;
     _colorAttachment.clearValue = {.r = 0.0f, .g = 0.2f, .b = 0.4f, .a = 1.0f};
 
-    // Configure depth attachment.
+    // Configure depth attachment (kept from the depth prepass when it runs).
+    const wgpu::LoadOp depthLoadOp =
+        _options.depthPrepass ? wgpu::LoadOp::Load : wgpu::LoadOp::Clear;
     _depthAttachment.view = _depthTextureView;
-    _depthAttachment.depthLoadOp = wgpu::LoadOp::Clear;
+    _depthAttachment.depthLoadOp = depthLoadOp;
     _depthAttachment.depthStoreOp = wgpu::StoreOp::Store;
     _depthAttachment.depthClearValue = 1.0f;
-    _depthAttachment.stencilLoadOp = wgpu::LoadOp::Clear;
+    _depthAttachment.stencilLoadOp = depthLoadOp;
     _depthAttachment.stencilStoreOp = wgpu::StoreOp::Store;
 
     // Initialize render pass descriptor.
@@ -791,30 +1851,127 @@ void WebgpuRenderer::CreateRenderPassDescriptor() {
 
 void WebgpuRenderer::CreateVertexBuffer(const Model& model) {
     const std::vector<Model::Vertex>& vertexData = model.GetVertices();
+    const wgpu::BufferUsage usage = wgpu::BufferUsage::Vertex;
+
+    size_t positionStride = sizeof(Model::Vertex); // Bytes per vertex fetched by depth-only passes
+    size_t attributeStride = 0;                    // Second stream, when split
+
+    if (_options.packedVertices) {
+        std::vector<vertex_packing::PackedVertex> packedVertices;
+        std::vector<vertex_packing::Dequantization> dequantization;
+        const vertex_packing::PackStats stats = vertex_packing::PackVertices(
+            model.GetSubMeshes(), vertexData, packedVertices, dequantization);
+
+        // The buffer is stepped per instance, so each submesh's entry is repeated for each of its
+        // instance records. Keep it non-empty so it can always be bound.
+        std::vector<vertex_packing::Dequantization> instanceDequantization;
+        instanceDequantization.reserve(_instances.size());
+        for (size_t i = 0; i < dequantization.size(); ++i) {
+            instanceDequantization.insert(instanceDequantization.end(),
+                                          model.GetSubMeshes()[i]._instanceCount,
+                                          dequantization[i]);
+        }
+        instanceDequantization.resize(std::max<size_t>(instanceDequantization.size(), 1));
+        _dequantizationBuffer = CreateBufferFromData(_device, usage, instanceDequantization);
+
+        if (_options.splitVertexStreams) {
+            std::vector<vertex_packing::PackedPosition> positions;
+            std::vector<vertex_packing::PackedAttributes> attributes;
+            vertex_packing::SplitStreams(packedVertices, positions, attributes);
+            _vertexBuffer = CreateBufferFromData(_device, usage, positions);
+            _vertexAttributeBuffer = CreateBufferFromData(_device, usage, attributes);
+            positionStride = sizeof(vertex_packing::PackedPosition);
+            attributeStride = sizeof(vertex_packing::PackedAttributes);
+        } else {
+            _vertexBuffer = CreateBufferFromData(_device, usage, packedVertices);
+            positionStride = sizeof(vertex_packing::PackedVertex);
+        }
 
-    wgpu::BufferDescriptor vertexBufferDesc{};
-    vertexBufferDesc.size = vertexData.size() * sizeof(Model::Vertex);
-    vertexBufferDesc.usage = wgpu::BufferUsage::Vertex | wgpu::BufferUsage::CopyDst;
-    vertexBufferDesc.mappedAtCreation = true;
+        WGPU_LOG_INFO("Packed vertex max error: position {:.6f}, normal/tangent {:.4f} deg, "
+                      "uv {:.6f}",
+                      stats._maxPositionError, stats._maxNormalError, stats._maxTexCoordError);
+    } else if (_options.splitVertexStreams) {
+        std::vector<glm::vec3> positions;
+        std::vector<vertex_packing::VertexAttributes> attributes;
+        vertex_packing::SplitStreams(vertexData, positions, attributes);
+        _vertexBuffer = CreateBufferFromData(_device, usage, positions);
+        _vertexAttributeBuffer = CreateBufferFromData(_device, usage, attributes);
+        positionStride = sizeof(glm::vec3);
+        attributeStride = sizeof(vertex_packing::VertexAttributes);
+    } else {
+        _vertexBuffer = CreateBufferFromData(_device, usage, vertexData);
+    }
 
-    _vertexBuffer = _device.CreateBuffer(&vertexBufferDesc);
-    std::memcpy(_vertexBuffer.GetMappedRange(), vertexData.data(),
-                vertexData.size() * sizeof(Model::Vertex));
-    _vertexBuffer.Unmap();
+    // Estimated bytes fetched per frame at full detail: one vertex per post-transform cache miss.
+    // LOD ranges follow all the submesh ranges.
+    const std::vector<uint32_t>& indexData = model.GetIndices();
+    const size_t fullDetailIndexCount =
+        model.GetLods().empty() ? indexData.size() : model.GetLods().front()._firstIndex;
+    const size_t cacheMisses =
+        mesh_utils::AnalyzeVertexCache(indexData.data(), fullDetailIndexCount, vertexData.size())
+            ._cacheMisses;
+    const size_t vertexStride = positionStride + attributeStride;
+    WGPU_LOG_INFO("Vertex buffers: {} vertices x {} bytes = {:.2f}MB ({:.2f}MB unpacked), fetch "
+                  "~{:.2f}MB/frame, position-only ~{:.2f}MB/frame",
+                  vertexData.size(), vertexStride, ToMegabytes(vertexData.size() * vertexStride),
+                  ToMegabytes(vertexData.size() * sizeof(Model::Vertex)),
+                  ToMegabytes(cacheMisses * vertexStride),
+                  ToMegabytes(cacheMisses * positionStride));
 }
 
-void WebgpuRenderer::CreateIndexBuffer(const Model& model) {
-    const std::vector<uint32_t>& indexData = model.GetIndices();
+void WebgpuRenderer::CreateIndexBuffer(const Model& model,
+                                       const mesh_utils::IndexBuffers& indexBuffers) {
+    if (!_options.meshletCulling) {
+        const wgpu::BufferUsage usage = wgpu::BufferUsage::Index;
+        _indexBuffer16 = CreateBufferFromData(_device, usage, indexBuffers._indices16);
+        _indexBuffer32 = CreateBufferFromData(_device, usage, indexBuffers._indices32);
+    } else {
+        // The culling pass reads both buffers as storage, which can't be bound empty.
+        const wgpu::BufferUsage usage = wgpu::BufferUsage::Index | wgpu::BufferUsage::Storage;
+        const std::vector<uint32_t> placeholder(1, 0);
+        _indexBuffer16 = indexBuffers._indices16.empty()
+                             ? CreateBufferFromData(_device, usage, placeholder)
+                             : CreateBufferFromData(_device, usage, indexBuffers._indices16);
+        _indexBuffer32 = indexBuffers._indices32.empty()
+                             ? CreateBufferFromData(_device, usage, placeholder)
+                             : CreateBufferFromData(_device, usage, indexBuffers._indices32);
+    }
 
-    wgpu::BufferDescriptor indexBufferDesc{};
-    indexBufferDesc.size = indexData.size() * sizeof(uint32_t);
-    indexBufferDesc.usage = wgpu::BufferUsage::Index | wgpu::BufferUsage::CopyDst;
-    indexBufferDesc.mappedAtCreation = true;
+    const size_t size = indexBuffers._indices16.size() * sizeof(uint16_t) +
+                        indexBuffers._indices32.size() * sizeof(uint32_t);
+    WGPU_LOG_INFO("Index buffers: {} 16-bit + {} 32-bit indices = {:.2f}MB (was {:.2f}MB)",
+                  indexBuffers._indices16.size(), indexBuffers._indices32.size(), ToMegabytes(size),
+                  ToMegabytes(model.GetIndices().size() * sizeof(uint32_t)));
+}
+
+void WebgpuRenderer::CreateInstanceBuffer(const Model& model) {
+    // Submeshes with baked transforms get one identity record each, so every draw can use
+    // firstInstance to find its records.
+    const std::vector<glm::mat4>& transforms = model.GetInstanceTransforms();
+    _instances.clear();
+    size_t instancedDraws = 0;
+    for (const Model::SubMesh& subMesh : model.GetSubMeshes()) {
+        for (uint32_t i = 0; i < subMesh._instanceCount; ++i) {
+            const glm::mat4 transform = subMesh._firstInstance + i < transforms.size()
+                                            ? transforms[subMesh._firstInstance + i]
+                                            : glm::mat4(1.0f);
+            _instances.push_back(
+                {.modelMatrix = transform, .normalMatrix = GetNormalMatrix(transform)});
+        }
+        instancedDraws += subMesh._instanced ? 1 : 0;
+    }
+
+    // Keep the buffer non-empty so it can always be bound.
+    std::vector<InstanceData> records = _instances;
+    records.resize(std::max<size_t>(records.size(), 1),
+                   {.modelMatrix = glm::mat4(1.0f), .normalMatrix = glm::mat4(1.0f)});
+    _instanceBuffer = CreateBufferFromData(_device, wgpu::BufferUsage::Storage, records);
 
-    _indexBuffer = _device.CreateBuffer(&indexBufferDesc);
-    std::memcpy(_indexBuffer.GetMappedRange(), indexData.data(),
-                indexData.size() * sizeof(uint32_t));
-    _indexBuffer.Unmap();
+    if (instancedDraws > 0) {
+        WGPU_LOG_INFO("Instancing: {} instanced draws, {} instance records ({:.2f}MB)",
+                      instancedDraws, _instances.size(),
+                      ToMegabytes(records.size() * sizeof(InstanceData)));
+    }
 }
 
 void WebgpuRenderer::CreateUniformBuffers() {
@@ -885,27 +2042,309 @@ void WebgpuRenderer::CreateEnvironmentTextures(const Environment& environment) {
                                     MipmapGenerator::MipKind::Float16Cube);
 }
 
-void WebgpuRenderer::CreateSubMeshes(const Model& model) {
+void WebgpuRenderer::CreateSubMeshes(const Model& model,
+                                     const mesh_utils::IndexBuffers& indexBuffers) {
     _opaqueMeshes.clear();
     _transparentMeshes.clear();
     _opaqueMeshes.reserve(model.GetSubMeshes().size());
 
-    for (const auto& srcSubMesh : model.GetSubMeshes()) {
-        SubMesh dstSubMesh = {._firstIndex = srcSubMesh._firstIndex,
+    const std::vector<Model::Lod>& lods = model.GetLods();
+    _lods.resize(lods.size());
+    for (size_t i = 0; i < lods.size(); ++i) {
+        _lods[i] = {._firstIndex = indexBuffers._lodFirstIndices[i],
+                    ._indexCount = lods[i]._indexCount,
+                    ._error = lods[i]._error};
+    }
+
+    for (std::vector<float>& bounds : _recordBounds) {
+        bounds.assign(_instances.size(), 0.0f);
+    }
+    _recordVisible.assign(_instances.size(), 1);
+
+    uint32_t firstInstance = 0; // Records follow submesh order, see CreateInstanceBuffer
+    for (size_t i = 0; i < model.GetSubMeshes().size(); ++i) {
+        const Model::SubMesh& srcSubMesh = model.GetSubMeshes()[i];
+        const mesh_utils::IndexBuffers::Range& range = indexBuffers._ranges[i];
+        const glm::vec3 extent = srcSubMesh._maxBounds - srcSubMesh._minBounds;
+        SubMesh dstSubMesh = {._firstIndex = range._firstIndex,
                               ._indexCount = srcSubMesh._indexCount,
+                              ._baseVertex = range._baseVertex,
                               ._materialIndex = srcSubMesh._materialIndex,
-                              ._centroid = (srcSubMesh._minBounds + srcSubMesh._maxBounds) * 0.5f};
+                              ._centroid = (srcSubMesh._minBounds + srcSubMesh._maxBounds) * 0.5f,
+                              ._modelIndex = static_cast<uint32_t>(i),
+                              ._indexFormat = range._is16Bit ? wgpu::IndexFormat::Uint16
+                                                             : wgpu::IndexFormat::Uint32,
+                              ._radius = glm::length(extent) * 0.5f,
+                              ._firstLod = srcSubMesh._firstLod,
+                              ._lodCount = srcSubMesh._lodCount,
+                              ._firstInstance = firstInstance,
+                              ._instanceCount = srcSubMesh._instanceCount};
+
+        // The submesh box moved into model space by each of its instances.
+        for (uint32_t r = firstInstance; r < firstInstance + srcSubMesh._instanceCount; ++r) {
+            glm::vec3 minBounds(std::numeric_limits<float>::max());
+            glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
+            for (int corner = 0; corner < 8; ++corner) {
+                const glm::vec3 local(
+                    (corner & 1) ? srcSubMesh._maxBounds.x : srcSubMesh._minBounds.x,
+                    (corner & 2) ? srcSubMesh._maxBounds.y : srcSubMesh._minBounds.y,
+                    (corner & 4) ? srcSubMesh._maxBounds.z : srcSubMesh._minBounds.z);
+                const glm::vec3 position =
+                    glm::vec3(_instances[r].modelMatrix * glm::vec4(local, 1.0f));
+                minBounds = glm::min(minBounds, position);
+                maxBounds = glm::max(maxBounds, position);
+            }
+            for (int axis = 0; axis < 3; ++axis) {
+                _recordBounds[axis][r] = minBounds[axis];
+                _recordBounds[3 + axis][r] = maxBounds[axis];
+            }
+        }
+        firstInstance += srcSubMesh._instanceCount;
         if (model.GetMaterials()[srcSubMesh._materialIndex]._alphaMode == Model::AlphaMode::Blend) {
             _transparentMeshes.push_back(dstSubMesh);
         } else {
             _opaqueMeshes.push_back(dstSubMesh);
         }
     }
+
+    // Group opaque draws by index width so each group binds its index buffer once.
+    std::stable_partition(_opaqueMeshes.begin(), _opaqueMeshes.end(), [](const SubMesh& subMesh) {
+        return subMesh._indexFormat == wgpu::IndexFormat::Uint16;
+    });
+}
+
+void WebgpuRenderer::CreateMeshletCullResources(const Model& model,
+                                                const mesh_utils::IndexBuffers& indexBuffers) {
+    static_assert(sizeof(MeshletCullData) == 64, "MeshletCullData must match meshlet_cull.wgsl");
+    static_assert(sizeof(MeshletCullUniforms) == 112,
+                  "MeshletCullUniforms must match meshlet_cull.wgsl");
+
+    _meshletCount = 0;
+    _meshletTriangleCount = 0;
+    _culledDrawReset.clear();
+    if (!_options.meshletCulling) {
+        return;
+    }
+
+    const std::vector<Model::SubMesh>& subMeshes = model.GetSubMeshes();
+    const std::vector<Model::Meshlet>& meshlets = model.GetMeshlets();
+    if (meshlets.empty()) {
+        WGPU_LOG_WARNING("Meshlet culling requested, but the model has no meshlets.");
+        return;
+    }
+
+    // One indirect draw per opaque submesh, each with its own region of the culled index buffer.
+    std::vector<MeshletCullData> cullData;
+    uint32_t culledIndexCount = 0;
+    for (uint32_t drawIndex = 0; drawIndex < _opaqueMeshes.size(); ++drawIndex) {
+        const SubMesh& subMesh = _opaqueMeshes[drawIndex];
+        const Model::SubMesh& srcSubMesh = subMeshes[subMesh._modelIndex];
+        const mesh_utils::IndexBuffers::Range& range = indexBuffers._ranges[subMesh._modelIndex];
+
+        // Double-sided surfaces are visible from behind, so only the frustum test applies.
+        const bool doubleSided = model.GetMaterials()[srcSubMesh._materialIndex]._doubleSided;
+
+        // Instanced meshlets are in mesh space while the test runs in model space; every instance
+        // draws the same compacted indices, so they are kept unconditionally.
+        const bool instanced = srcSubMesh._instanced;
+
+        const uint32_t firstCulledIndex = culledIndexCount;
+        for (uint32_t m = 0; m < srcSubMesh._meshletCount; ++m) {
+            const Model::Meshlet& meshlet = meshlets[srcSubMesh._firstMeshlet + m];
+            cullData.push_back(
+                {.sphere = glm::vec4(meshlet._center,
+                                     instanced ? std::numeric_limits<float>::max()
+                                               : meshlet._radius),
+                 .coneApex = glm::vec4(meshlet._coneApex,
+                                       doubleSided || instanced ? 2.0f : meshlet._coneCutoff),
+                 .coneAxis = meshlet._coneAxis,
+                 .drawIndex = drawIndex,
+                 .firstIndex = range._firstIndex + (meshlet._firstIndex - srcSubMesh._firstIndex),
+                 .indexCount = meshlet._indexCount,
+                 .is16Bit = range._is16Bit ? 1u : 0u,
+                 ._pad = 0});
+            culledIndexCount += meshlet._indexCount;
+        }
+
+        _culledDrawReset.push_back({.indexCount = 0,
+                                    .instanceCount = subMesh._instanceCount,
+                                    .firstIndex = firstCulledIndex,
+                                    .baseVertex = subMesh._baseVertex,
+                                    .firstInstance = subMesh._firstInstance});
+    }
+
+    if (cullData.empty()) {
+        return;
+    }
+
+    _meshletBuffer = CreateBufferFromData(_device, wgpu::BufferUsage::Storage, cullData);
+    _culledDrawBuffer = CreateBufferFromData(
+        _device,
+        wgpu::BufferUsage::Indirect | wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc,
+        _culledDrawReset);
+
+    wgpu::BufferDescriptor descriptor{};
+    descriptor.size = static_cast<uint64_t>(culledIndexCount) * sizeof(uint32_t);
+    descriptor.usage = wgpu::BufferUsage::Index | wgpu::BufferUsage::Storage;
+    _culledIndexBuffer = _device.CreateBuffer(&descriptor);
+
+    descriptor.size = _culledDrawBuffer.GetSize();
+    descriptor.usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst;
+    _culledDrawReadbackBuffer = _device.CreateBuffer(&descriptor);
+
+    if (!_meshletCullUniformBuffer) {
+        descriptor.size = sizeof(MeshletCullUniforms);
+        descriptor.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+        _meshletCullUniformBuffer = _device.CreateBuffer(&descriptor);
+    }
+
+    wgpu::BindGroupEntry entries[6]{};
+    entries[0].binding = 0;
+    entries[0].buffer = _meshletCullUniformBuffer;
+    entries[1].binding = 1;
+    entries[1].buffer = _meshletBuffer;
+    entries[2].binding = 2;
+    entries[2].buffer = _indexBuffer16;
+    entries[3].binding = 3;
+    entries[3].buffer = _indexBuffer32;
+    entries[4].binding = 4;
+    entries[4].buffer = _culledDrawBuffer;
+    entries[5].binding = 5;
+    entries[5].buffer = _culledIndexBuffer;
+
+    wgpu::BindGroupDescriptor bindGroupDescriptor{};
+    bindGroupDescriptor.layout = _meshletCullBindGroupLayout;
+    bindGroupDescriptor.entryCount = 6;
+    bindGroupDescriptor.entries = entries;
+    _meshletCullBindGroup = _device.CreateBindGroup(&bindGroupDescriptor);
+
+    _meshletCount = static_cast<uint32_t>(cullData.size());
+    for (const MeshletCullData& meshlet : cullData) {
+        _meshletTriangleCount += meshlet.indexCount / 3;
+    }
+    WGPU_LOG_INFO("Meshlet culling: {} meshlets in {} opaque draws, {:.2f}MB culled index buffer",
+                  _meshletCount, _culledDrawReset.size(), ToMegabytes(descriptor.size));
+}
+
+void WebgpuRenderer::CreateDrawCullResources() {
+    static_assert(sizeof(DrawCullRecord) == 64, "DrawCullRecord must match draw_cull.wgsl");
+    static_assert(sizeof(DrawCullUniforms) == 192, "DrawCullUniforms must match draw_cull.wgsl");
+
+    _drawRecordCount = 0;
+    _drawGroups.clear();
+    _drawArgsReset.clear();
+    if (!_options.gpuDrivenDraws || _opaqueMeshes.empty()) {
+        return;
+    }
+
+    // Slots are ordered by index format, then material, so every group is one contiguous run.
+    std::vector<uint32_t> order(_opaqueMeshes.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        const SubMesh& first = _opaqueMeshes[a];
+        const SubMesh& second = _opaqueMeshes[b];
+        if (first._indexFormat != second._indexFormat) {
+            return first._indexFormat == wgpu::IndexFormat::Uint16;
+        }
+        return first._materialIndex < second._materialIndex;
+    });
+
+    std::vector<DrawCullRecord> records;
+    records.reserve(order.size());
+    for (uint32_t slot = 0; slot < order.size(); ++slot) {
+        const SubMesh& subMesh = _opaqueMeshes[order[slot]];
+        if (_drawGroups.empty() || _drawGroups.back()._materialIndex != subMesh._materialIndex ||
+            _drawGroups.back()._indexFormat != subMesh._indexFormat) {
+            _drawGroups.push_back({._firstSlot = slot,
+                                   ._drawCount = 0,
+                                   ._materialIndex = subMesh._materialIndex,
+                                   ._indexFormat = subMesh._indexFormat});
+        }
+        ++_drawGroups.back()._drawCount;
+
+        DrawCullRecord record{};
+        record.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+        record.boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+        for (uint32_t r = subMesh._firstInstance;
+             r < subMesh._firstInstance + subMesh._instanceCount; ++r) {
+            for (int axis = 0; axis < 3; ++axis) {
+                record.boundsMin[axis] = std::min(record.boundsMin[axis], _recordBounds[axis][r]);
+                record.boundsMax[axis] =
+                    std::max(record.boundsMax[axis], _recordBounds[3 + axis][r]);
+            }
+        }
+        record.firstSlot = _drawGroups.back()._firstSlot;
+        record.group = static_cast<uint32_t>(_drawGroups.size() - 1);
+        record.indexCount = subMesh._indexCount;
+        record.firstIndex = subMesh._firstIndex;
+        record.baseVertex = subMesh._baseVertex;
+        record.firstInstance = subMesh._firstInstance;
+        record.instanceCount = subMesh._instanceCount;
+        records.push_back(record);
+    }
+    // Occlusion culling keeps a second phase of slots and counts, then the occlusion totals.
+    const bool occlusion = _drawPhaseCount > 1;
+    _drawArgsReset.assign(records.size() * _drawPhaseCount, DrawIndexedIndirectArgs{});
+
+    _drawRecordBuffer = CreateBufferFromData(_device, wgpu::BufferUsage::Storage, records);
+    _drawArgsBuffer = CreateBufferFromData(
+        _device, wgpu::BufferUsage::Indirect | wgpu::BufferUsage::Storage, _drawArgsReset);
+    const size_t countSlots = _drawGroups.size() * _drawPhaseCount + (occlusion ? 2 : 0);
+    const std::vector<uint32_t> zeroCounts(countSlots, 0);
+    _drawCountBuffer = CreateBufferFromData(
+        _device,
+        wgpu::BufferUsage::Indirect | wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc,
+        zeroCounts);
+
+    wgpu::BufferDescriptor descriptor{};
+    descriptor.size = _drawCountBuffer.GetSize();
+    descriptor.usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst;
+    _drawCountReadbackBuffer = _device.CreateBuffer(&descriptor);
+
+    if (!_drawCullUniformBuffer) {
+        descriptor.size = sizeof(DrawCullUniforms);
+        descriptor.usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst;
+        _drawCullUniformBuffer = _device.CreateBuffer(&descriptor);
+    }
+
+    // Everything starts out visible, so the first frame draws it all in phase 0.
+    if (occlusion) {
+        const std::vector<uint32_t> visibility(records.size(), 1);
+        _drawVisibilityBuffer =
+            CreateBufferFromData(_device, wgpu::BufferUsage::Storage, visibility);
+    }
+
+    wgpu::BindGroupEntry entries[5]{};
+    entries[0].binding = 0;
+    entries[0].buffer = _drawCullUniformBuffer;
+    entries[1].binding = 1;
+    entries[1].buffer = _drawRecordBuffer;
+    entries[2].binding = 2;
+    entries[2].buffer = _drawArgsBuffer;
+    entries[3].binding = 3;
+    entries[3].buffer = _drawCountBuffer;
+    entries[4].binding = 4;
+    entries[4].buffer = _drawVisibilityBuffer;
+
+    wgpu::BindGroupDescriptor bindGroupDescriptor{};
+    bindGroupDescriptor.layout = _drawCullBindGroupLayout;
+    bindGroupDescriptor.entryCount = occlusion ? 5 : 4;
+    bindGroupDescriptor.entries = entries;
+    _drawCullBindGroup = _device.CreateBindGroup(&bindGroupDescriptor);
+
+    _drawRecordCount = static_cast<uint32_t>(records.size());
+    WGPU_LOG_INFO("GPU-driven draws: {} opaque draws in {} groups, {}, {:.2f}MB of records{}",
+                  _drawRecordCount, _drawGroups.size(),
+                  _multiDrawIndirect ? "multi-draw-indirect" : "one indirect draw per slot",
+                  ToMegabytes(records.size() * sizeof(DrawCullRecord)),
+                  occlusion ? ", occlusion culled" : "");
 }
 
 void WebgpuRenderer::CreateMaterials(const Model& model) {
     // Create mipmap generator helper.
     MipmapGenerator mipmapGenerator(_device);
+    TextureUploadStats uploadStats;
+    MaterialTextureCache textureCache;
 
     _materials.clear();
 
@@ -936,58 +2375,57 @@ void WebgpuRenderer::CreateMaterials(const Model& model) {
             _device.GetQueue().WriteBuffer(dstMat._uniformBuffer, 0, &dstMat._uniforms,
                                            sizeof(MaterialUniforms));
 
+            // Texture slots share one texture per image and way of sampling it.
+            wgpu::TextureView baseColorView = _defaultSRGBTextureView;
+            wgpu::TextureView metallicRoughnessView = _defaultUNormTextureView;
+            wgpu::TextureView normalView = _defaultNormalTextureView;
+            wgpu::TextureView occlusionView = _defaultUNormTextureView;
+            wgpu::TextureView emissiveView = _defaultSRGBTextureView;
+            dstMat._baseColorTexture = _defaultSRGBTexture;
+            dstMat._metallicRoughnessTexture = _defaultUNormTexture;
+            dstMat._normalTexture = _defaultNormalTexture;
+            dstMat._occlusionTexture = _defaultUNormTexture;
+            dstMat._emissiveTexture = _defaultSRGBTexture;
+            const auto acquire = [&](int image, wgpu::TextureFormat format, glm::vec4 defaultValue,
+                                     MipmapGenerator::MipKind kind, wgpu::Texture& texture,
+                                     wgpu::TextureView& view) {
+                if (!model.GetTexture(image)) {
+                    return;
+                }
+                const MaterialTextureCache::Entry entry = textureCache.Acquire(
+                    model, image, format, defaultValue, _device, mipmapGenerator, kind,
+                    uploadStats);
+                texture = entry._texture;
+                view = entry._view;
+            };
+
             // Base Color Texture
-            if (const Model::Texture* t = model.GetTexture(srcMat._baseColorTexture)) {
-                glm::vec4 defaultBaseColor(1.0f);
-                CreateTexture(t, wgpu::TextureFormat::RGBA8UnormSrgb, defaultBaseColor, _device,
-                              mipmapGenerator, MipmapGenerator::MipKind::SRGB2D,
-                              dstMat._baseColorTexture);
-            } else {
-                dstMat._baseColorTexture = _defaultSRGBTexture;
-            }
+            acquire(srcMat._baseColorTexture, wgpu::TextureFormat::RGBA8UnormSrgb,
+                    glm::vec4(1.0f), MipmapGenerator::MipKind::SRGB2D, dstMat._baseColorTexture,
+                    baseColorView);
 
             // Metallic-Roughness
-            if (const Model::Texture* t = model.GetTexture(srcMat._metallicRoughnessTexture)) {
-                glm::vec4 defaultMR(1.0f);
-                CreateTexture(t, wgpu::TextureFormat::RGBA8Unorm, defaultMR, _device,
-                              mipmapGenerator, MipmapGenerator::MipKind::LinearUNorm2D,
-                              dstMat._metallicRoughnessTexture);
-            } else {
-                dstMat._metallicRoughnessTexture = _defaultUNormTexture;
-            }
+            acquire(srcMat._metallicRoughnessTexture, wgpu::TextureFormat::RGBA8Unorm,
+                    glm::vec4(1.0f), MipmapGenerator::MipKind::LinearUNorm2D,
+                    dstMat._metallicRoughnessTexture, metallicRoughnessView);
 
             // Normal Texture
-            if (const Model::Texture* t = model.GetTexture(srcMat._normalTexture)) {
-                glm::vec4 defaultNormal(0.5f, 0.5f, 1.0f, 1.0f);
-                CreateTexture(t, wgpu::TextureFormat::RGBA8Unorm, defaultNormal, _device,
-                              mipmapGenerator, MipmapGenerator::MipKind::Normal2D,
-                              dstMat._normalTexture);
-            } else {
-                dstMat._normalTexture = _defaultNormalTexture;
-            }
+            acquire(srcMat._normalTexture, wgpu::TextureFormat::RGBA8Unorm,
+                    glm::vec4(0.5f, 0.5f, 1.0f, 1.0f), MipmapGenerator::MipKind::Normal2D,
+                    dstMat._normalTexture, normalView);
 
             // Occlusion Texture
-            if (const Model::Texture* t = model.GetTexture(srcMat._occlusionTexture)) {
-                glm::vec4 defaultOcc(1.0f);
-                CreateTexture(t, wgpu::TextureFormat::RGBA8Unorm, defaultOcc, _device,
-                              mipmapGenerator, MipmapGenerator::MipKind::LinearUNorm2D,
-                              dstMat._occlusionTexture);
-            } else {
-                dstMat._occlusionTexture = _defaultUNormTexture;
-            }
+            acquire(srcMat._occlusionTexture, wgpu::TextureFormat::RGBA8Unorm, glm::vec4(1.0f),
+                    MipmapGenerator::MipKind::LinearUNorm2D, dstMat._occlusionTexture,
+                    occlusionView);
 
             // Emissive Texture
-            if (const Model::Texture* t = model.GetTexture(srcMat._emissiveTexture)) {
-                glm::vec4 defaultEmissive(1.0f);
-                CreateTexture(t, wgpu::TextureFormat::RGBA8UnormSrgb, defaultEmissive, _device,
-                              mipmapGenerator, MipmapGenerator::MipKind::SRGB2D,
-                              dstMat._emissiveTexture);
-            } else {
-                dstMat._emissiveTexture = _defaultSRGBTexture;
-            }
+            acquire(srcMat._emissiveTexture, wgpu::TextureFormat::RGBA8UnormSrgb,
+                    glm::vec4(1.0f), MipmapGenerator::MipKind::SRGB2D, dstMat._emissiveTexture,
+                    emissiveView);
 
             // Create bind group.
-            wgpu::BindGroupEntry bindGroupEntries[8]{};
+            wgpu::BindGroupEntry bindGroupEntries[9]{};
             bindGroupEntries[0].binding = 0;
             bindGroupEntries[0].buffer = _modelUniformBuffer;
             bindGroupEntries[0].offset = 0;
@@ -1002,28 +2440,47 @@ void WebgpuRenderer::CreateMaterials(const Model& model) {
             bindGroupEntries[2].sampler = _modelTextureSampler;
 
             bindGroupEntries[3].binding = 3;
-            bindGroupEntries[3].textureView = dstMat._baseColorTexture.CreateView();
+            bindGroupEntries[3].textureView = baseColorView;
 
             bindGroupEntries[4].binding = 4;
-            bindGroupEntries[4].textureView = dstMat._metallicRoughnessTexture.CreateView();
+            bindGroupEntries[4].textureView = metallicRoughnessView;
 
             bindGroupEntries[5].binding = 5;
-            bindGroupEntries[5].textureView = dstMat._normalTexture.CreateView();
+            bindGroupEntries[5].textureView = normalView;
 
             bindGroupEntries[6].binding = 6;
-            bindGroupEntries[6].textureView = dstMat._occlusionTexture.CreateView();
+            bindGroupEntries[6].textureView = occlusionView;
 
             bindGroupEntries[7].binding = 7;
-            bindGroupEntries[7].textureView = dstMat._emissiveTexture.CreateView();
+            bindGroupEntries[7].textureView = emissiveView;
+
+            bindGroupEntries[8].binding = 8;
+            bindGroupEntries[8].buffer = _instanceBuffer;
 
             wgpu::BindGroupDescriptor bindGroupDescriptor{};
             bindGroupDescriptor.layout = _modelBindGroupLayout;
-            bindGroupDescriptor.entryCount = 8;
+            bindGroupDescriptor.entryCount = 9;
             bindGroupDescriptor.entries = bindGroupEntries;
 
             dstMat._bindGroup = _device.CreateBindGroup(&bindGroupDescriptor);
         }
     }
+
+    if (uploadStats._direct + uploadStats._decoded + uploadStats._unsupported > 0) {
+        WGPU_LOG_INFO("Textures with stored mips: {} uploaded as stored, {} decoded to RGBA8, "
+                      "{} unsupported; {:.2f}MB uploaded ({:.2f}MB as mipmapped RGBA8), "
+                      "mip generation skipped",
+                      uploadStats._direct, uploadStats._decoded, uploadStats._unsupported,
+                      ToMegabytes(uploadStats._uploadedBytes),
+                      ToMegabytes(uploadStats._rgba8Bytes));
+    }
+    if (textureCache.GetCreatedCount() > 0) {
+        WGPU_LOG_INFO("Material textures: {} created for {} slot references, {} shared; "
+                      "{:.2f}MB of uploads saved",
+                      textureCache.GetCreatedCount(),
+                      textureCache.GetCreatedCount() + textureCache.GetReusedCount(),
+                      textureCache.GetReusedCount(), ToMegabytes(textureCache.GetSavedBytes()));
+    }
 }
 
 void WebgpuRenderer::CreateGlobalBindGroup() {
@@ -1071,6 +2528,14 @@ void WebgpuRenderer::CreateModelRenderPipelines() {
     wgpu::ShaderModuleDescriptor shaderModuleDescriptor{.nextInChain = &wgsl};
     _modelShaderModule = _device.CreateShaderModule(&shaderModuleDescriptor);
 
+    using vertex_packing::Dequantization;
+    using vertex_packing::PackedAttributes;
+    using vertex_packing::PackedPosition;
+    using vertex_packing::PackedVertex;
+    using vertex_packing::VertexAttributes;
+    const bool packed = _options.packedVertices;
+    const bool split = _options.splitVertexStreams;
+
     wgpu::VertexAttribute vertexAttributes[] = {
         {.format = wgpu::VertexFormat::Float32x3,
          .offset = offsetof(Model::Vertex, _position),
@@ -1092,11 +2557,116 @@ void WebgpuRenderer::CreateModelRenderPipelines() {
          .shaderLocation = 5},
     };
 
-    wgpu::VertexBufferLayout vertexBufferLayout{};
-    vertexBufferLayout.arrayStride = sizeof(Model::Vertex);
-    vertexBufferLayout.stepMode = wgpu::VertexStepMode::Vertex;
-    vertexBufferLayout.attributeCount = 6;
-    vertexBufferLayout.attributes = vertexAttributes;
+    wgpu::VertexAttribute packedVertexAttributes[] = {
+        {.format = wgpu::VertexFormat::Unorm16x4,
+         .offset = offsetof(PackedVertex, _positionXY),
+         .shaderLocation = 0},
+        {.format = wgpu::VertexFormat::Snorm16x2,
+         .offset = offsetof(PackedVertex, _normal),
+         .shaderLocation = 1},
+        {.format = wgpu::VertexFormat::Snorm16x2,
+         .offset = offsetof(PackedVertex, _tangent),
+         .shaderLocation = 2},
+        {.format = wgpu::VertexFormat::Float16x2,
+         .offset = offsetof(PackedVertex, _texCoord0),
+         .shaderLocation = 3},
+        {.format = wgpu::VertexFormat::Float16x2,
+         .offset = offsetof(PackedVertex, _texCoord1),
+         .shaderLocation = 4},
+        {.format = wgpu::VertexFormat::Unorm8x4,
+         .offset = offsetof(PackedVertex, _color),
+         .shaderLocation = 5},
+    };
+
+    // Second stream of the split layouts (positions stay at location 0 in the first stream).
+    wgpu::VertexAttribute attributeStreamAttributes[] = {
+        {.format = wgpu::VertexFormat::Float32x3,
+         .offset = offsetof(VertexAttributes, _normal),
+         .shaderLocation = 1},
+        {.format = wgpu::VertexFormat::Float32x4,
+         .offset = offsetof(VertexAttributes, _tangent),
+         .shaderLocation = 2},
+        {.format = wgpu::VertexFormat::Float32x2,
+         .offset = offsetof(VertexAttributes, _texCoord0),
+         .shaderLocation = 3},
+        {.format = wgpu::VertexFormat::Float32x2,
+         .offset = offsetof(VertexAttributes, _texCoord1),
+         .shaderLocation = 4},
+        {.format = wgpu::VertexFormat::Float32x4,
+         .offset = offsetof(VertexAttributes, _color),
+         .shaderLocation = 5},
+    };
+
+    wgpu::VertexAttribute packedAttributeStreamAttributes[] = {
+        {.format = wgpu::VertexFormat::Snorm16x2,
+         .offset = offsetof(PackedAttributes, _normal),
+         .shaderLocation = 1},
+        {.format = wgpu::VertexFormat::Snorm16x2,
+         .offset = offsetof(PackedAttributes, _tangent),
+         .shaderLocation = 2},
+        {.format = wgpu::VertexFormat::Float16x2,
+         .offset = offsetof(PackedAttributes, _texCoord0),
+         .shaderLocation = 3},
+        {.format = wgpu::VertexFormat::Float16x2,
+         .offset = offsetof(PackedAttributes, _texCoord1),
+         .shaderLocation = 4},
+        {.format = wgpu::VertexFormat::Unorm8x4,
+         .offset = offsetof(PackedAttributes, _color),
+         .shaderLocation = 5},
+    };
+
+    wgpu::VertexAttribute dequantizationAttributes[] = {
+        {.format = wgpu::VertexFormat::Float32x3,
+         .offset = offsetof(Dequantization, _offset),
+         .shaderLocation = 6},
+        {.format = wgpu::VertexFormat::Float32x3,
+         .offset = offsetof(Dequantization, _scale),
+         .shaderLocation = 7},
+    };
+
+    // Position is the first member of every vertex layout.
+    static_assert(offsetof(Model::Vertex, _position) == 0);
+    static_assert(offsetof(PackedVertex, _positionXY) == 0);
+    wgpu::VertexAttribute positionAttribute{
+        .format = packed ? wgpu::VertexFormat::Unorm16x4 : wgpu::VertexFormat::Float32x3,
+        .offset = 0,
+        .shaderLocation = 0};
+
+    // Buffer slots (see BindModelVertexBuffers): the interleaved vertices or the position stream,
+    // then the packed dequantization, then the split attribute stream. Position-only pipelines
+    // use the leading slots alone.
+    wgpu::VertexBufferLayout vertexBufferLayouts[3]{};
+    uint32_t vertexBufferCount = 0;
+    uint32_t positionBufferCount = 0;
+
+    wgpu::VertexBufferLayout& firstLayout = vertexBufferLayouts[vertexBufferCount++];
+    firstLayout.stepMode = wgpu::VertexStepMode::Vertex;
+    if (split) {
+        firstLayout.arrayStride = packed ? sizeof(PackedPosition) : sizeof(glm::vec3);
+        firstLayout.attributeCount = 1;
+        firstLayout.attributes = &positionAttribute;
+    } else {
+        firstLayout.arrayStride = packed ? sizeof(PackedVertex) : sizeof(Model::Vertex);
+        firstLayout.attributeCount = 6;
+        firstLayout.attributes = packed ? packedVertexAttributes : vertexAttributes;
+    }
+
+    if (packed) {
+        wgpu::VertexBufferLayout& layout = vertexBufferLayouts[vertexBufferCount++];
+        layout.arrayStride = sizeof(Dequantization);
+        layout.stepMode = wgpu::VertexStepMode::Instance;
+        layout.attributeCount = 2;
+        layout.attributes = dequantizationAttributes;
+    }
+    positionBufferCount = vertexBufferCount;
+
+    if (split) {
+        wgpu::VertexBufferLayout& layout = vertexBufferLayouts[vertexBufferCount++];
+        layout.arrayStride = packed ? sizeof(PackedAttributes) : sizeof(VertexAttributes);
+        layout.stepMode = wgpu::VertexStepMode::Vertex;
+        layout.attributeCount = 5;
+        layout.attributes = packed ? packedAttributeStreamAttributes : attributeStreamAttributes;
+    }
 
     wgpu::ColorTargetState colorTargetState{};
     colorTargetState.format = _surfaceFormat;
@@ -1123,11 +2693,31 @@ void WebgpuRenderer::CreateModelRenderPipelines() {
     wgpu::RenderPipelineDescriptor descriptor{};
     descriptor.layout = pipelineLayout;
     descriptor.vertex.module = _modelShaderModule;
-    descriptor.vertex.entryPoint = "vs_main";
-    descriptor.vertex.bufferCount = 1;
-    descriptor.vertex.buffers = &vertexBufferLayout;
     descriptor.primitive.topology = wgpu::PrimitiveTopology::TriangleList;
     descriptor.depthStencil = &depthStencilState;
+
+    // Depth-only pipeline for the prepass: positions only, no fragment stage.
+    if (_options.depthPrepass) {
+        wgpu::VertexBufferLayout positionLayout = firstLayout;
+        positionLayout.attributeCount = 1;
+        positionLayout.attributes = &positionAttribute;
+
+        wgpu::VertexBufferLayout positionBufferLayouts[2] = {positionLayout, {}};
+        if (packed) {
+            positionBufferLayouts[1] = vertexBufferLayouts[1];
+        }
+
+        descriptor.vertex.entryPoint = packed ? "vs_depth_packed" : "vs_depth";
+        descriptor.vertex.bufferCount = positionBufferCount;
+        descriptor.vertex.buffers = positionBufferLayouts;
+        descriptor.fragment = nullptr;
+
+        _modelPipelineDepth = _device.CreateRenderPipeline(&descriptor);
+    }
+
+    descriptor.vertex.entryPoint = packed ? "vs_main_packed" : "vs_main";
+    descriptor.vertex.bufferCount = vertexBufferCount;
+    descriptor.vertex.buffers = vertexBufferLayouts;
     descriptor.fragment = &fragmentState;
 
     _modelPipelineOpaque = _device.CreateRenderPipeline(&descriptor);
@@ -1148,6 +2738,217 @@ void WebgpuRenderer::CreateModelRenderPipelines() {
     _modelPipelineTransparent = _device.CreateRenderPipeline(&descriptor);
 }
 
+void WebgpuRenderer::CreateMeshletCullPipeline() {
+    if (!_options.meshletCulling) {
+        return;
+    }
+
+    if (!_meshletCullBindGroupLayout) {
+        wgpu::BindGroupLayoutEntry entries[6]{};
+        for (uint32_t i = 0; i < 6; ++i) {
+            entries[i].binding = i;
+            entries[i].visibility = wgpu::ShaderStage::Compute;
+        }
+        entries[0].buffer.type = wgpu::BufferBindingType::Uniform;
+        entries[0].buffer.minBindingSize = sizeof(MeshletCullUniforms);
+        entries[1].buffer.type = wgpu::BufferBindingType::ReadOnlyStorage; // Meshlets
+        entries[2].buffer.type = wgpu::BufferBindingType::ReadOnlyStorage; // 16-bit indices
+        entries[3].buffer.type = wgpu::BufferBindingType::ReadOnlyStorage; // 32-bit indices
+        entries[4].buffer.type = wgpu::BufferBindingType::Storage;         // Indirect draws
+        entries[5].buffer.type = wgpu::BufferBindingType::Storage;         // Culled indices
+
+        wgpu::BindGroupLayoutDescriptor layoutDescriptor{};
+        layoutDescriptor.entryCount = 6;
+        layoutDescriptor.entries = entries;
+        _meshletCullBindGroupLayout = _device.CreateBindGroupLayout(&layoutDescriptor);
+    }
+
+    const std::string shader =
+        shader_utils::LoadShaderFile(GFX_WEBGPU_SHADER_PATH "/meshlet_cull.wgsl");
+    wgpu::ShaderSourceWGSL wgsl{{.nextInChain = nullptr, .code = shader.c_str()}};
+    wgpu::ShaderModuleDescriptor shaderModuleDescriptor{.nextInChain = &wgsl};
+    wgpu::ShaderModule shaderModule = _device.CreateShaderModule(&shaderModuleDescriptor);
+
+    wgpu::PipelineLayoutDescriptor pipelineLayoutDescriptor{};
+    pipelineLayoutDescriptor.bindGroupLayoutCount = 1;
+    pipelineLayoutDescriptor.bindGroupLayouts = &_meshletCullBindGroupLayout;
+    wgpu::PipelineLayout pipelineLayout = _device.CreatePipelineLayout(&pipelineLayoutDescriptor);
+
+    wgpu::ComputePipelineDescriptor descriptor{};
+    descriptor.layout = pipelineLayout;
+    descriptor.compute.module = shaderModule;
+    descriptor.compute.entryPoint = "cullMeshlets";
+    _meshletCullPipeline = _device.CreateComputePipeline(&descriptor);
+}
+
+void WebgpuRenderer::CreateDrawCullPipeline() {
+    if (!_options.gpuDrivenDraws) {
+        return;
+    }
+
+    if (!_drawCullBindGroupLayout) {
+        wgpu::BindGroupLayoutEntry entries[5]{};
+        for (uint32_t i = 0; i < 5; ++i) {
+            entries[i].binding = i;
+            entries[i].visibility = wgpu::ShaderStage::Compute;
+        }
+        entries[0].buffer.type = wgpu::BufferBindingType::Uniform;
+        entries[0].buffer.minBindingSize = sizeof(DrawCullUniforms);
+        entries[1].buffer.type = wgpu::BufferBindingType::ReadOnlyStorage; // Draw records
+        entries[2].buffer.type = wgpu::BufferBindingType::Storage;         // Indirect arguments
+        entries[3].buffer.type = wgpu::BufferBindingType::Storage;         // Draw counts
+        entries[4].buffer.type = wgpu::BufferBindingType::Storage;         // Visibility
+
+        wgpu::BindGroupLayoutDescriptor layoutDescriptor{};
+        layoutDescriptor.entryCount = _options.occlusionCulling ? 5 : 4;
+        layoutDescriptor.entries = entries;
+        _drawCullBindGroupLayout = _device.CreateBindGroupLayout(&layoutDescriptor);
+    }
+    if (_options.occlusionCulling && !_hiZCullBindGroupLayout) {
+        wgpu::BindGroupLayoutEntry entry{};
+        entry.binding = 0;
+        entry.visibility = wgpu::ShaderStage::Compute;
+        entry.texture.sampleType = wgpu::TextureSampleType::UnfilterableFloat;
+        entry.texture.viewDimension = wgpu::TextureViewDimension::e2D;
+
+        wgpu::BindGroupLayoutDescriptor layoutDescriptor{};
+        layoutDescriptor.entryCount = 1;
+        layoutDescriptor.entries = &entry;
+        _hiZCullBindGroupLayout = _device.CreateBindGroupLayout(&layoutDescriptor);
+    }
+
+    const std::string shader =
+        shader_utils::LoadShaderFile(GFX_WEBGPU_SHADER_PATH "/draw_cull.wgsl");
+    wgpu::ShaderSourceWGSL wgsl{{.nextInChain = nullptr, .code = shader.c_str()}};
+    wgpu::ShaderModuleDescriptor shaderModuleDescriptor{.nextInChain = &wgsl};
+    wgpu::ShaderModule shaderModule = _device.CreateShaderModule(&shaderModuleDescriptor);
+
+    wgpu::PipelineLayoutDescriptor pipelineLayoutDescriptor{};
+    pipelineLayoutDescriptor.bindGroupLayoutCount = 1;
+    pipelineLayoutDescriptor.bindGroupLayouts = &_drawCullBindGroupLayout;
+    wgpu::PipelineLayout pipelineLayout = _device.CreatePipelineLayout(&pipelineLayoutDescriptor);
+
+    // With occlusion culling this pipeline only draws what was visible last frame (phase 0).
+    wgpu::ComputePipelineDescriptor descriptor{};
+    descriptor.layout = pipelineLayout;
+    descriptor.compute.module = shaderModule;
+    descriptor.compute.entryPoint = _options.occlusionCulling ? "cullVisibleDraws" : "cullDraws";
+    _drawCullPipeline = _device.CreateComputePipeline(&descriptor);
+
+    if (_options.occlusionCulling) {
+        const wgpu::BindGroupLayout layouts[2] = {_drawCullBindGroupLayout,
+                                                  _hiZCullBindGroupLayout};
+        pipelineLayoutDescriptor.bindGroupLayoutCount = 2;
+        pipelineLayoutDescriptor.bindGroupLayouts = layouts;
+        descriptor.layout = _device.CreatePipelineLayout(&pipelineLayoutDescriptor);
+        descriptor.compute.entryPoint = "cullOccludedDraws";
+        _occlusionCullPipeline = _device.CreateComputePipeline(&descriptor);
+    }
+}
+
+void WebgpuRenderer::CreateHiZPipelines() {
+    if (!_options.occlusionCulling) {
+        return;
+    }
+
+    // Level 0 reads the depth buffer (binding 0); the others read the level above (binding 1).
+    if (!_hiZCopyBindGroupLayout) {
+        wgpu::BindGroupLayoutEntry entries[2]{};
+        entries[0].binding = 0;
+        entries[0].visibility = wgpu::ShaderStage::Compute;
+        entries[0].texture.sampleType = wgpu::TextureSampleType::Depth;
+        entries[0].texture.viewDimension = wgpu::TextureViewDimension::e2D;
+        entries[1].binding = 2;
+        entries[1].visibility = wgpu::ShaderStage::Compute;
+        entries[1].storageTexture.access = wgpu::StorageTextureAccess::WriteOnly;
+        entries[1].storageTexture.format = wgpu::TextureFormat::R32Float;
+        entries[1].storageTexture.viewDimension = wgpu::TextureViewDimension::e2D;
+
+        wgpu::BindGroupLayoutDescriptor layoutDescriptor{};
+        layoutDescriptor.entryCount = 2;
+        layoutDescriptor.entries = entries;
+        _hiZCopyBindGroupLayout = _device.CreateBindGroupLayout(&layoutDescriptor);
+
+        entries[0].binding = 1;
+        entries[0].texture.sampleType = wgpu::TextureSampleType::UnfilterableFloat;
+        _hiZDownsampleBindGroupLayout = _device.CreateBindGroupLayout(&layoutDescriptor);
+    }
+
+    const std::string shader =
+        shader_utils::LoadShaderFile(GFX_WEBGPU_SHADER_PATH "/hiz_build.wgsl");
+    wgpu::ShaderSourceWGSL wgsl{{.nextInChain = nullptr, .code = shader.c_str()}};
+    wgpu::ShaderModuleDescriptor shaderModuleDescriptor{.nextInChain = &wgsl};
+    wgpu::ShaderModule shaderModule = _device.CreateShaderModule(&shaderModuleDescriptor);
+
+    wgpu::PipelineLayoutDescriptor pipelineLayoutDescriptor{};
+    pipelineLayoutDescriptor.bindGroupLayoutCount = 1;
+    pipelineLayoutDescriptor.bindGroupLayouts = &_hiZCopyBindGroupLayout;
+
+    wgpu::ComputePipelineDescriptor descriptor{};
+    descriptor.layout = _device.CreatePipelineLayout(&pipelineLayoutDescriptor);
+    descriptor.compute.module = shaderModule;
+    descriptor.compute.entryPoint = "copyDepth";
+    _hiZCopyPipeline = _device.CreateComputePipeline(&descriptor);
+
+    pipelineLayoutDescriptor.bindGroupLayouts = &_hiZDownsampleBindGroupLayout;
+    descriptor.layout = _device.CreatePipelineLayout(&pipelineLayoutDescriptor);
+    descriptor.compute.entryPoint = "downsample";
+    _hiZDownsamplePipeline = _device.CreateComputePipeline(&descriptor);
+}
+
+void WebgpuRenderer::CreateHiZResources() {
+    _hiZBindGroups.clear();
+    _hiZCullBindGroup = nullptr;
+    _hiZTexture = nullptr;
+    if (!_options.occlusionCulling) {
+        return;
+    }
+
+    // Level 0 matches the depth buffer, so a pixel's texel at any level is (p >> level) clamped.
+    const uint32_t width = _depthTexture.GetWidth();
+    const uint32_t height = _depthTexture.GetHeight();
+    wgpu::TextureDescriptor textureDescriptor{};
+    textureDescriptor.size = {width, height, 1};
+    textureDescriptor.format = wgpu::TextureFormat::R32Float;
+    textureDescriptor.mipLevelCount = 1 + static_cast<uint32_t>(std::log2(std::max(width, height)));
+    textureDescriptor.usage =
+        wgpu::TextureUsage::StorageBinding | wgpu::TextureUsage::TextureBinding;
+    _hiZTexture = _device.CreateTexture(&textureDescriptor);
+
+    wgpu::TextureViewDescriptor viewDescriptor{};
+    viewDescriptor.mipLevelCount = 1;
+    std::vector<wgpu::TextureView> levelViews(textureDescriptor.mipLevelCount);
+    for (uint32_t level = 0; level < levelViews.size(); ++level) {
+        viewDescriptor.baseMipLevel = level;
+        levelViews[level] = _hiZTexture.CreateView(&viewDescriptor);
+    }
+
+    for (uint32_t level = 0; level < levelViews.size(); ++level) {
+        wgpu::BindGroupEntry entries[2]{};
+        entries[0].binding = level == 0 ? 0 : 1;
+        entries[0].textureView = level == 0 ? _depthSampleView : levelViews[level - 1];
+        entries[1].binding = 2;
+        entries[1].textureView = levelViews[level];
+
+        wgpu::BindGroupDescriptor bindGroupDescriptor{};
+        bindGroupDescriptor.layout =
+            level == 0 ? _hiZCopyBindGroupLayout : _hiZDownsampleBindGroupLayout;
+        bindGroupDescriptor.entryCount = 2;
+        bindGroupDescriptor.entries = entries;
+        _hiZBindGroups.push_back(_device.CreateBindGroup(&bindGroupDescriptor));
+    }
+
+    wgpu::BindGroupEntry entry{};
+    entry.binding = 0;
+    entry.textureView = _hiZTexture.CreateView();
+
+    wgpu::BindGroupDescriptor bindGroupDescriptor{};
+    bindGroupDescriptor.layout = _hiZCullBindGroupLayout;
+    bindGroupDescriptor.entryCount = 1;
+    bindGroupDescriptor.entries = &entry;
+    _hiZCullBindGroup = _device.CreateBindGroup(&bindGroupDescriptor);
+}
+
 void WebgpuRenderer::CreateEnvironmentRenderPipeline() {
     wgpu::ColorTargetState colorTargetState{};
     colorTargetState.format = _surfaceFormat;
@@ -1238,11 +3039,24 @@ void WebgpuRenderer::SortTransparentMeshes(const glm::mat4& modelMatrix,
 
     for (uint32_t i = 0; i < _transparentMeshes.size(); ++i) {
         SubMesh& subMesh = _transparentMeshes[i];
+        if (!subMesh._visible) {
+            continue;
+        }
 
-        glm::vec4 centroid = modelView * glm::vec4(subMesh._centroid, 1.0f);
-        float depth = centroid.z;
+        // An instanced draw sorts by its nearest instance in front of the camera.
+        bool inFront = false;
+        float depth = std::numeric_limits<float>::lowest();
+        for (uint32_t j = 0; j < subMesh._instanceCount; ++j) {
+            const glm::mat4& instanceMatrix = _instances[subMesh._firstInstance + j].modelMatrix;
+            const glm::vec4 centroid =
+                modelView * instanceMatrix * glm::vec4(subMesh._centroid, 1.0f);
+            if (centroid.z < 0.0f) {
+                inFront = true;
+                depth = std::max(depth, centroid.z);
+            }
+        }
 
-        if (depth < 0.0f) {
+        if (inFront) {
             SubMeshDepthInfo subMeshDepthInfo = {._depth = depth, ._meshIndex = i};
             _transparentMeshesDepthSorted.push_back(subMeshDepthInfo);
         }
@@ -1251,4 +3065,5 @@ void WebgpuRenderer::SortTransparentMeshes(const glm::mat4& modelMatrix,
     std::sort(
         _transparentMeshesDepthSorted.begin(), _transparentMeshesDepthSorted.end(),
         [](const SubMeshDepthInfo& a, const SubMeshDepthInfo& b) { return a._depth < b._depth; });
+    _frameStats.drawCalls += static_cast<uint32_t>(_transparentMeshesDepthSorted.size());
 }
\ No newline at end of file
@@ -19,6 +19,9 @@
 // Forward Declarations
 class Environment;
 class Model;
+namespace mesh_utils {
+struct IndexBuffers;
+}
 
 // WebgpuRenderer Class
 class WebgpuRenderer final : public IRenderer {
@@ -33,6 +36,7 @@ class WebgpuRenderer final : public IRenderer {
     WebgpuRenderer& operator=(WebgpuRenderer&&) = delete;
 
     // IRenderer interface implementation
+    void SetOptions(const RendererOptions& options) override;
     void Initialize(GLFWwindow* window, const Environment& environment,
                     const Model& model) override;
     void Shutdown() override;
@@ -41,6 +45,7 @@ class WebgpuRenderer final : public IRenderer {
     void ReloadShaders() override;
     void UpdateModel(const Model& model) override;
     void UpdateEnvironment(const Environment& environment) override;
+    FrameStats GetFrameStats() const override;
 
   private:
     // Private utility methods
@@ -51,18 +56,50 @@ class WebgpuRenderer final : public IRenderer {
     void CreateBindGroupLayouts();
     void CreateSamplers();
     void CreateVertexBuffer(const Model& model);
-    void CreateIndexBuffer(const Model& model);
+    void CreateIndexBuffer(const Model& model, const mesh_utils::IndexBuffers& indexBuffers);
+    void CreateInstanceBuffer(const Model& model);
     void CreateUniformBuffers();
     void CreateEnvironmentTextures(const Environment& environment);
-    void CreateSubMeshes(const Model& model);
+    void CreateSubMeshes(const Model& model, const mesh_utils::IndexBuffers& indexBuffers);
     void CreateMaterials(const Model& model);
     void CreateGlobalBindGroup();
     void CreateEnvironmentRenderPipeline();
     void CreateModelRenderPipelines();
+    void CreateMeshletCullPipeline();
+    void CreateMeshletCullResources(const Model& model,
+                                    const mesh_utils::IndexBuffers& indexBuffers);
+    void CreateDrawCullPipeline();
+    void CreateDrawCullResources();
+    void CreateHiZPipelines();
+    void CreateHiZResources();
     void CreateRenderPassDescriptor();
     void CreateDefaultTextures();
     void UpdateUniforms(const glm::mat4& modelMatrix, const CameraUniformsInput& camera) const;
+    void CullSubMeshes(const glm::mat4& modelMatrix, const CameraUniformsInput& camera);
     void SortTransparentMeshes(const glm::mat4& modelMatrix, const glm::mat4& viewMatrix);
+    void SelectLods(const glm::mat4& modelMatrix, const CameraUniformsInput& camera);
+    void BuildOpaqueDrawQueue(const glm::mat4& modelMatrix, const glm::mat4& viewMatrix);
+    uint32_t SortOpaqueDrawQueue(); // Returns the material binds the sorted queue needs
+    void RecordOpaqueBundles();
+    wgpu::RenderBundle RecordOpaqueBundle(bool depthOnly, uint32_t phase) const;
+    void EncodeDepthPrepass(wgpu::CommandEncoder& encoder);
+    void EncodeMeshletCulling(wgpu::CommandEncoder& encoder, const glm::mat4& modelMatrix,
+                              const CameraUniformsInput& camera);
+    void ReadBackMeshletCullingStats();
+    void EncodeDrawCulling(wgpu::CommandEncoder& encoder, const glm::mat4& modelMatrix,
+                           const CameraUniformsInput& camera);
+    void EncodeOcclusionCulling(wgpu::CommandEncoder& encoder);
+    void ReadBackDrawCullingStats();
+    // Replays the matching opaque bundle when there is one, else encodes the draws directly.
+    // `phase` picks the GPU-driven draws to replay: 0, or 1 for those found by occlusion culling.
+    void EncodeOpaqueMeshes(const wgpu::RenderPassEncoder& pass, bool depthOnly,
+                            uint32_t phase = 0) const;
+
+    // `Encoder` is a wgpu::RenderPassEncoder, or a wgpu::RenderBundleEncoder while recording.
+    template <typename Encoder>
+    void BindModelVertexBuffers(const Encoder& pass) const;
+    template <typename Encoder>
+    void DrawOpaqueMeshes(const Encoder& pass, bool depthOnly, uint32_t phase) const;
 
     // Types
     struct GlobalUniforms {
@@ -79,6 +116,13 @@ class WebgpuRenderer final : public IRenderer {
         alignas(16) glm::mat4 normalMatrix;
     };
 
+    // Mirror of InstanceData in gltf_pbr.wgsl: a placement of a submesh, applied before the
+    // model matrix.
+    struct InstanceData {
+        alignas(16) glm::mat4 modelMatrix;
+        alignas(16) glm::mat4 normalMatrix;
+    };
+
     struct MaterialUniforms {
         alignas(16) glm::vec4 baseColorFactor;
         alignas(16) glm::vec3 emissiveFactor;
@@ -102,10 +146,87 @@ class WebgpuRenderer final : public IRenderer {
     };
 
     struct SubMesh {
-        uint32_t _firstIndex{0};   // First index in the index buffer
+        uint32_t _firstIndex{0};   // First index in the index buffer of its format
         uint32_t _indexCount{0};   // Number of indices in the submesh
+        int32_t _baseVertex{0};    // Added to every index (the submesh's first vertex)
         int _materialIndex{-1};    // Material index for the submesh
         glm::vec3 _centroid{0.0f}; // Centroid of the submesh
+        uint32_t _modelIndex{0};   // Index in Model::GetSubMeshes()
+        wgpu::IndexFormat _indexFormat{wgpu::IndexFormat::Uint32};
+        float _radius{0.0f};       // Bounding sphere around _centroid
+        uint32_t _firstLod{0};     // First coarser level in _lods
+        uint32_t _lodCount{0};
+        uint32_t _lod{0};          // Level drawn this frame (0 = full detail)
+        uint32_t _firstInstance{0}; // First record in _instances (the draw's firstInstance)
+        uint32_t _instanceCount{1};
+        bool _visible{true};        // Some instance passed this frame's frustum test
+    };
+
+    // A coarser index range of a submesh, in the submesh's index buffer.
+    struct SubMeshLod {
+        uint32_t _firstIndex{0};
+        uint32_t _indexCount{0};
+        float _error{0.0f}; // Model units
+    };
+
+    // GPU mirrors of the structs in meshlet_cull.wgsl.
+    struct MeshletCullData {
+        glm::vec4 sphere;   // xyz = center, w = radius (model space)
+        glm::vec4 coneApex; // xyz = apex, w = cutoff
+        glm::vec3 coneAxis;
+        uint32_t drawIndex; // Index in _opaqueMeshes
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        uint32_t is16Bit;
+        uint32_t _pad;
+    };
+
+    struct MeshletCullUniforms {
+        alignas(16) glm::vec4 frustumPlanes[6];
+        alignas(16) glm::vec3 cameraPosition;
+        uint32_t meshletCount;
+    };
+
+    struct DrawIndexedIndirectArgs {
+        uint32_t indexCount;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t baseVertex;
+        uint32_t firstInstance;
+    };
+
+    // GPU mirrors of the structs in draw_cull.wgsl.
+    struct DrawCullRecord {
+        glm::vec3 boundsMin; // Model space, union over the draw's instances
+        uint32_t firstSlot;  // First argument slot of the draw's group
+        glm::vec3 boundsMax;
+        uint32_t group;
+        uint32_t indexCount;
+        uint32_t firstIndex;
+        int32_t baseVertex;
+        uint32_t firstInstance;
+        uint32_t instanceCount;
+        uint32_t _pad[3];
+    };
+
+    struct DrawCullUniforms {
+        alignas(16) glm::vec4 frustumPlanes[6];
+        uint32_t drawCount;
+        uint32_t groupCount;
+        uint32_t hiZLevelCount;
+        uint32_t _pad0;
+        alignas(16) glm::mat4 modelViewProjection;
+        glm::vec2 hiZSize;
+        glm::vec2 _pad1;
+    };
+
+    // Opaque draws sharing a material and an index format. The culling pass compacts the visible
+    // ones to the front of the group's argument slots and counts them.
+    struct DrawGroup {
+        uint32_t _firstSlot{0};
+        uint32_t _drawCount{0};
+        int _materialIndex{-1};
+        wgpu::IndexFormat _indexFormat{wgpu::IndexFormat::Uint32};
     };
 
     struct SubMeshDepthInfo {
@@ -113,6 +234,18 @@ class WebgpuRenderer final : public IRenderer {
         uint32_t _meshIndex{0};
     };
 
+    // A visible opaque submesh, sorted by _key: alpha mode, material, index format, then depth.
+    struct OpaqueDraw {
+        uint64_t _key{0};
+        uint32_t _meshIndex{0};
+    };
+    OpaqueDraw MakeOpaqueDraw(uint32_t meshIndex, float depth) const;
+
+    // Binds the submesh's index buffer unless `boundIndexFormat` says it already is, then draws.
+    template <typename Encoder>
+    void DrawSubMesh(const Encoder& pass, const SubMesh& subMesh,
+                     wgpu::IndexFormat& boundIndexFormat) const;
+
     // WebGPU resources
     wgpu::Instance _instance;
     wgpu::Adapter _adapter;
@@ -121,6 +254,7 @@ class WebgpuRenderer final : public IRenderer {
     wgpu::TextureFormat _surfaceFormat{wgpu::TextureFormat::Undefined};
     wgpu::Texture _depthTexture;
     wgpu::TextureView _depthTextureView;
+    wgpu::TextureView _depthSampleView; // Depth aspect, read by the Hi-Z pyramid build
     wgpu::RenderPassDescriptor _renderPassDescriptor{};
     wgpu::RenderPassColorAttachment _colorAttachment{};
     wgpu::RenderPassDepthStencilAttachment _depthAttachment{};
@@ -147,12 +281,67 @@ class WebgpuRenderer final : public IRenderer {
     // Model related data. TODO: Move to separate class
     wgpu::ShaderModule _modelShaderModule;
     wgpu::BindGroupLayout _modelBindGroupLayout;
+    wgpu::RenderPipeline _modelPipelineDepth; // Position-only, for the depth prepass
     wgpu::RenderPipeline _modelPipelineOpaque;
     wgpu::RenderPipeline _modelPipelineTransparent;
-    wgpu::Buffer _vertexBuffer;
-    wgpu::Buffer _indexBuffer;
+    wgpu::Buffer _vertexBuffer;          // Interleaved vertices, or positions when split
+    wgpu::Buffer _vertexAttributeBuffer; // Shading attributes when the streams are split
+    wgpu::Buffer _dequantizationBuffer;  // Per-submesh position decode for packed vertices
+    wgpu::Buffer _indexBuffer16; // Submeshes whose local indices fit in 16 bits
+    wgpu::Buffer _indexBuffer32;
     wgpu::Buffer _modelUniformBuffer;
+    wgpu::Buffer _instanceBuffer;         // _instances, read by the vertex shaders
+    std::vector<InstanceData> _instances; // Per submesh instances, in Model::GetSubMeshes() order
     wgpu::Sampler _modelTextureSampler;
+    std::vector<SubMeshLod> _lods;
+
+    // Meshlet culling: a compute pass compacts the visible opaque meshlets' indices into
+    // _culledIndexBuffer and draws each opaque submesh through _culledDrawBuffer.
+    wgpu::ComputePipeline _meshletCullPipeline;
+    wgpu::BindGroupLayout _meshletCullBindGroupLayout;
+    wgpu::BindGroup _meshletCullBindGroup;
+    wgpu::Buffer _meshletCullUniformBuffer;
+    wgpu::Buffer _meshletBuffer;
+    wgpu::Buffer _culledIndexBuffer;
+    wgpu::Buffer _culledDrawBuffer;         // One DrawIndexedIndirectArgs per opaque submesh
+    wgpu::Buffer _culledDrawReadbackBuffer; // Periodic copy for the rejection statistics
+    std::vector<DrawIndexedIndirectArgs> _culledDrawReset; // Zero counts, uploaded every frame
+    uint32_t _meshletCount{0};
+    uint64_t _meshletTriangleCount{0};
+    uint32_t _frameCount{0};
+    bool _meshletStatsPending{false};
+
+    // GPU-driven drawing: a compute pass frustum-culls one DrawCullRecord per opaque submesh and
+    // writes the survivors' arguments to _drawArgsBuffer, which the passes replay per group.
+    wgpu::ComputePipeline _drawCullPipeline;
+    wgpu::BindGroupLayout _drawCullBindGroupLayout;
+    wgpu::BindGroup _drawCullBindGroup;
+    wgpu::Buffer _drawCullUniformBuffer;
+    wgpu::Buffer _drawRecordBuffer;
+    wgpu::Buffer _drawArgsBuffer;          // One DrawIndexedIndirectArgs slot per record and phase
+    wgpu::Buffer _drawCountBuffer;         // Visible draws per group and phase
+    wgpu::Buffer _drawCountReadbackBuffer; // Periodic copy for the statistics
+    std::vector<DrawGroup> _drawGroups;
+    std::vector<DrawIndexedIndirectArgs> _drawArgsReset; // Zeros, uploaded every frame
+    uint32_t _drawRecordCount{0};
+    bool _multiDrawIndirect{false}; // One MultiDrawIndexedIndirect per group
+    bool _drawStatsPending{false};
+
+    // Occlusion culling: phase 0 draws what was visible last frame, the Hi-Z pyramid is reduced
+    // from its depth, and phase 1 draws what the pyramid test finds newly visible.
+    wgpu::ComputePipeline _occlusionCullPipeline; // Phase 1; _drawCullPipeline runs phase 0
+    wgpu::ComputePipeline _hiZCopyPipeline;
+    wgpu::ComputePipeline _hiZDownsamplePipeline;
+    wgpu::BindGroupLayout _hiZCopyBindGroupLayout;
+    wgpu::BindGroupLayout _hiZDownsampleBindGroupLayout;
+    wgpu::BindGroupLayout _hiZCullBindGroupLayout;
+    std::vector<wgpu::BindGroup> _hiZBindGroups; // One per level; level 0 copies the depth
+    wgpu::BindGroup _hiZCullBindGroup;
+    wgpu::Texture _hiZTexture; // Farthest depth per texel, R32Float with a full mip chain
+    wgpu::Buffer _drawVisibilityBuffer; // Per record, 1 if drawn last frame
+    uint32_t _drawPhaseCount{1};        // 2 with occlusion culling
+    uint32_t _occludedDraws{0};         // From the last statistics read
+    uint32_t _occludedTriangles{0};
 
     // Default textures
     wgpu::Texture _defaultSRGBTexture;
@@ -164,6 +353,12 @@ class WebgpuRenderer final : public IRenderer {
     wgpu::Texture _defaultCubeTexture;
     wgpu::TextureView _defaultCubeTextureView;
 
+    // Frustum culling: model-space bounds of every record in _instances, structure-of-arrays
+    // (min x, y, z, then max x, y, z), tested against the frustum before draws are encoded.
+    std::vector<float> _recordBounds[6];
+    std::vector<uint8_t> _recordVisible;
+    FrameStats _frameStats;
+
     // Meshes and materials
     std::vector<SubMesh> _opaqueMeshes;
     std::vector<SubMesh> _transparentMeshes;
@@ -172,6 +367,19 @@ class WebgpuRenderer final : public IRenderer {
     // Per-frame sorted transparent meshes
     std::vector<SubMeshDepthInfo> _transparentMeshesDepthSorted;
 
+    // Per-frame opaque draw queue, and the radix sort's second buffer
+    std::vector<OpaqueDraw> _opaqueDrawQueue;
+    std::vector<OpaqueDraw> _opaqueDrawScratch;
+
+    // Opaque draws recorded once with RendererOptions::renderBundles. Re-recorded when the model,
+    // the environment (global bind group) or the pipelines change.
+    wgpu::RenderBundle _opaqueBundles[2]; // Main pass, per draw phase
+    wgpu::RenderBundle _depthPrepassBundle;
+    uint32_t _opaqueBundleMaterialBinds{0};
+
+    // Options applied at initialization
+    RendererOptions _options;
+
     // Window reference for querying framebuffer size
     GLFWwindow* _window{nullptr};
 
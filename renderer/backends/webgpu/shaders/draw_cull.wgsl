@@ -0,0 +1,190 @@
+//=========================================================
+// Draw culling (compute path for GPU-driven drawing)
+// - One invocation per opaque draw: frustum test on its model-space bounding box
+// - Visible draws append their DrawIndexedIndirect arguments to their group's region and grow
+//   the group's draw count; each group shares a material and an index format
+// - With occlusion culling the arguments and counts hold two phases. cullVisibleDraws fills
+//   phase 0 with the draws visible last frame; after they are drawn and the Hi-Z pyramid is built
+//   from their depth, cullOccludedDraws tests every draw in the frustum against it, remembers the
+//   result for the next frame and fills phase 1 with the visible draws phase 0 missed
+//=========================================================
+
+
+//=========================================================
+// Uniforms & Bind Group Declarations
+//=========================================================
+
+struct CullUniforms {
+    frustumPlanes: array<vec4<f32>, 6>, // Model space, xyz pointing inwards
+    drawCount: u32,
+    groupCount: u32,
+    hiZLevelCount: u32,
+    _pad0: u32,
+    modelViewProjection: mat4x4<f32>,   // Occlusion culling only
+    hiZSize: vec2<f32>,                 // Level 0 size in pixels
+    _pad1: vec2<f32>
+};
+
+struct DrawRecord {
+    boundsMin: vec3<f32>, // Union of the boxes of the draw's instances
+    firstSlot: u32,       // First argument slot of the draw's group
+    boundsMax: vec3<f32>,
+    group: u32,           // Index into drawCounts
+    indexCount: u32,
+    firstIndex: u32,
+    baseVertex: i32,
+    firstInstance: u32,
+    instanceCount: u32,
+    _pad0: u32,
+    _pad1: u32,
+    _pad2: u32
+};
+
+struct DrawIndexedIndirectArgs {
+    indexCount: u32,
+    instanceCount: u32,
+    firstIndex: u32,
+    baseVertex: i32,
+    firstInstance: u32
+};
+
+@group(0) @binding(0) var<uniform> cullUniforms: CullUniforms;
+@group(0) @binding(1) var<storage, read> records: array<DrawRecord>;
+@group(0) @binding(2) var<storage, read_write> draws: array<DrawIndexedIndirectArgs>;
+@group(0) @binding(3) var<storage, read_write> drawCounts: array<atomic<u32>>;
+
+// Occlusion culling only. drawCounts also ends with the occluded draw and triangle totals.
+@group(0) @binding(4) var<storage, read_write> drawVisibility: array<u32>; // 1 if drawn last frame
+@group(1) @binding(0) var hiZTexture: texture_2d<f32>; // Farthest depth per texel, all levels
+
+
+//=========================================================
+// Constants
+//=========================================================
+
+const WORKGROUP_SIZE: u32 = 64u;
+
+
+//=========================================================
+// Utility Functions
+//=========================================================
+
+// A box is outside a plane exactly when its corner furthest along the normal is.
+fn isDrawVisible(record: DrawRecord) -> bool {
+    for (var i = 0u; i < 6u; i++) {
+        let plane = cullUniforms.frustumPlanes[i];
+        let corner = select(record.boundsMin, record.boundsMax, plane.xyz >= vec3<f32>(0.0));
+        if (dot(plane.xyz, corner) + plane.w < 0.0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Projects the box and compares its nearest depth with the farthest depth under it, read from
+// the level where the box spans at most 2x2 texels. Boxes reaching behind the eye are kept.
+fn isDrawOccluded(record: DrawRecord) -> bool {
+    var rectMin = vec2<f32>(1.0);
+    var rectMax = vec2<f32>(0.0);
+    var nearestDepth = 1.0;
+    for (var i = 0u; i < 8u; i++) {
+        let useMax = vec3<bool>((i & 1u) != 0u, (i & 2u) != 0u, (i & 4u) != 0u);
+        let corner = select(record.boundsMin, record.boundsMax, useMax);
+        let clip = cullUniforms.modelViewProjection * vec4<f32>(corner, 1.0);
+        if (clip.w <= 0.0) {
+            return false;
+        }
+        let ndc = clip.xyz / clip.w;
+        let uv = vec2<f32>(ndc.x * 0.5 + 0.5, 0.5 - ndc.y * 0.5);
+        rectMin = min(rectMin, uv);
+        rectMax = max(rectMax, uv);
+        nearestDepth = min(nearestDepth, ndc.z);
+    }
+
+    let pixelMin = clamp(rectMin, vec2<f32>(0.0), vec2<f32>(1.0)) * cullUniforms.hiZSize;
+    let pixelMax = clamp(rectMax, vec2<f32>(0.0), vec2<f32>(1.0)) * cullUniforms.hiZSize;
+    let extent = max(max(pixelMax.x - pixelMin.x, pixelMax.y - pixelMin.y), 1.0);
+    let level = min(u32(ceil(log2(extent))), cullUniforms.hiZLevelCount - 1u);
+
+    let lastTexel = textureDimensions(hiZTexture, level) - 1u;
+    let lastPixel = vec2<u32>(cullUniforms.hiZSize) - 1u;
+    let texelMin = min(min(vec2<u32>(pixelMin), lastPixel) >> vec2<u32>(level), lastTexel);
+    let texelMax = min(min(vec2<u32>(pixelMax), lastPixel) >> vec2<u32>(level), lastTexel);
+
+    let farthestDepth =
+        max(max(textureLoad(hiZTexture, texelMin, level).r,
+                textureLoad(hiZTexture, vec2<u32>(texelMax.x, texelMin.y), level).r),
+            max(textureLoad(hiZTexture, vec2<u32>(texelMin.x, texelMax.y), level).r,
+                textureLoad(hiZTexture, texelMax, level).r));
+    return nearestDepth > farthestDepth;
+}
+
+fn appendDraw(record: DrawRecord, phase: u32) {
+    let count = atomicAdd(&drawCounts[phase * cullUniforms.groupCount + record.group], 1u);
+    let slot = phase * cullUniforms.drawCount + record.firstSlot + count;
+    draws[slot] = DrawIndexedIndirectArgs(record.indexCount, record.instanceCount,
+                                          record.firstIndex, record.baseVertex,
+                                          record.firstInstance);
+}
+
+
+//=========================================================
+// Compute Shader Entry Points
+//=========================================================
+
+@compute @workgroup_size(WORKGROUP_SIZE)
+fn cullDraws(@builtin(global_invocation_id) invocationId: vec3<u32>) {
+    let drawIndex = invocationId.x;
+    if (drawIndex >= cullUniforms.drawCount) {
+        return;
+    }
+
+    let record = records[drawIndex];
+    if (isDrawVisible(record)) {
+        appendDraw(record, 0u);
+    }
+}
+
+@compute @workgroup_size(WORKGROUP_SIZE)
+fn cullVisibleDraws(@builtin(global_invocation_id) invocationId: vec3<u32>) {
+    let drawIndex = invocationId.x;
+    if (drawIndex >= cullUniforms.drawCount || drawVisibility[drawIndex] == 0u) {
+        return;
+    }
+
+    let record = records[drawIndex];
+    if (isDrawVisible(record)) {
+        appendDraw(record, 0u);
+    }
+}
+
+@compute @workgroup_size(WORKGROUP_SIZE)
+fn cullOccludedDraws(@builtin(global_invocation_id) invocationId: vec3<u32>) {
+    let drawIndex = invocationId.x;
+    if (drawIndex >= cullUniforms.drawCount) {
+        return;
+    }
+
+    // Draws outside the frustum were skipped by phase 0 too; they are tested again on entry.
+    let record = records[drawIndex];
+    if (!isDrawVisible(record)) {
+        drawVisibility[drawIndex] = 0u;
+        return;
+    }
+
+    let drawnInPhase0 = drawVisibility[drawIndex] != 0u;
+    if (isDrawOccluded(record)) {
+        drawVisibility[drawIndex] = 0u;
+        if (!drawnInPhase0) {
+            let statsIndex = 2u * cullUniforms.groupCount;
+            atomicAdd(&drawCounts[statsIndex], 1u);
+            atomicAdd(&drawCounts[statsIndex + 1u], record.indexCount / 3u * record.instanceCount);
+        }
+        return;
+    }
+
+    drawVisibility[drawIndex] = 1u;
+    if (!drawnInPhase0) {
+        appendDraw(record, 1u);
+    }
+}
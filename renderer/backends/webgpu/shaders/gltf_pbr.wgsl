@@ -1,7 +1,7 @@
 //=========================================================
 // glTF PBR (metallic-roughness) shading
 // - Vertex + fragment with IBL (irradiance, prefiltered specular, BRDF LUT)
-// - Inputs: GlobalUniforms, ModelUniforms, MaterialUniforms, PBR textures
+// - Inputs: GlobalUniforms, ModelUniforms, per-instance transforms, MaterialUniforms, PBR textures
 // - Output: tone-mapped sRGB color
 //=========================================================
 
@@ -22,6 +22,13 @@ struct ModelUniforms {
     normalMatrix: mat4x4<f32>
 };
 
+// One record per drawn instance, selected with @builtin(instance_index): the draw's firstInstance
+// points at the submesh's first record.
+struct InstanceData {
+    modelMatrix: mat4x4<f32>,
+    normalMatrix: mat4x4<f32>
+};
+
 struct MaterialUniforms {
     baseColorFactor: vec4<f32>,
     emissiveFactor: vec3<f32>,
@@ -49,6 +56,7 @@ struct MaterialUniforms {
 @group(1) @binding(5) var normalTexture: texture_2d<f32>;
 @group(1) @binding(6) var occlusionTexture: texture_2d<f32>;
 @group(1) @binding(7) var emissiveTexture: texture_2d<f32>;
+@group(1) @binding(8) var<storage, read> instances: array<InstanceData>;
 
 
 //=========================================================
@@ -75,17 +83,45 @@ struct VertexInput {
     @location(2) tangent: vec4<f32>,
     @location(3) texCoord0: vec2<f32>,
     @location(4) texCoord1: vec2<f32>,
-    @location(5) color: vec4<f32>
+    @location(5) color: vec4<f32>,
+    @builtin(instance_index) instance: u32
+};
+
+// Quantized layout (vertex_packing::PackedVertex) plus the per-submesh position decode, bound as
+// an instance-rate buffer and selected with the draw's firstInstance.
+struct PackedVertexInput {
+    @location(0) position: vec4<f32>,         // Unorm16x4: xyz in submesh bounds, w = handedness
+    @location(1) normal: vec2<f32>,           // Snorm16x2, octahedral
+    @location(2) tangent: vec2<f32>,          // Snorm16x2, octahedral
+    @location(3) texCoord0: vec2<f32>,        // Float16x2
+    @location(4) texCoord1: vec2<f32>,        // Float16x2
+    @location(5) color: vec4<f32>,            // Unorm8x4
+    @location(6) positionOffset: vec3<f32>,   // Per submesh
+    @location(7) positionScale: vec3<f32>,    // Per submesh
+    @builtin(instance_index) instance: u32
+};
+
+// Position-only inputs for the depth prepass (first vertex stream only).
+struct DepthVertexInput {
+    @location(0) position: vec3<f32>,
+    @builtin(instance_index) instance: u32
+};
+
+struct PackedDepthVertexInput {
+    @location(0) position: vec4<f32>,
+    @location(6) positionOffset: vec3<f32>,
+    @location(7) positionScale: vec3<f32>,
+    @builtin(instance_index) instance: u32
 };
 
 struct VertexOutput {
-    @builtin(position) position: vec4<f32>,     // Clip-space position
-    @location(0) color: vec4<f32>,              // Vertex color
-    @location(1) texCoord0: vec2<f32>,          // Texture coordinate 0
-    @location(2) texCoord1: vec2<f32>,          // Texture coordinate 1
-    @location(3) normalWorld: vec3<f32>,        // Normal vector (in World Space)
-    @location(4) tangentWorld: vec4<f32>,       // Tangent vector (in World Space)
-    @location(5) viewDirectionWorld: vec3<f32>  // View direction (in World Space)
+    @invariant @builtin(position) position: vec4<f32>,  // Clip-space position (invariant for the prepass)
+    @location(0) color: vec4<f32>,                      // Vertex color
+    @location(1) texCoord0: vec2<f32>,                  // Texture coordinate 0
+    @location(2) texCoord1: vec2<f32>,                  // Texture coordinate 1
+    @location(3) normalWorld: vec3<f32>,                // Normal vector (in World Space)
+    @location(4) tangentWorld: vec4<f32>,               // Tangent vector (in World Space)
+    @location(5) viewDirectionWorld: vec3<f32>          // View direction (in World Space)
 };
 
 
@@ -97,19 +133,39 @@ fn clampedDot(a: vec3f, b: vec3f) -> f32 {
   return clamp(dot(a, b), 0.0, 1.0);
 }
 
+// Inverse of vertex_packing::OctahedralEncode
+fn octahedralDecode(e: vec2f) -> vec3f {
+    var v = vec3f(e.x, e.y, 1.0 - abs(e.x) - abs(e.y));
+    let fold = max(-v.z, 0.0);
+    v.x += select(fold, -fold, v.x >= 0.0);
+    v.y += select(fold, -fold, v.y >= 0.0);
+    return normalize(v);
+}
+
 fn getNormal(in: VertexOutput) -> vec3f {
     // Reconstruct the TBN matrix using interpolated normal and tangent
     let N = normalize(in.normalWorld);
-    let T = normalize(in.tangentWorld.xyz);
+
+    // Sample the normal map and remap from [0,1] to [-1,1]. The sample stays in uniform control
+    // flow: the tangent test below varies per fragment.
+    let normalSample = textureSample(normalTexture, textureSampler, in.texCoord0).xyz;
+
+    // Submeshes whose material has no normal map may come without tangents (the default normal
+    // map would only give back N anyway); they build T from a placeholder and keep N.
+    let noTangent = dot(in.tangentWorld.xyz, in.tangentWorld.xyz) < 1e-12;
+    let T = normalize(select(in.tangentWorld.xyz, vec3f(1.0, 0.0, 0.0), noTangent));
     let B = cross(N, T) * in.tangentWorld.w; // Tangent.w is handedness
     let TBN = mat3x3f(T, B, N);
 
-    // Sample the normal map and remap from [0,1] to [-1,1]
-    var sampledNormal = textureSample(normalTexture, textureSampler, in.texCoord0).xyz  * 2.0 - 1.0;
+    var sampledNormal = normalSample * 2.0 - 1.0;
+
+    // Two-channel (BC5) normal maps sample z as 0, which no tangent-space normal has; rebuild it.
+    let rebuiltZ = sqrt(max(1.0 - dot(sampledNormal.xy, sampledNormal.xy), 0.0));
+    sampledNormal.z = select(sampledNormal.z, rebuiltZ, normalSample.z == 0.0);
     sampledNormal *= materialUniforms.normalScale; 
 
     // Compute the final normal in world space
-    return normalize(TBN * sampledNormal);
+    return select(normalize(TBN * sampledNormal), N, noTangent);
 }
 
 // https://google.github.io/filament/Filament.md.html#materialsystem/specularbrdf, Eq. 18
@@ -249,22 +305,62 @@ fn toneMap(colorIn: vec3f) -> vec3f {
 
 @vertex
 fn vs_main(in: VertexInput) -> VertexOutput {
+    return transformVertex(in.instance, in.position, in.normal, in.tangent, in.texCoord0,
+                           in.texCoord1, in.color);
+}
+
+@vertex
+fn vs_main_packed(in: PackedVertexInput) -> VertexOutput {
+
+    // Decode the quantized attributes back to the Model::Vertex representation
+    let position = in.positionOffset + in.positionScale * in.position.xyz;
+    let normal = octahedralDecode(in.normal);
+    let tangent = vec4<f32>(octahedralDecode(in.tangent), in.position.w * 2.0 - 1.0);
+
+    return transformVertex(in.instance, position, normal, tangent, in.texCoord0, in.texCoord1,
+                           in.color);
+}
+
+// The depth prepass must produce bit-identical depth to the main pass, hence @invariant and the
+// same transform expression as transformVertex.
+@vertex
+fn vs_depth(in: DepthVertexInput) -> @invariant @builtin(position) vec4<f32> {
+    let worldPosition = instanceModelMatrix(in.instance) * vec4<f32>(in.position, 1.0);
+    return globalUniforms.projectionMatrix * globalUniforms.viewMatrix * worldPosition;
+}
+
+@vertex
+fn vs_depth_packed(in: PackedDepthVertexInput) -> @invariant @builtin(position) vec4<f32> {
+    let position = in.positionOffset + in.positionScale * in.position.xyz;
+    let worldPosition = instanceModelMatrix(in.instance) * vec4<f32>(position, 1.0);
+    return globalUniforms.projectionMatrix * globalUniforms.viewMatrix * worldPosition;
+}
+
+// The viewer's model matrix applied after the instance's placement.
+fn instanceModelMatrix(instance: u32) -> mat4x4f {
+    return modelUniforms.modelMatrix * instances[instance].modelMatrix;
+}
+
+fn transformVertex(instance: u32, position: vec3f, normal: vec3f, tangent: vec4f, texCoord0: vec2f,
+                   texCoord1: vec2f, color: vec4f) -> VertexOutput {
 
     // Transform position and normal to world space
-    let worldPosition = modelUniforms.modelMatrix * vec4<f32>(in.position, 1.0);
-    let worldNormal = normalize((modelUniforms.normalMatrix * vec4<f32>(in.normal, 0.0)).xyz);
+    let worldPosition = instanceModelMatrix(instance) * vec4<f32>(position, 1.0);
+    let normalMatrix = modelUniforms.normalMatrix * instances[instance].normalMatrix;
+    let worldNormal = normalize((normalMatrix * vec4<f32>(normal, 0.0)).xyz);
 
-    // Transform tangent to world space (preserving handedness in .w)
+    // Transform tangent to world space (preserving handedness in .w). Missing tangents stay zero.
+    let tangentWorld = (normalMatrix * vec4<f32>(tangent.xyz, 0.0)).xyz;
     let worldTangent = vec4<f32>(
-        normalize((modelUniforms.normalMatrix * vec4<f32>(in.tangent.xyz, 0.0)).xyz),
-        in.tangent.w
+        select(vec3<f32>(0.0), normalize(tangentWorld), dot(tangentWorld, tangentWorld) > 0.0),
+        tangent.w
     );
 
     var output: VertexOutput;
     output.position = globalUniforms.projectionMatrix * globalUniforms.viewMatrix * worldPosition;
-    output.color = in.color;
-    output.texCoord0 = in.texCoord0;
-    output.texCoord1 = in.texCoord1;
+    output.color = color;
+    output.texCoord0 = texCoord0;
+    output.texCoord1 = texCoord1;
     output.normalWorld = worldNormal;
     output.tangentWorld = worldTangent;
     output.viewDirectionWorld = globalUniforms.cameraPositionWorld - worldPosition.xyz;
@@ -0,0 +1,60 @@
+//=========================================================
+// Hi-Z pyramid (compute path for occlusion culling)
+// - copyDepth copies the depth buffer into level 0
+// - downsample reduces one level into the next, keeping the farthest depth of the texels each
+//   destination texel covers; odd edges fold their last row or column into the last texel, so
+//   source pixel p maps to min(p >> level, levelSize - 1) at every level
+//=========================================================
+
+
+//=========================================================
+// Bind Group Declarations
+//=========================================================
+
+@group(0) @binding(0) var depthTexture: texture_depth_2d;  // copyDepth only
+@group(0) @binding(1) var sourceLevel: texture_2d<f32>;    // downsample only
+@group(0) @binding(2) var destinationLevel: texture_storage_2d<r32float, write>;
+
+
+//=========================================================
+// Constants
+//=========================================================
+
+const WORKGROUP_SIZE: u32 = 8u;
+
+
+//=========================================================
+// Compute Shader Entry Points
+//=========================================================
+
+@compute @workgroup_size(WORKGROUP_SIZE, WORKGROUP_SIZE)
+fn copyDepth(@builtin(global_invocation_id) invocationId: vec3<u32>) {
+    let size = textureDimensions(destinationLevel);
+    if (any(invocationId.xy >= size)) {
+        return;
+    }
+
+    let depth = textureLoad(depthTexture, invocationId.xy, 0);
+    textureStore(destinationLevel, invocationId.xy, vec4<f32>(depth, 0.0, 0.0, 0.0));
+}
+
+@compute @workgroup_size(WORKGROUP_SIZE, WORKGROUP_SIZE)
+fn downsample(@builtin(global_invocation_id) invocationId: vec3<u32>) {
+    let size = textureDimensions(destinationLevel);
+    if (any(invocationId.xy >= size)) {
+        return;
+    }
+
+    let sourceSize = textureDimensions(sourceLevel);
+    let first = invocationId.xy * 2u;
+    let fold = (invocationId.xy == size - 1u) & ((sourceSize & vec2<u32>(1u)) == vec2<u32>(1u));
+    let last = min(first + select(vec2<u32>(1u), vec2<u32>(2u), fold), sourceSize - 1u);
+
+    var depth = 0.0;
+    for (var y = first.y; y <= last.y; y++) {
+        for (var x = first.x; x <= last.x; x++) {
+            depth = max(depth, textureLoad(sourceLevel, vec2<u32>(x, y), 0).r);
+        }
+    }
+    textureStore(destinationLevel, invocationId.xy, vec4<f32>(depth, 0.0, 0.0, 0.0));
+}
@@ -0,0 +1,116 @@
+//=========================================================
+// Meshlet culling (compute path)
+// - One workgroup per meshlet: frustum test on its bounding sphere and backface test on its
+//   normal cone, both in model space
+// - Visible meshlets append their indices to their draw's region of the culled index buffer
+//   and grow that draw's indirect index count
+//=========================================================
+
+
+//=========================================================
+// Uniforms & Bind Group Declarations
+//=========================================================
+
+struct CullUniforms {
+    frustumPlanes: array<vec4<f32>, 6>, // Model space, xyz normalized and pointing inwards
+    cameraPosition: vec3<f32>,          // Model space
+    meshletCount: u32
+};
+
+struct Meshlet {
+    sphere: vec4<f32>,   // xyz = center, w = radius
+    coneApex: vec4<f32>, // xyz = apex, w = cutoff (above 1 disables the cone test)
+    coneAxis: vec3<f32>,
+    drawIndex: u32,      // Indirect draw the meshlet's triangles belong to
+    firstIndex: u32,     // Into the index buffer selected by is16Bit
+    indexCount: u32,
+    is16Bit: u32,
+    _pad: u32
+};
+
+struct DrawIndexedIndirectArgs {
+    indexCount: atomic<u32>,
+    instanceCount: u32,
+    firstIndex: u32,
+    baseVertex: i32,
+    firstInstance: u32
+};
+
+@group(0) @binding(0) var<uniform> cullUniforms: CullUniforms;
+@group(0) @binding(1) var<storage, read> meshlets: array<Meshlet>;
+@group(0) @binding(2) var<storage, read> indices16: array<u32>; // Two indices per word
+@group(0) @binding(3) var<storage, read> indices32: array<u32>;
+@group(0) @binding(4) var<storage, read_write> draws: array<DrawIndexedIndirectArgs>;
+@group(0) @binding(5) var<storage, read_write> culledIndices: array<u32>;
+
+
+//=========================================================
+// Constants
+//=========================================================
+
+const WORKGROUP_SIZE: u32 = 64u;
+const CULLED: u32 = 0xffffffffu;
+
+
+//=========================================================
+// Utility Functions
+//=========================================================
+
+fn isMeshletVisible(meshlet: Meshlet) -> bool {
+    for (var i = 0u; i < 6u; i++) {
+        let plane = cullUniforms.frustumPlanes[i];
+        if (dot(plane.xyz, meshlet.sphere.xyz) + plane.w < -meshlet.sphere.w) {
+            return false;
+        }
+    }
+
+    // Every triangle faces away from the camera when it sits inside the cone behind the apex.
+    let viewDirection = normalize(meshlet.coneApex.xyz - cullUniforms.cameraPosition);
+    return dot(viewDirection, meshlet.coneAxis) < meshlet.coneApex.w;
+}
+
+fn loadIndex(meshlet: Meshlet, index: u32) -> u32 {
+    if (meshlet.is16Bit != 0u) {
+        let word = indices16[index / 2u];
+        return (word >> ((index & 1u) * 16u)) & 0xffffu;
+    }
+    return indices32[index];
+}
+
+
+//=========================================================
+// Compute Shader Entry Point
+//=========================================================
+
+var<workgroup> outputOffset: u32;
+
+@compute @workgroup_size(WORKGROUP_SIZE)
+fn cullMeshlets(@builtin(workgroup_id) workgroupId: vec3<u32>,
+                @builtin(num_workgroups) workgroupCount: vec3<u32>,
+                @builtin(local_invocation_index) localIndex: u32) {
+    // Large models spill into a second dispatch dimension.
+    let meshletIndex = workgroupId.y * workgroupCount.x + workgroupId.x;
+    if (meshletIndex >= cullUniforms.meshletCount) {
+        return;
+    }
+
+    let meshlet = meshlets[meshletIndex];
+    if (localIndex == 0u) {
+        var offset = CULLED;
+        if (isMeshletVisible(meshlet)) {
+            let drawIndex = meshlet.drawIndex;
+            offset = draws[drawIndex].firstIndex +
+                     atomicAdd(&draws[drawIndex].indexCount, meshlet.indexCount);
+        }
+        outputOffset = offset;
+    }
+
+    let offset = workgroupUniformLoad(&outputOffset);
+    if (offset == CULLED) {
+        return;
+    }
+
+    for (var i = localIndex; i < meshlet.indexCount; i += WORKGROUP_SIZE) {
+        culledIndices[offset + i] = loadIndex(meshlet, meshlet.firstIndex + i);
+    }
+}
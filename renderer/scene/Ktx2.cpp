@@ -0,0 +1,391 @@
+// Class Header
+#include "Ktx2.h"
+
+// Standard Library Headers
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+// Third-Party Library Headers
+#include <stb_image.h>
+
+// Project Headers
+#include "TextureCodecs.h"
+
+//----------------------------------------------------------------------
+// Internal Constants and Utility Functions
+
+namespace {
+
+constexpr uint8_t kIdentifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                     0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+// Header (identifier, nine uint32 fields and the index) followed by the level index.
+constexpr size_t kHeaderSize = 80;
+constexpr size_t kLevelIndexEntrySize = 24;
+
+constexpr uint32_t kSupercompressionNone = 0;
+constexpr uint32_t kSupercompressionBasisLZ = 1;
+constexpr uint32_t kSupercompressionZstd = 2;
+constexpr uint32_t kSupercompressionZlib = 3;
+
+// Data format descriptor color models of Basis Universal payloads (vkFormat is undefined).
+constexpr uint8_t kColorModelEtc1s = 163;
+constexpr uint8_t kColorModelUastc = 166;
+
+// Basis Universal transcoding is out of scope; files must be encoded to a block format up front.
+constexpr const char* kBasisUnsupported =
+    " payloads are not supported (no Basis Universal transcoder); "
+    "encode the image as BC, ETC2, ASTC 4x4 or RGBA8 instead";
+
+struct Header {
+    uint32_t _vkFormat{0};
+    uint32_t _width{0};
+    uint32_t _height{0};
+    uint32_t _depth{0};
+    uint32_t _layerCount{0};
+    uint32_t _faceCount{0};
+    uint32_t _levelCount{0};
+    uint32_t _supercompression{0};
+    uint32_t _dfdOffset{0};
+    uint32_t _dfdLength{0};
+    Model::TextureFormat _format{Model::TextureFormat::RGBA8};
+};
+
+uint32_t ReadU32(const uint8_t* bytes) {
+    uint32_t value = 0;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+uint64_t ReadU64(const uint8_t* bytes) {
+    uint64_t value = 0;
+    std::memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+// Maps the VkFormat values of the formats Model::TextureFormat covers. sRGB and UNORM variants
+// share a format; the material slot decides the color space.
+bool MapVkFormat(uint32_t vkFormat, Model::TextureFormat& format) {
+    using Format = Model::TextureFormat;
+    switch (vkFormat) {
+    case 37: // VK_FORMAT_R8G8B8A8_UNORM
+    case 43: // VK_FORMAT_R8G8B8A8_SRGB
+        format = Format::RGBA8;
+        return true;
+    case 131: // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+    case 132: // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+    case 133: // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+    case 134: // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+        format = Format::BC1;
+        return true;
+    case 137: // VK_FORMAT_BC3_UNORM_BLOCK
+    case 138: // VK_FORMAT_BC3_SRGB_BLOCK
+        format = Format::BC3;
+        return true;
+    case 139: // VK_FORMAT_BC4_UNORM_BLOCK
+        format = Format::BC4;
+        return true;
+    case 141: // VK_FORMAT_BC5_UNORM_BLOCK
+        format = Format::BC5;
+        return true;
+    case 145: // VK_FORMAT_BC7_UNORM_BLOCK
+    case 146: // VK_FORMAT_BC7_SRGB_BLOCK
+        format = Format::BC7;
+        return true;
+    case 147: // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+    case 148: // VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK
+        format = Format::ETC2RGB8;
+        return true;
+    case 151: // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+    case 152: // VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+        format = Format::ETC2RGBA8;
+        return true;
+    case 157: // VK_FORMAT_ASTC_4x4_UNORM_BLOCK
+    case 158: // VK_FORMAT_ASTC_4x4_SRGB_BLOCK
+        format = Format::ASTC4x4;
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool ParseHeader(const uint8_t* bytes, size_t size, Header& header, std::string& err) {
+    if (!ktx2::IsKtx2(bytes, size) || size < kHeaderSize) {
+        err = "not a KTX2 file";
+        return false;
+    }
+    header._vkFormat = ReadU32(bytes + 12);
+    header._width = ReadU32(bytes + 20);
+    header._height = ReadU32(bytes + 24);
+    header._depth = ReadU32(bytes + 28);
+    header._layerCount = ReadU32(bytes + 32);
+    header._faceCount = ReadU32(bytes + 36);
+    header._levelCount = ReadU32(bytes + 40);
+    header._supercompression = ReadU32(bytes + 44);
+    header._dfdOffset = ReadU32(bytes + 48);
+    header._dfdLength = ReadU32(bytes + 52);
+
+    if (header._supercompression == kSupercompressionBasisLZ) {
+        err = std::string("ETC1S (BasisLZ)") + kBasisUnsupported;
+        return false;
+    }
+    if (header._vkFormat == 0) {
+        // The basic descriptor block's color model follows the total size and block header.
+        const size_t colorModelOffset = static_cast<size_t>(header._dfdOffset) + 12;
+        const uint8_t colorModel =
+            header._dfdLength > 12 && colorModelOffset < size ? bytes[colorModelOffset] : 0;
+        if (colorModel == kColorModelUastc) {
+            err = std::string("UASTC") + kBasisUnsupported;
+        } else if (colorModel == kColorModelEtc1s) {
+            err = std::string("ETC1S") + kBasisUnsupported;
+        } else {
+            err = "undefined vkFormat";
+        }
+        return false;
+    }
+    if (!MapVkFormat(header._vkFormat, header._format)) {
+        err = "unsupported vkFormat " + std::to_string(header._vkFormat);
+        return false;
+    }
+    if (header._supercompression == kSupercompressionZstd) {
+        err = "Zstandard supercompression is not supported";
+        return false;
+    }
+    if (header._supercompression != kSupercompressionNone &&
+        header._supercompression != kSupercompressionZlib) {
+        err = "unknown supercompression scheme " + std::to_string(header._supercompression);
+        return false;
+    }
+    if (header._width == 0 || header._height == 0 || header._depth > 0 ||
+        header._layerCount > 1 || header._faceCount != 1) {
+        err = "only single 2D images are supported";
+        return false;
+    }
+
+    uint32_t maxLevels = 1;
+    while ((std::max(header._width, header._height) >> maxLevels) > 0) {
+        ++maxLevels;
+    }
+    const size_t levels = std::max(header._levelCount, 1u);
+    if (levels > maxLevels || kHeaderSize + levels * kLevelIndexEntrySize > size) {
+        err = "invalid level index";
+        return false;
+    }
+    return true;
+}
+
+void WriteU16(uint8_t* bytes, uint16_t value) {
+    std::memcpy(bytes, &value, sizeof(value));
+}
+
+void WriteU32(uint8_t* bytes, uint32_t value) {
+    std::memcpy(bytes, &value, sizeof(value));
+}
+
+void WriteU64(uint8_t* bytes, uint64_t value) {
+    std::memcpy(bytes, &value, sizeof(value));
+}
+
+// Data format descriptor sample: `bits` bits of channel `channel` starting at `bitOffset`.
+struct DfdSample {
+    uint16_t _bitOffset{0};
+    uint8_t _bits{0};
+    uint8_t _channel{0};
+    uint32_t _upper{0};
+};
+
+// What WriteTexture needs to describe a format: its VkFormat and the basic DFD block fields.
+struct WriteFormat {
+    uint32_t _vkFormat{0};
+    uint8_t _colorModel{0};
+    std::vector<DfdSample> _samples;
+};
+
+bool GetWriteFormat(Model::TextureFormat format, WriteFormat& writeFormat) {
+    using Format = Model::TextureFormat;
+    // Channel ids are per color model: 0 is the block's color (BC1, BC7) or red (BC4, BC5),
+    // 1 is green and 15 is alpha.
+    switch (format) {
+    case Format::RGBA8:
+        writeFormat = {37, 1, {{0, 8, 0, 255}, {8, 8, 1, 255}, {16, 8, 2, 255}, {24, 8, 15, 255}}};
+        return true;
+    case Format::BC1:
+        writeFormat = {131, 128, {{0, 64, 0, UINT32_MAX}}};
+        return true;
+    case Format::BC4:
+        writeFormat = {139, 131, {{0, 64, 0, UINT32_MAX}}};
+        return true;
+    case Format::BC5:
+        writeFormat = {141, 132, {{0, 64, 0, UINT32_MAX}, {64, 64, 1, UINT32_MAX}}};
+        return true;
+    case Format::BC7:
+        writeFormat = {145, 133, {{0, 128, 0, UINT32_MAX}}};
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// ktx2 implementation
+
+namespace ktx2 {
+
+bool IsKtx2(const uint8_t* bytes, size_t size) noexcept {
+    return bytes && size >= sizeof(kIdentifier) &&
+           std::memcmp(bytes, kIdentifier, sizeof(kIdentifier)) == 0;
+}
+
+bool CheckSupported(const uint8_t* bytes, size_t size, std::string& err) {
+    Header header;
+    return ParseHeader(bytes, size, header, err);
+}
+
+bool ReadTexture(const uint8_t* bytes, size_t size, Model::Texture& texture, std::string& err) {
+    Header header;
+    if (!ParseHeader(bytes, size, header, err)) {
+        return false;
+    }
+
+    const uint32_t levelCount = std::max(header._levelCount, 1u);
+    std::vector<Model::MipLevel> levels(levelCount);
+    size_t totalSize = 0;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        Model::MipLevel& mip = levels[level];
+        mip._width = std::max(header._width >> level, 1u);
+        mip._height = std::max(header._height >> level, 1u);
+        mip._offset = totalSize;
+        mip._size = texture_codecs::GetLevelSize(header._format, mip._width, mip._height);
+        totalSize += mip._size;
+    }
+
+    uint8_t* data = static_cast<uint8_t*>(std::malloc(totalSize));
+    if (!data) {
+        err = "out of memory";
+        return false;
+    }
+    Model::ImageData imageData(data, totalSize);
+
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        const uint8_t* entry = bytes + kHeaderSize + level * kLevelIndexEntrySize;
+        const uint64_t byteOffset = ReadU64(entry);
+        const uint64_t byteLength = ReadU64(entry + 8);
+        const uint64_t uncompressedLength = ReadU64(entry + 16);
+        const Model::MipLevel& mip = levels[level];
+        if (byteOffset > size || byteLength > size - byteOffset ||
+            uncompressedLength != mip._size) {
+            err = "level " + std::to_string(level) + " is out of bounds or has the wrong size";
+            return false;
+        }
+
+        const uint8_t* source = bytes + byteOffset;
+        if (header._supercompression == kSupercompressionNone) {
+            if (byteLength != mip._size) {
+                err = "level " + std::to_string(level) + " has the wrong size";
+                return false;
+            }
+            std::memcpy(data + mip._offset, source, mip._size);
+            continue;
+        }
+
+        // ZLIB: each level is a separate zlib stream; stb_image's inflate handles it.
+        int inflatedSize = 0;
+        char* inflated = stbi_zlib_decode_malloc_guesssize_headerflag(
+            reinterpret_cast<const char*>(source), static_cast<int>(byteLength),
+            static_cast<int>(mip._size), &inflatedSize, 1);
+        const bool valid = inflated && static_cast<size_t>(inflatedSize) == mip._size;
+        if (valid) {
+            std::memcpy(data + mip._offset, inflated, mip._size);
+        }
+        stbi_image_free(inflated);
+        if (!valid) {
+            err = "level " + std::to_string(level) + " failed to inflate";
+            return false;
+        }
+    }
+
+    texture._width = header._width;
+    texture._height = header._height;
+    texture._components = header._format == Model::TextureFormat::BC4   ? 1
+                          : header._format == Model::TextureFormat::BC5 ? 2
+                                                                        : 4;
+    texture._format = header._format;
+    texture._data = std::move(imageData);
+    texture._mipLevels = std::move(levels);
+    if (header._levelCount == 0 && header._format == Model::TextureFormat::RGBA8) {
+        texture._mipLevels.clear();
+    }
+    return true;
+}
+
+bool WriteTexture(const Model::Texture& texture, std::vector<uint8_t>& bytes) {
+    WriteFormat writeFormat;
+    if (!GetWriteFormat(texture._format, writeFormat) || texture._mipLevels.empty()) {
+        return false;
+    }
+
+    const texture_codecs::BlockInfo block = texture_codecs::GetBlockInfo(texture._format);
+    const size_t levelCount = texture._mipLevels.size();
+    const size_t dfdOffset = kHeaderSize + levelCount * kLevelIndexEntrySize;
+    const size_t dfdSize = 4 + 24 + 16 * writeFormat._samples.size();
+
+    // Levels are stored smallest first, each aligned to lcm(block size, 4).
+    const size_t alignment = std::lcm(size_t{block._bytes}, size_t{4});
+    std::vector<size_t> levelOffsets(levelCount);
+    size_t end = dfdOffset + dfdSize;
+    for (size_t level = levelCount; level-- > 0;) {
+        end = (end + alignment - 1) / alignment * alignment;
+        levelOffsets[level] = end;
+        end += texture._mipLevels[level]._size;
+    }
+    bytes.assign(end, 0);
+    uint8_t* data = bytes.data();
+
+    std::memcpy(data, kIdentifier, sizeof(kIdentifier));
+    WriteU32(data + 12, writeFormat._vkFormat);
+    WriteU32(data + 16, 1); // typeSize
+    WriteU32(data + 20, texture._width);
+    WriteU32(data + 24, texture._height);
+    WriteU32(data + 36, 1); // faceCount
+    WriteU32(data + 40, static_cast<uint32_t>(levelCount));
+    WriteU32(data + 44, kSupercompressionNone);
+    WriteU32(data + 48, static_cast<uint32_t>(dfdOffset));
+    WriteU32(data + 52, static_cast<uint32_t>(dfdSize));
+
+    for (size_t level = 0; level < levelCount; ++level) {
+        const Model::MipLevel& mip = texture._mipLevels[level];
+        uint8_t* entry = data + kHeaderSize + level * kLevelIndexEntrySize;
+        WriteU64(entry, levelOffsets[level]);
+        WriteU64(entry + 8, mip._size);
+        WriteU64(entry + 16, mip._size);
+        std::memcpy(data + levelOffsets[level], texture._data.data() + mip._offset, mip._size);
+    }
+
+    // Basic descriptor block: linear BT.709, one plane of whole blocks.
+    uint8_t* dfd = data + dfdOffset;
+    WriteU32(dfd, static_cast<uint32_t>(dfdSize));
+    WriteU16(dfd + 8, 2); // versionNumber
+    WriteU16(dfd + 10, static_cast<uint16_t>(dfdSize - 4));
+    dfd[12] = writeFormat._colorModel;
+    dfd[13] = 1; // colorPrimaries
+    dfd[14] = 1; // transferFunction
+    dfd[16] = static_cast<uint8_t>(block._width - 1);
+    dfd[17] = static_cast<uint8_t>(block._height - 1);
+    dfd[20] = static_cast<uint8_t>(block._bytes);
+    for (size_t i = 0; i < writeFormat._samples.size(); ++i) {
+        const DfdSample& sample = writeFormat._samples[i];
+        uint8_t* entry = dfd + 28 + 16 * i;
+        WriteU16(entry, sample._bitOffset);
+        entry[2] = static_cast<uint8_t>(sample._bits - 1);
+        entry[3] = sample._channel;
+        WriteU32(entry + 12, sample._upper);
+    }
+    return true;
+}
+
+} // namespace ktx2
@@ -0,0 +1,36 @@
+/// @file  Ktx2.h
+/// @brief Reader and writer for KTX2 texture containers (KHR_texture_basisu images).
+
+#pragma once
+
+// Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Project Headers
+#include "Model.h"
+
+namespace ktx2 {
+
+// True if `bytes` start with the KTX2 file identifier.
+bool IsKtx2(const uint8_t* bytes, size_t size) noexcept;
+
+// Checks the header only. Readable files hold one 2D image in RGBA8 or a GPU block format (BC,
+// ETC2, ASTC 4x4), either stored plainly or ZLIB-supercompressed. Transcoding is out of scope:
+// Basis Universal payloads (BasisLZ/ETC1S, UASTC) and Zstandard-supercompressed files are
+// rejected, and `err` says why.
+bool CheckSupported(const uint8_t* bytes, size_t size, std::string& err);
+
+// Reads every mip level in the file into `texture`: level 0 first, back to back in _data, with
+// _mipLevels describing them. An RGBA8 file without mips (levelCount 0) leaves _mipLevels empty
+// so the renderer generates them as it does for PNG and JPEG images.
+bool ReadTexture(const uint8_t* bytes, size_t size, Model::Texture& texture, std::string& err);
+
+// Writes a texture with mip levels in RGBA8, BC1, BC4, BC5 or BC7 as an uncompressed KTX2 file
+// that ReadTexture reads back unchanged. Returns false for other formats and single-level
+// textures without _mipLevels.
+bool WriteTexture(const Model::Texture& texture, std::vector<uint8_t>& bytes);
+
+} // namespace ktx2
@@ -0,0 +1,156 @@
+// Class Header
+#include "MappedGlb.h"
+
+// Standard Library Headers
+#include <cstring>
+
+// Platform Headers
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#define GFX_MAPPED_GLB_SUPPORTED 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------
+// Internal Constants and Utility Functions
+
+namespace {
+
+constexpr uint32_t kGlbMagic = 0x46546C67;     // "glTF"
+constexpr uint32_t kChunkTypeJson = 0x4E4F534A; // "JSON"
+constexpr uint32_t kChunkTypeBin = 0x004E4942;  // "BIN\0"
+constexpr size_t kHeaderSize = 12;
+constexpr size_t kChunkHeaderSize = 8;
+
+uint32_t ReadU32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value)); // GLB is little-endian, as are our targets.
+    return value;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// MappedGlb Class implementation
+
+MappedGlb::~MappedGlb() {
+    Close();
+}
+
+bool MappedGlb::Open(const std::string& filename) {
+    Close();
+
+#if defined(GFX_MAPPED_GLB_SUPPORTED)
+    const int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(kHeaderSize)) {
+        close(fd);
+        return false;
+    }
+
+    const size_t fileSize = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps its own reference to the file.
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    _mapping = static_cast<const uint8_t*>(mapping);
+    _mappingSize = fileSize;
+
+    // Geometry is mostly read front to back; let the kernel read ahead aggressively.
+    madvise(mapping, fileSize, MADV_SEQUENTIAL);
+
+    // Header: magic, version, total length.
+    const uint32_t length = ReadU32(_mapping + 8);
+    if (ReadU32(_mapping) != kGlbMagic || ReadU32(_mapping + 4) != 2 || length > fileSize ||
+        length < kHeaderSize + kChunkHeaderSize) {
+        Close();
+        return false;
+    }
+
+    // Chunk 0 must be JSON.
+    const size_t jsonLength = ReadU32(_mapping + kHeaderSize);
+    const size_t jsonStart = kHeaderSize + kChunkHeaderSize;
+    if (ReadU32(_mapping + kHeaderSize + 4) != kChunkTypeJson || jsonLength == 0 ||
+        jsonStart + jsonLength > length || (jsonLength % 4) != 0) {
+        Close();
+        return false;
+    }
+    _json = std::string_view(reinterpret_cast<const char*>(_mapping + jsonStart), jsonLength);
+
+    // Optional chunk 1 is BIN.
+    const size_t binHeader = jsonStart + jsonLength;
+    if (binHeader + kChunkHeaderSize <= length) {
+        const size_t binLength = ReadU32(_mapping + binHeader);
+        if (ReadU32(_mapping + binHeader + 4) != kChunkTypeBin ||
+            binHeader + kChunkHeaderSize + binLength > length) {
+            Close();
+            return false;
+        }
+        if (binLength > 0) {
+            _binData = _mapping + binHeader + kChunkHeaderSize;
+            _binSize = binLength;
+        }
+    }
+
+    return true;
+#else
+    (void)filename;
+    return false;
+#endif
+}
+
+bool MappedGlb::IsOpen() const noexcept {
+    return _mapping != nullptr;
+}
+
+std::string_view MappedGlb::GetJson() const noexcept {
+    return _json;
+}
+
+const uint8_t* MappedGlb::GetBinData() const noexcept {
+    return _binData;
+}
+
+size_t MappedGlb::GetBinSize() const noexcept {
+    return _binSize;
+}
+
+void MappedGlb::Release(const uint8_t* data, size_t size) const {
+#if defined(GFX_MAPPED_GLB_SUPPORTED)
+    if (!_mapping || size == 0) {
+        return;
+    }
+
+    // Only whole pages can be dropped; round inwards so neighbouring data keeps its pages.
+    const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = (reinterpret_cast<uintptr_t>(data) + pageSize - 1) & ~(pageSize - 1);
+    const uintptr_t end = (reinterpret_cast<uintptr_t>(data) + size) & ~(pageSize - 1);
+    if (end > begin) {
+        madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+    }
+#else
+    (void)data;
+    (void)size;
+#endif
+}
+
+void MappedGlb::Close() {
+#if defined(GFX_MAPPED_GLB_SUPPORTED)
+    if (_mapping) {
+        munmap(const_cast<uint8_t*>(_mapping), _mappingSize);
+    }
+#endif
+    _mapping = nullptr;
+    _mappingSize = 0;
+    _json = {};
+    _binData = nullptr;
+    _binSize = 0;
+}
@@ -0,0 +1,55 @@
+/// @file  MappedGlb.h
+/// @brief Read-only memory mapping of a binary glTF (.glb) file.
+
+#pragma once
+
+// Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// MappedGlb Class
+// Maps a .glb file and locates its JSON and BIN chunks, so geometry can be decoded straight from
+// the page cache. Only implemented on Linux; Open() fails elsewhere and callers fall back to
+// reading the file.
+class MappedGlb {
+  public:
+    // Constructor
+    MappedGlb() = default;
+
+    // Destructor (unmaps the file)
+    ~MappedGlb();
+
+    // Non-copyable and non-movable
+    MappedGlb(const MappedGlb&) = delete;
+    MappedGlb& operator=(const MappedGlb&) = delete;
+    MappedGlb(MappedGlb&&) = delete;
+    MappedGlb& operator=(MappedGlb&&) = delete;
+
+    // Maps the file and validates the GLB header and chunk layout. Returns false if the file
+    // can't be mapped or isn't a well-formed GLB; callers then take the regular loading path,
+    // which reports the actual error.
+    bool Open(const std::string& filename);
+
+    // Accessors
+    bool IsOpen() const noexcept;
+    std::string_view GetJson() const noexcept;
+    const uint8_t* GetBinData() const noexcept; // nullptr if the file has no BIN chunk
+    size_t GetBinSize() const noexcept;
+
+    // Drops the resident pages fully inside [data, data + size). The bytes stay readable; a
+    // later access faults them back in from the page cache.
+    void Release(const uint8_t* data, size_t size) const;
+
+  private:
+    // Private Member Functions
+    void Close();
+
+    // Private Member Variables
+    const uint8_t* _mapping{nullptr};
+    size_t _mappingSize{0};
+    std::string_view _json;
+    const uint8_t* _binData{nullptr};
+    size_t _binSize{0};
+};
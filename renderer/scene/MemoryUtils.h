@@ -0,0 +1,14 @@
+/// @file  MemoryUtils.h
+/// @brief Process memory queries used for load-time diagnostics.
+
+#pragma once
+
+// Standard Library Headers
+#include <cstddef>
+
+namespace memory_utils {
+
+// Current resident set size of the process in bytes, or 0 if the platform can't report it.
+size_t GetResidentMemoryBytes();
+
+} // namespace memory_utils
@@ -2,28 +2,44 @@
 #include "MeshUtils.h"
 
 // Standard Library Headers
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
 
 // Third-Party Library Headers
 #include "mikktspace.h"
 
+// Project Headers
+#include "ThreadPool.h"
+#include "VertexKernels.h"
+
 //----------------------------------------------------------------------
 // Internal Types and Utility Functions
 
 namespace {
 
-// User data structure for MikkTSpace
+// User data for MikkTSpace: the submesh's attributes gathered per corner (face * 3 + vert), so
+// every callback is a single contiguous read. Tangents are written back the same way and
+// scattered to the vertices afterwards.
 struct MeshData {
-    std::vector<Model::Vertex>* _vertices{nullptr};
-    std::vector<uint32_t>* _indices{nullptr};
-    uint32_t _firstIndex{0};
-    uint32_t _indexCount{0};
+    std::vector<glm::vec3> _positions;
+    std::vector<glm::vec3> _normals;
+    std::vector<glm::vec2> _texCoords;
+    std::vector<glm::vec4> _tangents;
 };
 
+const MeshData& GetMeshData(const SMikkTSpaceContext* pContext) {
+    return *static_cast<const MeshData*>(pContext->m_pUserData);
+}
+
 // Returns the number of faces (triangles).
 int getNumFaces(const SMikkTSpaceContext* pContext) {
-    MeshData* mesh = static_cast<MeshData*>(pContext->m_pUserData);
-    return static_cast<int>(mesh->_indexCount / 3);
+    return static_cast<int>(GetMeshData(pContext)._positions.size() / 3);
 }
 
 // Each face in a triangle mesh always has 3 vertices.
@@ -34,64 +50,598 @@ int getNumVerticesOfFace(const SMikkTSpaceContext*, const int) {
 // Provides the position of the vertex for the given face and vertex index.
 void getPosition(const SMikkTSpaceContext* pContext, float position[3], const int face,
                  const int vert) {
-    MeshData* mesh = static_cast<MeshData*>(pContext->m_pUserData);
-    int index = (*mesh->_indices)[mesh->_firstIndex + face * 3 + vert];
-    const Model::Vertex& vertex = (*mesh->_vertices)[index];
-    position[0] = vertex._position.x;
-    position[1] = vertex._position.y;
-    position[2] = vertex._position.z;
+    const glm::vec3& p = GetMeshData(pContext)._positions[face * 3 + vert];
+    position[0] = p.x;
+    position[1] = p.y;
+    position[2] = p.z;
 }
 
 // Provides the normal of the vertex.
 void getNormal(const SMikkTSpaceContext* pContext, float normal[3], const int face,
                const int vert) {
-    MeshData* mesh = static_cast<MeshData*>(pContext->m_pUserData);
-    int index = (*mesh->_indices)[mesh->_firstIndex + face * 3 + vert];
-    const Model::Vertex& vertex = (*mesh->_vertices)[index];
-    normal[0] = vertex._normal.x;
-    normal[1] = vertex._normal.y;
-    normal[2] = vertex._normal.z;
+    const glm::vec3& n = GetMeshData(pContext)._normals[face * 3 + vert];
+    normal[0] = n.x;
+    normal[1] = n.y;
+    normal[2] = n.z;
 }
 
 // Provides the texture coordinate of the vertex.
 void getTexCoord(const SMikkTSpaceContext* pContext, float texCoord[2], const int face,
                  const int vert) {
-    MeshData* mesh = static_cast<MeshData*>(pContext->m_pUserData);
-    int index = (*mesh->_indices)[mesh->_firstIndex + face * 3 + vert];
-    const Model::Vertex& vertex = (*mesh->_vertices)[index];
-    texCoord[0] = vertex._texCoord0.x;
-    texCoord[1] = vertex._texCoord0.y;
+    const glm::vec2& uv = GetMeshData(pContext)._texCoords[face * 3 + vert];
+    texCoord[0] = uv.x;
+    texCoord[1] = uv.y;
 }
 
 // Called to set the computed tangent (and its sign for handedness).
 void setTSpaceBasic(const SMikkTSpaceContext* pContext, const float tangent[3], const float sign,
                     const int face, const int vert) {
-    // Fetch the vertex data.
-    MeshData* mesh = static_cast<MeshData*>(pContext->m_pUserData);
-    int index = (*mesh->_indices)[mesh->_firstIndex + face * 3 + vert];
-    Model::Vertex& vertex = (*mesh->_vertices)[index];
-
-    float n[3];
-    pContext->m_pInterface->m_getNormal(pContext, n, face, vert);
-    glm::vec3 normal(n[0], n[1], n[2]);
+    MeshData& mesh = *static_cast<MeshData*>(pContext->m_pUserData);
+    const size_t corner = static_cast<size_t>(face) * 3 + vert;
+    const glm::vec3& normal = mesh._normals[corner];
+    glm::vec4& result = mesh._tangents[corner];
 
     // Normalize the computed tangent vector.
     glm::vec3 t = glm::normalize(glm::vec3(tangent[0], tangent[1], tangent[2]));
 
     // Check if the computed tangent is sufficiently orthogonal to the normal.
     if (glm::abs(glm::dot(t, normal)) < 0.9f) {
-        vertex._tangent = glm::vec4(tangent[0], tangent[1], tangent[2], -sign);
+        result = glm::vec4(tangent[0], tangent[1], tangent[2], -sign);
     } else {
         // Generate a fallback tangent that is orthogonal to the normal.
         // Use a threshold to handle the singular case when the normal is nearly (0, 0, -1).
         constexpr float kSingularityThreshold = -0.99998796f;
         if (normal.z < kSingularityThreshold) {
-            vertex._tangent = glm::vec4(0.0f, -1.0f, 0.0f, 1.0f);
+            result = glm::vec4(0.0f, -1.0f, 0.0f, 1.0f);
         } else {
             float a = 1.0f / (1.0f + normal.z);
             float b = -normal.x * normal.y * a;
-            vertex._tangent = glm::vec4(1.0f - normal.x * normal.x * a, b, -normal.x, 1.0f);
+            result = glm::vec4(1.0f - normal.x * normal.x * a, b, -normal.x, 1.0f);
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+// Mesh optimization helpers
+
+// Forsyth's scoring parameters ("Linear-Speed Vertex Cache Optimisation").
+constexpr size_t kForsythCacheSize = 32;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriangleScore = 0.75f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+
+// Cache size used when measuring ACMR/ATVR (typical of current GPUs).
+constexpr uint32_t kAnalyzeCacheSize = 16;
+
+// Overdraw clusters shorter than this are not split further on the miss-rate criterion.
+constexpr size_t kMinClusterTriangles = 16;
+
+float ForsythVertexScore(int cachePosition, uint32_t liveTriangles) {
+    if (liveTriangles == 0) {
+        return -1.0f; // No triangles left to use this vertex.
+    }
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // Used by the last triangle; fixed score so the order within it doesn't matter.
+            score = kLastTriangleScore;
+        } else {
+            const float scale = 1.0f / static_cast<float>(kForsythCacheSize - 3);
+            score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale,
+                             kCacheDecayPower);
+        }
+    }
+
+    // Favour vertices with few triangles left, to get rid of lone triangles quickly.
+    return score + kValenceBoostScale *
+                       std::pow(static_cast<float>(liveTriangles), -kValenceBoostPower);
+}
+
+struct VertexHash {
+    size_t operator()(const Model::Vertex* vertex) const noexcept {
+        // FNV-1a over the raw bytes; Vertex has no padding.
+        const auto* bytes = reinterpret_cast<const uint8_t*>(vertex);
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < sizeof(Model::Vertex); ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
         }
+        return static_cast<size_t>(hash);
+    }
+};
+
+struct VertexBitwiseEqual {
+    bool operator()(const Model::Vertex* a, const Model::Vertex* b) const noexcept {
+        return std::memcmp(a, b, sizeof(Model::Vertex)) == 0;
+    }
+};
+
+void AccumulateStats(mesh_utils::VertexCacheStats& total,
+                     const mesh_utils::VertexCacheStats& stats) {
+    total._triangleCount += stats._triangleCount;
+    total._vertexCount += stats._vertexCount;
+    total._cacheMisses += stats._cacheMisses;
+}
+
+// One overdraw cluster: a run of triangles and the key it is sorted by.
+struct TriangleCluster {
+    size_t _firstTriangle{0};
+    size_t _triangleCount{0};
+    float _sortKey{0.0f};
+};
+
+// Misses of one triangle in the FIFO cache AnalyzeVertexCache simulates. Adding
+// kAnalyzeCacheSize + 1 to `time` empties the cache.
+size_t SimulateCacheTriangle(const uint32_t* triangle, std::vector<uint32_t>& timestamps,
+                             uint32_t& time) {
+    size_t misses = 0;
+    for (size_t k = 0; k < 3; ++k) {
+        if (time - timestamps[triangle[k]] > kAnalyzeCacheSize) {
+            timestamps[triangle[k]] = time++;
+            ++misses;
+        }
+    }
+    return misses;
+}
+
+// Splits cache-optimized triangles into overdraw clusters (meshoptimizer's scheme). A triangle
+// that misses on all three vertices starts a new patch. With `split`, each patch is cut again
+// wherever the miss rate since the last cut, from a cold cache, falls to `threshold` times the
+// patch's own; the remainder after the last cut is merged back into the cluster before it.
+std::vector<TriangleCluster> BuildOverdrawClusters(const std::vector<uint32_t>& indices,
+                                                   size_t vertexCount, float threshold,
+                                                   bool split) {
+    const size_t triangleCount = indices.size() / 3;
+    std::vector<uint32_t> timestamps(vertexCount, 0);
+    uint32_t time = kAnalyzeCacheSize + 1;
+
+    std::vector<size_t> patches;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        if (SimulateCacheTriangle(&indices[t * 3], timestamps, time) == 3 || t == 0) {
+            patches.push_back(t);
+        }
+    }
+    patches.push_back(triangleCount);
+
+    std::vector<TriangleCluster> clusters;
+    for (size_t p = 0; p + 1 < patches.size(); ++p) {
+        const size_t first = patches[p];
+        const size_t last = patches[p + 1];
+        const size_t patchStart = clusters.size();
+        clusters.push_back({first, last - first, 0.0f});
+        if (!split || last - first <= kMinClusterTriangles) {
+            continue;
+        }
+
+        time += kAnalyzeCacheSize + 1;
+        size_t patchMisses = 0;
+        for (size_t t = first; t < last; ++t) {
+            patchMisses += SimulateCacheTriangle(&indices[t * 3], timestamps, time);
+        }
+        const float targetAcmr =
+            threshold * static_cast<float>(patchMisses) / static_cast<float>(last - first);
+
+        time += kAnalyzeCacheSize + 1;
+        size_t clusterFirst = first;
+        size_t clusterMisses = 0;
+        for (size_t t = first; t < last; ++t) {
+            clusterMisses += SimulateCacheTriangle(&indices[t * 3], timestamps, time);
+            const size_t clusterTriangles = t + 1 - clusterFirst;
+            if (clusterTriangles >= kMinClusterTriangles &&
+                static_cast<float>(clusterMisses) <=
+                    targetAcmr * static_cast<float>(clusterTriangles)) {
+                clusters.back()._triangleCount = clusterTriangles;
+                clusters.push_back({t + 1, last - t - 1, 0.0f});
+                clusterFirst = t + 1;
+                clusterMisses = 0;
+                time += kAnalyzeCacheSize + 1;
+            }
+        }
+
+        // The remainder never reached the target; fold it into the previous cluster.
+        if (clusters.size() - patchStart > 1) {
+            const size_t remainder = clusters.back()._triangleCount;
+            clusters.pop_back();
+            clusters.back()._triangleCount += remainder;
+        }
+    }
+    return clusters;
+}
+
+// Orders clusters facing away from the mesh center first and returns the reordered indices.
+std::vector<uint32_t> SortOverdrawClusters(const std::vector<uint32_t>& indices,
+                                           const std::vector<Model::Vertex>& vertices,
+                                           std::vector<TriangleCluster> clusters) {
+    // Area-weighted centroid and normal of every cluster.
+    std::vector<glm::vec3> clusterCentroids(clusters.size(), glm::vec3(0.0f));
+    std::vector<glm::vec3> clusterNormals(clusters.size(), glm::vec3(0.0f));
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        float clusterArea = 0.0f;
+        for (size_t t = clusters[c]._firstTriangle;
+             t < clusters[c]._firstTriangle + clusters[c]._triangleCount; ++t) {
+            const glm::vec3& p0 = vertices[indices[t * 3 + 0]]._position;
+            const glm::vec3& p1 = vertices[indices[t * 3 + 1]]._position;
+            const glm::vec3& p2 = vertices[indices[t * 3 + 2]]._position;
+            const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            const float area = glm::length(normal);
+            clusterCentroids[c] += (p0 + p1 + p2) * (area / 3.0f);
+            clusterNormals[c] += normal;
+            clusterArea += area;
+        }
+
+        meshCentroid += clusterCentroids[c];
+        meshArea += clusterArea;
+        if (clusterArea > 0.0f) {
+            clusterCentroids[c] /= clusterArea;
+        }
+    }
+
+    if (meshArea > 0.0f) {
+        meshCentroid /= meshArea;
+    }
+
+    // Clusters that face away from the center tend to occlude the others; draw them first.
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        const float normalLength = glm::length(clusterNormals[c]);
+        if (normalLength > 0.0f) {
+            clusters[c]._sortKey =
+                glm::dot(clusterCentroids[c] - meshCentroid, clusterNormals[c] / normalLength);
+        }
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const TriangleCluster& a, const TriangleCluster& b) {
+                         return a._sortKey > b._sortKey;
+                     });
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    for (const TriangleCluster& cluster : clusters) {
+        const auto first = indices.begin() + cluster._firstTriangle * 3;
+        output.insert(output.end(), first, first + cluster._triangleCount * 3);
+    }
+    return output;
+}
+
+// Meshlets whose normals spread further than this from the cone axis (dot product) get no
+// backface cone; such cones would almost never cull anything.
+constexpr float kMinConeSpread = 0.1f;
+
+// Fills in the bounding sphere and backface cone of a meshlet (meshoptimizer's construction).
+void ComputeMeshletBounds(const uint32_t* indices, const std::vector<Model::Vertex>& vertices,
+                          Model::Meshlet& meshlet) {
+    glm::vec3 minBounds(std::numeric_limits<float>::max());
+    glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
+    for (uint32_t i = 0; i < meshlet._indexCount; ++i) {
+        minBounds = glm::min(minBounds, vertices[indices[i]]._position);
+        maxBounds = glm::max(maxBounds, vertices[indices[i]]._position);
+    }
+    meshlet._center = (minBounds + maxBounds) * 0.5f;
+    meshlet._radius = 0.0f;
+    for (uint32_t i = 0; i < meshlet._indexCount; ++i) {
+        const float distance = glm::length(vertices[indices[i]]._position - meshlet._center);
+        meshlet._radius = std::max(meshlet._radius, distance);
+    }
+
+    // Geometric (counter-clockwise) triangle normals; degenerate triangles can't face anywhere.
+    const uint32_t triangleCount = meshlet._indexCount / 3;
+    std::vector<glm::vec3> normals(triangleCount, glm::vec3(0.0f));
+    glm::vec3 axis(0.0f);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        const glm::vec3& p0 = vertices[indices[t * 3 + 0]]._position;
+        const glm::vec3& p1 = vertices[indices[t * 3 + 1]]._position;
+        const glm::vec3& p2 = vertices[indices[t * 3 + 2]]._position;
+        const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+        const float length = glm::length(normal);
+        if (length > 0.0f) {
+            normals[t] = normal / length;
+            axis += normals[t];
+        }
+    }
+
+    meshlet._coneCutoff = 2.0f;
+    const float axisLength = glm::length(axis);
+    if (axisLength <= 0.0f) {
+        return;
+    }
+    axis /= axisLength;
+
+    float minDot = 1.0f;
+    for (const glm::vec3& normal : normals) {
+        if (normal != glm::vec3(0.0f)) {
+            minDot = std::min(minDot, glm::dot(axis, normal));
+        }
+    }
+    if (minDot <= kMinConeSpread) {
+        return;
+    }
+
+    // Move the apex back along the axis until it lies behind every triangle's plane.
+    float maxT = 0.0f;
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        if (normals[t] != glm::vec3(0.0f)) {
+            const glm::vec3 toCenter = meshlet._center - vertices[indices[t * 3]]._position;
+            maxT = std::max(maxT, glm::dot(toCenter, normals[t]) / glm::dot(axis, normals[t]));
+        }
+    }
+
+    meshlet._coneApex = meshlet._center - axis * maxT;
+    meshlet._coneAxis = axis;
+    meshlet._coneCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+
+//----------------------------------------------------------------------
+// Simplification helpers
+
+// Weight of the planes that hold open borders and attribute seams in place, relative to the
+// surface planes around them.
+constexpr double kBorderWeight = 10.0;
+
+// Triangles around a collapsing vertex may not turn further than this (cosine).
+constexpr float kMinFlipCosine = 0.25f;
+
+// A pass stops at collapses this much costlier than the cheapest ones it could afford.
+constexpr double kPassErrorSlack = 1.5;
+
+// LOD chain shape: each level aims for half the triangles of the previous one, and the chain
+// ends early once a level stops paying off or the error budget (relative to the submesh's
+// bounds diagonal) is spent.
+constexpr size_t kMaxLodLevels = 4;
+constexpr float kLodReduction = 0.5f;
+constexpr float kMinLodGain = 0.85f; // Largest fraction of the previous level's triangles kept
+constexpr float kMaxLodError = 0.05f;
+constexpr size_t kMinLodTriangles = 32;
+
+constexpr uint32_t kNoVertex = std::numeric_limits<uint32_t>::max();
+
+// Sum of squared distances to a set of area-weighted planes (Garland-Heckbert error quadric).
+struct Quadric {
+    double _a00{0.0}, _a11{0.0}, _a22{0.0}, _a01{0.0}, _a02{0.0}, _a12{0.0};
+    double _b0{0.0}, _b1{0.0}, _b2{0.0}, _c{0.0};
+    double _weight{0.0};
+
+    void AddPlane(const glm::vec3& normal, float distance, double weight) {
+        const double a = normal.x, b = normal.y, c = normal.z, d = distance;
+        _a00 += weight * a * a;
+        _a11 += weight * b * b;
+        _a22 += weight * c * c;
+        _a01 += weight * a * b;
+        _a02 += weight * a * c;
+        _a12 += weight * b * c;
+        _b0 += weight * a * d;
+        _b1 += weight * b * d;
+        _b2 += weight * c * d;
+        _c += weight * d * d;
+        _weight += weight;
+    }
+
+    void Add(const Quadric& other) {
+        _a00 += other._a00;
+        _a11 += other._a11;
+        _a22 += other._a22;
+        _a01 += other._a01;
+        _a02 += other._a02;
+        _a12 += other._a12;
+        _b0 += other._b0;
+        _b1 += other._b1;
+        _b2 += other._b2;
+        _c += other._c;
+        _weight += other._weight;
+    }
+
+    // Mean squared distance of `point` to the planes.
+    double Evaluate(const glm::vec3& point) const {
+        const double x = point.x, y = point.y, z = point.z;
+        const double error = x * x * _a00 + y * y * _a11 + z * z * _a22 +
+                             2.0 * (x * y * _a01 + x * z * _a02 + y * z * _a12) +
+                             2.0 * (x * _b0 + y * _b1 + z * _b2) + _c;
+        return _weight > 0.0 ? std::abs(error) / _weight : 0.0;
+    }
+};
+
+// How a vertex may move during simplification. Border vertices sit on an open edge loop and
+// seam vertices share their position with exactly one other vertex (a UV or normal split);
+// both only slide along their loop. Anything more tangled stays put.
+enum class SimplifyVertexKind : uint8_t { Manifold, Border, Seam, Locked };
+
+struct PositionKey {
+    uint32_t _bits[3];
+    bool operator==(const PositionKey& other) const noexcept {
+        return std::memcmp(_bits, other._bits, sizeof(_bits)) == 0;
+    }
+};
+
+struct PositionKeyHash {
+    size_t operator()(const PositionKey& key) const noexcept {
+        return (key._bits[0] * 73856093u) ^ (key._bits[1] * 19349663u) ^
+               (key._bits[2] * 83492791u);
+    }
+};
+
+struct AttributeKey {
+    uint32_t _position[3];
+    uint32_t _normal[3];
+    uint32_t _texCoords[4];
+    uint32_t _color[4];
+    uint32_t _handedness;
+    bool operator==(const AttributeKey& other) const noexcept {
+        return std::memcmp(this, &other, sizeof(AttributeKey)) == 0;
+    }
+};
+
+struct AttributeKeyHash {
+    size_t operator()(const AttributeKey& key) const noexcept {
+        // FNV-1a over the raw bytes, like VertexHash.
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&key);
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < sizeof(AttributeKey); ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+float PointTriangleDistance(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b,
+                            const glm::vec3& c) {
+    // Closest point by Voronoi region (Ericson, Real-Time Collision Detection 5.1.5).
+    const glm::vec3 ab = b - a;
+    const glm::vec3 ac = c - a;
+    const glm::vec3 ap = p - a;
+    const float d1 = glm::dot(ab, ap);
+    const float d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        return glm::length(p - a);
+    }
+    const glm::vec3 bp = p - b;
+    const float d3 = glm::dot(ab, bp);
+    const float d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) {
+        return glm::length(p - b);
+    }
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return glm::length(p - (a + ab * (d1 / (d1 - d3))));
+    }
+    const glm::vec3 cp = p - c;
+    const float d5 = glm::dot(ab, cp);
+    const float d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) {
+        return glm::length(p - c);
+    }
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return glm::length(p - (a + ac * (d2 / (d2 - d6))));
+    }
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+        return glm::length(p - (b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)))));
+    }
+    const float denominator = va + vb + vc;
+    if (denominator <= 0.0f) {
+        return glm::length(p - a); // Degenerate triangle
+    }
+    return glm::length(p - (a + ab * (vb / denominator) + ac * (vc / denominator)));
+}
+
+// Largest distance from the vertices of `reference` to the surface of `simplified`, capped at
+// `limit`. Triangles are bucketed in a grid of cells at least `limit` wide, so each vertex only
+// visits its own cell and the 26 around it.
+float MeasureDeviation(const std::vector<Model::Vertex>& vertices, const uint32_t* reference,
+                       size_t referenceCount, const std::vector<uint32_t>& simplified,
+                       float limit) {
+    constexpr int kMaxCellsPerAxis = 64;
+    if (simplified.empty() || limit <= 0.0f) {
+        return limit;
+    }
+
+    glm::vec3 minBounds(std::numeric_limits<float>::max());
+    glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
+    for (size_t i = 0; i < referenceCount; ++i) {
+        minBounds = glm::min(minBounds, vertices[reference[i]]._position);
+        maxBounds = glm::max(maxBounds, vertices[reference[i]]._position);
+    }
+    const glm::vec3 extent = maxBounds - minBounds;
+    const float cellSize = std::max(
+        limit, std::max(extent.x, std::max(extent.y, extent.z)) / kMaxCellsPerAxis);
+    const glm::ivec3 cells = glm::ivec3(extent / cellSize) + 1;
+    const auto cellOf = [&](const glm::vec3& p) {
+        return glm::clamp(glm::ivec3((p - minBounds) / cellSize), glm::ivec3(0), cells - 1);
+    };
+    const auto cellIndex = [&](const glm::ivec3& cell) {
+        return static_cast<size_t>((cell.z * cells.y + cell.y) * cells.x + cell.x);
+    };
+
+    // Cell-to-triangle lists as offsets into a flat array, filled in two passes.
+    std::vector<uint32_t> offsets(static_cast<size_t>(cells.x) * cells.y * cells.z + 1, 0);
+    std::vector<uint32_t> triangles;
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<uint32_t> fill;
+        if (pass == 1) {
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+            triangles.resize(offsets.back());
+            fill.assign(offsets.begin(), offsets.end() - 1);
+        }
+        for (size_t t = 0; t < simplified.size(); t += 3) {
+            const glm::vec3& a = vertices[simplified[t + 0]]._position;
+            const glm::vec3& b = vertices[simplified[t + 1]]._position;
+            const glm::vec3& c = vertices[simplified[t + 2]]._position;
+            const glm::ivec3 first = cellOf(glm::min(a, glm::min(b, c)));
+            const glm::ivec3 last = cellOf(glm::max(a, glm::max(b, c)));
+            for (int z = first.z; z <= last.z; ++z) {
+                for (int y = first.y; y <= last.y; ++y) {
+                    for (int x = first.x; x <= last.x; ++x) {
+                        const size_t cell = cellIndex(glm::ivec3(x, y, z));
+                        if (pass == 0) {
+                            ++offsets[cell + 1];
+                        } else {
+                            triangles[fill[cell]++] = static_cast<uint32_t>(t / 3);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<uint32_t> points(reference, reference + referenceCount);
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+
+    // Points closer than the deviation found so far can't raise it, so stop looking once one
+    // is; the point's own cell is the likeliest to settle that.
+    float deviation = 0.0f;
+    for (uint32_t point : points) {
+        const glm::vec3& p = vertices[point]._position;
+        const glm::ivec3 center = cellOf(p);
+        float distance = limit;
+        const auto visit = [&](const glm::ivec3& cell) {
+            const size_t index = cellIndex(cell);
+            for (uint32_t i = offsets[index]; i < offsets[index + 1] && distance > deviation; ++i) {
+                const uint32_t* triangle = simplified.data() + triangles[i] * 3;
+                distance = std::min(distance,
+                                    PointTriangleDistance(p, vertices[triangle[0]]._position,
+                                                          vertices[triangle[1]]._position,
+                                                          vertices[triangle[2]]._position));
+            }
+        };
+
+        visit(center);
+        const glm::ivec3 first = glm::max(center - 1, glm::ivec3(0));
+        const glm::ivec3 last = glm::min(center + 1, cells - 1);
+        for (int z = first.z; z <= last.z && distance > deviation; ++z) {
+            for (int y = first.y; y <= last.y && distance > deviation; ++y) {
+                for (int x = first.x; x <= last.x && distance > deviation; ++x) {
+                    if (glm::ivec3(x, y, z) != center) {
+                        visit(glm::ivec3(x, y, z));
+                    }
+                }
+            }
+        }
+        deviation = std::max(deviation, distance);
+        if (deviation >= limit) {
+            break;
+        }
+    }
+    return deviation;
+}
+
+// Vertex-to-triangle adjacency of a local index list, as offsets into a flat triangle list.
+void BuildTriangleAdjacency(const std::vector<uint32_t>& indices, uint32_t vertexCount,
+                            std::vector<uint32_t>& offsets, std::vector<uint32_t>& triangles) {
+    offsets.assign(vertexCount + 1, 0);
+    for (uint32_t index : indices) {
+        ++offsets[index + 1];
+    }
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+    triangles.resize(indices.size());
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
     }
 }
 
@@ -101,7 +651,7 @@ void setTSpaceBasic(const SMikkTSpaceContext* pContext, const float tangent[3],
 
 namespace mesh_utils {
 void GenerateTangents(const Model::SubMesh& subMesh, std::vector<Model::Vertex>& vertices,
-                      std::vector<uint32_t>& indices) {
+                      const std::vector<uint32_t>& indices) {
     // Set up the MikkTSpace interface / function pointers.
     SMikkTSpaceInterface interface {};
     interface.m_getNumFaces = getNumFaces;
@@ -111,15 +661,963 @@ void GenerateTangents(const Model::SubMesh& subMesh, std::vector<Model::Vertex>&
     interface.m_getTexCoord = getTexCoord;
     interface.m_setTSpaceBasic = setTSpaceBasic;
 
+    // Gather the corners once; MikkTSpace reads each of them many times.
+    const uint32_t* cornerIndices = indices.data() + subMesh._firstIndex;
+    const size_t cornerCount = subMesh._indexCount / 3 * 3;
+    MeshData meshData;
+    meshData._positions.resize(cornerCount);
+    meshData._normals.resize(cornerCount);
+    meshData._texCoords.resize(cornerCount);
+    meshData._tangents.assign(cornerCount, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    for (size_t i = 0; i < cornerCount; ++i) {
+        const Model::Vertex& vertex = vertices[cornerIndices[i]];
+        meshData._positions[i] = vertex._position;
+        meshData._normals[i] = vertex._normal;
+        meshData._texCoords[i] = vertex._texCoord0;
+    }
+
     // Prepare the context.
     SMikkTSpaceContext context;
-    MeshData meshData = {&vertices, &indices, subMesh._firstIndex, subMesh._indexCount};
     context.m_pUserData = &meshData;
     context.m_pInterface = &interface;
 
     if (!genTangSpaceDefault(&context)) {
         std::cerr << "Failed to generate tangents!" << std::endl;
+        return;
+    }
+
+    // Corners sharing a vertex agree unless MikkTSpace split it; the last corner wins.
+    for (size_t i = 0; i < cornerCount; ++i) {
+        vertices[cornerIndices[i]]._tangent = meshData._tangents[i];
+    }
+}
+
+void GenerateTangentsFast(const Model::SubMesh& subMesh, std::vector<Model::Vertex>& vertices,
+                          const std::vector<uint32_t>& indices) {
+    // The kernels address the submesh's own vertices; anything else goes through MikkTSpace.
+    const uint32_t* first = indices.data() + subMesh._firstIndex;
+    const size_t triangleCount = subMesh._indexCount / 3;
+    const bool local = std::all_of(first, first + triangleCount * 3, [&](uint32_t index) {
+        return index >= subMesh._firstVertex && index - subMesh._firstVertex < subMesh._vertexCount;
+    });
+    if (!local) {
+        GenerateTangents(subMesh, vertices, indices);
+        return;
+    }
+
+    Model::Vertex* subMeshVertices = vertices.data() + subMesh._firstVertex;
+    std::vector<glm::vec4> frames(static_cast<size_t>(subMesh._vertexCount) * 2, glm::vec4(0.0f));
+    vertex_kernels::AccumulateTangentFrames(subMeshVertices, first, triangleCount,
+                                            subMesh._firstVertex, frames.data());
+    vertex_kernels::OrthonormalizeTangentFrames(frames.data(), subMesh._vertexCount,
+                                                subMeshVertices);
+}
+
+void CompareTangents(const glm::vec4* reference, const Model::Vertex* vertices, size_t count,
+                     TangentDeviation& deviation) {
+    constexpr double kDegreesPerRadian = 57.29577951308232;
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec3 a(reference[i]);
+        const glm::vec3 b(vertices[i]._tangent);
+        const float lengths = std::sqrt(glm::dot(a, a) * glm::dot(b, b));
+        const float cosine = lengths > 0.0f ? glm::dot(a, b) / lengths : 1.0f;
+        const auto degrees = static_cast<float>(
+            std::acos(std::clamp(static_cast<double>(cosine), -1.0, 1.0)) * kDegreesPerRadian);
+        deviation._totalDegrees += degrees;
+        deviation._maxDegrees = std::max(deviation._maxDegrees, degrees);
+        deviation._handednessMismatches += reference[i].w != vertices[i]._tangent.w ? 1 : 0;
+    }
+    deviation._vertexCount += count;
+}
+
+void WeldVertices(std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices) {
+    std::unordered_map<const Model::Vertex*, uint32_t, VertexHash, VertexBitwiseEqual> unique;
+    unique.reserve(vertices.size());
+
+    std::vector<uint32_t> remap(vertices.size());
+    std::vector<Model::Vertex> welded;
+    welded.reserve(vertices.size());
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const auto [iter, inserted] =
+            unique.emplace(&vertices[i], static_cast<uint32_t>(welded.size()));
+        if (inserted) {
+            welded.push_back(vertices[i]);
+        }
+        remap[i] = iter->second;
+    }
+
+    for (uint32_t& index : indices) {
+        index = remap[index];
+    }
+    vertices = std::move(welded);
+}
+
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // Vertex -> triangle adjacency. The first liveCount[v] entries of a vertex's list are the
+    // triangles that still have to be emitted.
+    std::vector<uint32_t> liveCount(vertexCount, 0);
+    for (uint32_t index : indices) {
+        ++liveCount[index];
+    }
+
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] = offsets[v] + liveCount[v];
+    }
+
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        vertexScore[v] = ForsythVertexScore(-1, liveCount[v]);
+    }
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    size_t bestTriangle = 0;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        triangleScore[t] = vertexScore[indices[t * 3 + 0]] + vertexScore[indices[t * 3 + 1]] +
+                           vertexScore[indices[t * 3 + 2]];
+        if (triangleScore[t] > triangleScore[bestTriangle]) {
+            bestTriangle = t;
+        }
+    }
+
+    std::vector<uint32_t> output(indices.size());
+    uint32_t cache[kForsythCacheSize + 3];
+    size_t cacheCount = 0;
+    size_t nextUnemitted = 0; // Restart point when the cache holds no usable triangle
+
+    for (size_t t = 0; t < triangleCount; ++t) {
+        if (bestTriangle == std::numeric_limits<size_t>::max()) {
+            while (emitted[nextUnemitted]) {
+                ++nextUnemitted;
+            }
+            bestTriangle = nextUnemitted;
+        }
+
+        const uint32_t* triangle = &indices[bestTriangle * 3];
+        std::copy(triangle, triangle + 3, &output[t * 3]);
+        emitted[bestTriangle] = 1;
+
+        // Retire the triangle from its vertices' live lists.
+        for (size_t k = 0; k < 3; ++k) {
+            const uint32_t v = triangle[k];
+            uint32_t* live = &adjacency[offsets[v]];
+            uint32_t* last = live + liveCount[v] - 1;
+            *std::find(live, last + 1, static_cast<uint32_t>(bestTriangle)) = *last;
+            --liveCount[v];
+        }
+
+        // The triangle's vertices move to the front of the LRU cache.
+        uint32_t newCache[kForsythCacheSize + 3];
+        size_t newCount = 0;
+        for (size_t k = 0; k < 3; ++k) {
+            if (std::find(newCache, newCache + newCount, triangle[k]) == newCache + newCount) {
+                newCache[newCount++] = triangle[k];
+            }
+        }
+        for (size_t i = 0; i < cacheCount; ++i) {
+            if (std::find(triangle, triangle + 3, cache[i]) == triangle + 3) {
+                newCache[newCount++] = cache[i];
+            }
+        }
+
+        // Rescore everything that moved (including vertices pushed out of the cache) and pick
+        // the best triangle among their remaining ones.
+        for (size_t i = 0; i < newCount; ++i) {
+            const uint32_t v = newCache[i];
+            cachePosition[v] = i < kForsythCacheSize ? static_cast<int>(i) : -1;
+            vertexScore[v] = ForsythVertexScore(cachePosition[v], liveCount[v]);
+        }
+
+        bestTriangle = std::numeric_limits<size_t>::max();
+        float bestScore = -1.0f;
+        for (size_t i = 0; i < newCount; ++i) {
+            const uint32_t v = newCache[i];
+            for (uint32_t j = 0; j < liveCount[v]; ++j) {
+                const uint32_t candidate = adjacency[offsets[v] + j];
+                const float score = vertexScore[indices[candidate * 3 + 0]] +
+                                    vertexScore[indices[candidate * 3 + 1]] +
+                                    vertexScore[indices[candidate * 3 + 2]];
+                triangleScore[candidate] = score;
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestTriangle = candidate;
+                }
+            }
+        }
+
+        cacheCount = std::min(newCount, kForsythCacheSize);
+        std::copy(newCache, newCache + cacheCount, cache);
+    }
+
+    indices = std::move(output);
+}
+
+void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Model::Vertex>& vertices,
+                      float threshold) {
+    if (indices.size() / 3 <= kMinClusterTriangles) {
+        return;
+    }
+
+    const VertexCacheStats stats =
+        AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+    const float maxMisses = threshold * static_cast<float>(stats._cacheMisses);
+
+    // Cutting patches further gives the sort more freedom but costs cache misses at every cut;
+    // keep the first order that stays within `threshold` of the input's misses, else the input.
+    for (const bool split : {true, false}) {
+        const std::vector<TriangleCluster> clusters =
+            BuildOverdrawClusters(indices, vertices.size(), threshold, split);
+        if (clusters.size() < 2) {
+            return;
+        }
+
+        std::vector<uint32_t> output = SortOverdrawClusters(indices, vertices, clusters);
+        const VertexCacheStats sorted =
+            AnalyzeVertexCache(output.data(), output.size(), vertices.size());
+        if (static_cast<float>(sorted._cacheMisses) <= maxMisses) {
+            indices = std::move(output);
+            return;
+        }
+    }
+}
+
+void OptimizeVertexFetch(std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices) {
+    constexpr uint32_t kUnused = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(vertices.size(), kUnused);
+    uint32_t nextVertex = 0;
+
+    for (uint32_t& index : indices) {
+        if (remap[index] == kUnused) {
+            remap[index] = nextVertex++;
+        }
+        index = remap[index];
+    }
+
+    std::vector<Model::Vertex> reordered(nextVertex);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        if (remap[i] != kUnused) {
+            reordered[remap[i]] = vertices[i];
+        }
+    }
+    vertices = std::move(reordered);
+}
+
+VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount,
+                                    size_t vertexCount) {
+    VertexCacheStats stats;
+    stats._triangleCount = indexCount / 3;
+
+    // A vertex is in the FIFO if fewer than kAnalyzeCacheSize misses happened since it entered.
+    std::vector<uint32_t> timestamps(vertexCount, 0);
+    uint32_t time = kAnalyzeCacheSize + 1;
+    for (size_t i = 0; i < indexCount; ++i) {
+        uint32_t& timestamp = timestamps[indices[i]];
+        if (timestamp == 0) {
+            ++stats._vertexCount;
+        }
+        if (time - timestamp > kAnalyzeCacheSize) {
+            timestamp = time++;
+            ++stats._cacheMisses;
+        }
+    }
+
+    return stats;
+}
+
+OptimizeReport OptimizeMeshes(std::vector<Model::SubMesh>& subMeshes,
+                              std::vector<Model::Vertex>& vertices,
+                              std::vector<uint32_t>& indices, const OptimizeOptions& options) {
+    struct LocalMesh {
+        std::vector<Model::Vertex> _vertices;
+        std::vector<uint32_t> _indices;
+        VertexCacheStats _before;
+        VertexCacheStats _after;
+        bool _optimized{false};
+    };
+    std::vector<LocalMesh> meshes(subMeshes.size());
+
+    // Every submesh is optimized on its own copy, with indices relative to its vertices.
+    ThreadPool::Shared().ParallelFor(subMeshes.size(), [&](size_t i) {
+        const Model::SubMesh& subMesh = subMeshes[i];
+        LocalMesh& mesh = meshes[i];
+        mesh._vertices.assign(vertices.begin() + subMesh._firstVertex,
+                              vertices.begin() + subMesh._firstVertex + subMesh._vertexCount);
+        mesh._indices.assign(indices.begin() + subMesh._firstIndex,
+                             indices.begin() + subMesh._firstIndex + subMesh._indexCount);
+
+        bool valid = mesh._indices.size() % 3 == 0;
+        for (uint32_t& index : mesh._indices) {
+            index -= subMesh._firstVertex;
+            valid = valid && index < subMesh._vertexCount;
+        }
+        if (!valid) {
+            std::cerr << "Skipping optimization of submesh " << i << ": malformed indices"
+                      << std::endl;
+            return;
+        }
+
+        mesh._before =
+            AnalyzeVertexCache(mesh._indices.data(), mesh._indices.size(), mesh._vertices.size());
+
+        WeldVertices(mesh._vertices, mesh._indices);
+        OptimizeVertexCache(mesh._indices, mesh._vertices.size());
+        if (options._reduceOverdraw) {
+            OptimizeOverdraw(mesh._indices, mesh._vertices);
+        }
+        OptimizeVertexFetch(mesh._vertices, mesh._indices);
+
+        mesh._after =
+            AnalyzeVertexCache(mesh._indices.data(), mesh._indices.size(), mesh._vertices.size());
+        mesh._optimized = true;
+    });
+
+    // Repack the shared arrays in submesh order.
+    OptimizeReport report;
+    report._vertexCountBefore = vertices.size();
+
+    std::vector<Model::Vertex> packedVertices;
+    std::vector<uint32_t> packedIndices;
+    packedVertices.reserve(vertices.size());
+    packedIndices.reserve(indices.size());
+
+    for (size_t i = 0; i < subMeshes.size(); ++i) {
+        Model::SubMesh& subMesh = subMeshes[i];
+        LocalMesh& mesh = meshes[i];
+        const uint32_t firstVertex = static_cast<uint32_t>(packedVertices.size());
+        const uint32_t firstIndex = static_cast<uint32_t>(packedIndices.size());
+
+        if (!mesh._optimized) {
+            // Keep the original data, rebased.
+            packedVertices.insert(packedVertices.end(), vertices.begin() + subMesh._firstVertex,
+                                  vertices.begin() + subMesh._firstVertex + subMesh._vertexCount);
+            for (uint32_t k = 0; k < subMesh._indexCount; ++k) {
+                packedIndices.push_back(indices[subMesh._firstIndex + k] - subMesh._firstVertex +
+                                        firstVertex);
+            }
+        } else {
+            packedVertices.insert(packedVertices.end(), mesh._vertices.begin(),
+                                  mesh._vertices.end());
+            for (uint32_t index : mesh._indices) {
+                packedIndices.push_back(firstVertex + index);
+            }
+            subMesh._vertexCount = static_cast<uint32_t>(mesh._vertices.size());
+        }
+
+        subMesh._firstVertex = firstVertex;
+        subMesh._firstIndex = firstIndex;
+        AccumulateStats(report._before, mesh._before);
+        AccumulateStats(report._after, mesh._after);
+    }
+
+    vertices = std::move(packedVertices);
+    indices = std::move(packedIndices);
+    report._vertexCountAfter = vertices.size();
+    return report;
+}
+
+IndexBuffers BuildIndexBuffers(const std::vector<Model::SubMesh>& subMeshes,
+                               const std::vector<Model::Lod>& lods,
+                               const std::vector<uint32_t>& indices) {
+    IndexBuffers buffers;
+    buffers._ranges.resize(subMeshes.size());
+    buffers._lodFirstIndices.resize(lods.size());
+
+    for (size_t i = 0; i < subMeshes.size(); ++i) {
+        const Model::SubMesh& subMesh = subMeshes[i];
+        IndexBuffers::Range& range = buffers._ranges[i];
+        const uint32_t* first = indices.data() + subMesh._firstIndex;
+        const uint32_t* last = first + subMesh._indexCount;
+
+        // Local indices must stay within the submesh's vertices for the base vertex to apply.
+        bool local = subMesh._firstVertex <=
+                     static_cast<uint32_t>(std::numeric_limits<int32_t>::max());
+        uint32_t maxLocalIndex = 0;
+        for (const uint32_t* index = first; local && index != last; ++index) {
+            const uint32_t localIndex = *index - subMesh._firstVertex;
+            local = *index >= subMesh._firstVertex && localIndex < subMesh._vertexCount;
+            maxLocalIndex = std::max(maxLocalIndex, localIndex);
+        }
+
+        range._baseVertex = local ? static_cast<int32_t>(subMesh._firstVertex) : 0;
+        range._is16Bit = local && maxLocalIndex <= std::numeric_limits<uint16_t>::max();
+
+        // LODs only reference their submesh's vertices, so the same format fits them.
+        const auto append = [&](uint32_t firstIndex, uint32_t indexCount) {
+            const uint32_t* begin = indices.data() + firstIndex;
+            const uint32_t baseVertex = static_cast<uint32_t>(range._baseVertex);
+            if (range._is16Bit) {
+                const auto offset = static_cast<uint32_t>(buffers._indices16.size());
+                for (const uint32_t* index = begin; index != begin + indexCount; ++index) {
+                    buffers._indices16.push_back(static_cast<uint16_t>(*index - baseVertex));
+                }
+                return offset;
+            }
+            const auto offset = static_cast<uint32_t>(buffers._indices32.size());
+            for (const uint32_t* index = begin; index != begin + indexCount; ++index) {
+                buffers._indices32.push_back(*index - baseVertex);
+            }
+            return offset;
+        };
+
+        range._firstIndex = append(subMesh._firstIndex, static_cast<uint32_t>(last - first));
+        for (uint32_t level = 0; level < subMesh._lodCount; ++level) {
+            const Model::Lod& lod = lods[subMesh._firstLod + level];
+            buffers._lodFirstIndices[subMesh._firstLod + level] =
+                append(lod._firstIndex, lod._indexCount);
+        }
+    }
+
+    if (buffers._indices16.size() % 2 != 0) {
+        buffers._indices16.push_back(0);
+    }
+    return buffers;
+}
+
+std::vector<uint32_t> SimplifyMesh(const uint32_t* indices, size_t indexCount,
+                                   const std::vector<Model::Vertex>& vertices,
+                                   size_t targetIndexCount, float maxError, float& resultError) {
+    std::vector<uint32_t> result(indices, indices + indexCount / 3 * 3);
+    resultError = 0.0f;
+    if (result.empty()) {
+        return result;
+    }
+
+    // Work on local indices over the span the mesh uses.
+    const auto [minIt, maxIt] = std::minmax_element(result.begin(), result.end());
+    const uint32_t minIndex = *minIt;
+    const uint32_t span = *maxIt - minIndex + 1;
+    for (uint32_t& index : result) {
+        index -= minIndex;
+    }
+    const auto position = [&](uint32_t v) -> const glm::vec3& {
+        return vertices[minIndex + v]._position;
+    };
+
+    // Vertices that only differ in their tangent direction (per-face tangents of unwelded
+    // sources) would look like a many-way seam; treat them as one and keep the first.
+    {
+        std::unordered_map<AttributeKey, uint32_t, AttributeKeyHash> firstByAttributes;
+        firstByAttributes.reserve(span);
+        std::vector<uint32_t> canonical(span);
+        for (uint32_t v = 0; v < span; ++v) {
+            const Model::Vertex& vertex = vertices[minIndex + v];
+            AttributeKey key{};
+            std::memcpy(key._position, &vertex._position, sizeof(key._position));
+            std::memcpy(key._normal, &vertex._normal, sizeof(key._normal));
+            std::memcpy(key._texCoords, &vertex._texCoord0, sizeof(float) * 2);
+            std::memcpy(key._texCoords + 2, &vertex._texCoord1, sizeof(float) * 2);
+            std::memcpy(key._color, &vertex._color, sizeof(key._color));
+            key._handedness = vertex._tangent.w < 0.0f ? 1 : 0;
+            canonical[v] = firstByAttributes.emplace(key, v).first->second;
+        }
+        for (uint32_t& index : result) {
+            index = canonical[index];
+        }
+    }
+
+    // Vertices sharing a position are linked in a ring through `nextTwin`; `group` names the
+    // ring by its first vertex, which also holds the ring's quadric.
+    std::vector<uint32_t> group(span);
+    std::vector<uint32_t> nextTwin(span);
+    std::vector<uint32_t> groupSize(span, 0);
+    {
+        std::unordered_map<PositionKey, uint32_t, PositionKeyHash> firstByPosition;
+        firstByPosition.reserve(span);
+        std::vector<uint8_t> referenced(span, 0);
+        for (uint32_t index : result) {
+            referenced[index] = 1;
+        }
+        for (uint32_t v = 0; v < span; ++v) {
+            if (!referenced[v]) {
+                group[v] = v;
+                nextTwin[v] = v;
+                continue;
+            }
+            PositionKey key;
+            std::memcpy(key._bits, &position(v), sizeof(key._bits));
+            const auto [it, inserted] = firstByPosition.emplace(key, v);
+            const uint32_t first = it->second;
+            group[v] = first;
+            nextTwin[v] = inserted ? v : nextTwin[first];
+            nextTwin[first] = v;
+            ++groupSize[first];
+        }
+    }
+
+    // Open edges: directed edges whose reverse is missing. They trace both mesh borders and
+    // attribute seams (where the two sides use different vertices).
+    std::vector<uint32_t> openNext(span, kNoVertex);
+    std::vector<uint32_t> openPrev(span, kNoVertex);
+    std::vector<uint8_t> openCount(span, 0);
+    std::vector<std::pair<uint32_t, uint32_t>> openEdges;
+    {
+        std::unordered_set<uint64_t> edges;
+        edges.reserve(result.size());
+        const auto edgeKey = [](uint32_t a, uint32_t b) { return (uint64_t(a) << 32) | b; };
+        for (size_t t = 0; t < result.size(); t += 3) {
+            for (size_t k = 0; k < 3; ++k) {
+                edges.insert(edgeKey(result[t + k], result[t + (k + 1) % 3]));
+            }
+        }
+        for (size_t t = 0; t < result.size(); t += 3) {
+            for (size_t k = 0; k < 3; ++k) {
+                const uint32_t a = result[t + k];
+                const uint32_t b = result[t + (k + 1) % 3];
+                if (!edges.contains(edgeKey(b, a))) {
+                    openNext[a] = b;
+                    openPrev[b] = a;
+                    ++openCount[a];
+                    ++openCount[b];
+                    openEdges.emplace_back(a, b);
+                }
+            }
+        }
+    }
+
+    std::vector<SimplifyVertexKind> kind(span, SimplifyVertexKind::Locked);
+    for (uint32_t v = 0; v < span; ++v) {
+        const uint32_t size = groupSize[group[v]];
+        if (openCount[v] == 0) {
+            kind[v] = size == 1 ? SimplifyVertexKind::Manifold : SimplifyVertexKind::Locked;
+        } else if (openCount[v] == 2 && openNext[v] != kNoVertex && openPrev[v] != kNoVertex) {
+            kind[v] = size == 1   ? SimplifyVertexKind::Border
+                      : size == 2 ? SimplifyVertexKind::Seam
+                                  : SimplifyVertexKind::Locked;
+        }
+    }
+
+    // Area-weighted triangle planes, plus planes through open edges (perpendicular to their
+    // triangle) that keep borders and seams from drifting.
+    std::vector<Quadric> quadrics(span);
+    for (size_t t = 0; t < result.size(); t += 3) {
+        const glm::vec3& p0 = position(result[t + 0]);
+        const glm::vec3 normal = glm::cross(position(result[t + 1]) - p0,
+                                            position(result[t + 2]) - p0);
+        const float length = glm::length(normal);
+        if (length <= 0.0f) {
+            continue;
+        }
+        const glm::vec3 unitNormal = normal / length;
+        for (size_t k = 0; k < 3; ++k) {
+            quadrics[group[result[t + k]]].AddPlane(unitNormal, -glm::dot(unitNormal, p0),
+                                                    0.5 * length);
+        }
+    }
+    for (size_t t = 0; t < result.size(); t += 3) {
+        for (size_t k = 0; k < 3; ++k) {
+            const uint32_t a = result[t + k];
+            const uint32_t b = result[t + (k + 1) % 3];
+            if (openNext[a] != b) {
+                continue;
+            }
+            const glm::vec3& pa = position(a);
+            const glm::vec3 edge = position(b) - pa;
+            const glm::vec3 normal = glm::cross(edge, position(result[t + (k + 2) % 3]) - pa);
+            const glm::vec3 edgeNormal = glm::cross(edge, normal);
+            const float length = glm::length(edgeNormal);
+            if (length <= 0.0f) {
+                continue;
+            }
+            const glm::vec3 unitNormal = edgeNormal / length;
+            const double weight = kBorderWeight * glm::dot(edge, edge);
+            quadrics[group[a]].AddPlane(unitNormal, -glm::dot(unitNormal, pa), weight);
+            quadrics[group[b]].AddPlane(unitNormal, -glm::dot(unitNormal, pa), weight);
+        }
+    }
+
+    // The other vertex of a seam pair, and the vertex it must collapse to alongside `from -> to`.
+    const auto twinTarget = [&](uint32_t from, uint32_t to, uint32_t& twin) {
+        twin = nextTwin[from];
+        const uint32_t next = openNext[twin];
+        const uint32_t prev = openPrev[twin];
+        if (next != kNoVertex && group[next] == group[to]) {
+            return next;
+        }
+        if (prev != kNoVertex && group[prev] == group[to]) {
+            return prev;
+        }
+        return kNoVertex;
+    };
+
+    const auto canCollapse = [&](uint32_t from, uint32_t to) {
+        if (group[from] == group[to]) {
+            return false;
+        }
+        switch (kind[from]) {
+        case SimplifyVertexKind::Manifold:
+            return true;
+        case SimplifyVertexKind::Border:
+            return openNext[from] == to || openPrev[from] == to;
+        case SimplifyVertexKind::Seam: {
+            uint32_t twin = kNoVertex;
+            return (openNext[from] == to || openPrev[from] == to) &&
+                   twinTarget(from, to, twin) != kNoVertex;
+        }
+        default:
+            return false;
+        }
+    };
+
+    struct Collapse {
+        uint32_t _from{0};
+        uint32_t _to{0};
+        double _error{0.0};
+    };
+
+    std::vector<uint32_t> adjacencyOffsets;
+    std::vector<uint32_t> adjacency;
+    std::vector<uint32_t> remap(span);
+    std::vector<uint8_t> locked(span);
+    std::vector<Collapse> collapses;
+    const double maxErrorSquared = static_cast<double>(maxError) * maxError;
+    double largestError = 0.0;
+
+    // Rejects collapses that would flip (or nearly flip) a surviving triangle around `from`.
+    const auto keepsOrientation = [&](uint32_t from, uint32_t to) {
+        const glm::vec3& target = position(to);
+        for (uint32_t a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1]; ++a) {
+            const uint32_t* triangle = result.data() + adjacency[a] * 3;
+            if (group[triangle[0]] == group[to] || group[triangle[1]] == group[to] ||
+                group[triangle[2]] == group[to]) {
+                continue; // Degenerates and disappears.
+            }
+            glm::vec3 corners[3] = {position(triangle[0]), position(triangle[1]),
+                                    position(triangle[2])};
+            const glm::vec3 before =
+                glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+            for (glm::vec3& corner : corners) {
+                corner = corner == position(from) ? target : corner;
+            }
+            const glm::vec3 after = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+            const float lengths = glm::length(before) * glm::length(after);
+            if (glm::dot(before, after) < kMinFlipCosine * lengths) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    const auto lockNeighborhood = [&](uint32_t vertex) {
+        for (uint32_t a = adjacencyOffsets[vertex]; a < adjacencyOffsets[vertex + 1]; ++a) {
+            const uint32_t* triangle = result.data() + adjacency[a] * 3;
+            for (uint32_t k = 0; k < 3; ++k) {
+                locked[group[triangle[k]]] = 1;
+            }
+        }
+    };
+
+    // Keeps the open edge loops consistent after `from` merges into its loop neighbour `to`.
+    const auto mergeOpenEdges = [&](uint32_t from, uint32_t to) {
+        if (openNext[from] == to) {
+            openPrev[to] = openPrev[from];
+            if (openPrev[from] != kNoVertex) {
+                openNext[openPrev[from]] = to;
+            }
+        } else if (openPrev[from] == to) {
+            openNext[to] = openNext[from];
+            if (openNext[from] != kNoVertex) {
+                openPrev[openNext[from]] = to;
+            }
+        }
+    };
+
+    while (result.size() > targetIndexCount) {
+        const size_t triangleCount = result.size() / 3;
+        BuildTriangleAdjacency(result, span, adjacencyOffsets, adjacency);
+
+        collapses.clear();
+        for (size_t t = 0; t < result.size(); t += 3) {
+            for (size_t k = 0; k < 3; ++k) {
+                const uint32_t a = result[t + k];
+                const uint32_t b = result[t + (k + 1) % 3];
+                for (const auto& [from, to] : {std::pair(a, b), std::pair(b, a)}) {
+                    if (canCollapse(from, to)) {
+                        Quadric quadric = quadrics[group[from]];
+                        quadric.Add(quadrics[group[to]]);
+                        collapses.push_back({from, to, quadric.Evaluate(position(to))});
+                    }
+                }
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(),
+                  [](const Collapse& a, const Collapse& b) { return a._error < b._error; });
+
+        // Each collapse removes about two triangles; vertices next to a collapse wait for the
+        // next pass so that every orientation check sees final positions.
+        // Candidates far worse than the cheapest `budget` ones wait as well; their neighbours
+        // may offer cheaper collapses once the mesh has changed.
+        const size_t budget = (triangleCount - targetIndexCount / 3) / 2 + 1;
+        const double passErrorLimit =
+            collapses.empty() ? 0.0
+                              : collapses[std::min(budget, collapses.size()) - 1]._error *
+                                    kPassErrorSlack;
+        size_t applied = 0;
+        std::iota(remap.begin(), remap.end(), 0u);
+        std::fill(locked.begin(), locked.end(), 0);
+
+        for (const Collapse& collapse : collapses) {
+            if (collapse._error > maxErrorSquared || applied >= budget ||
+                (applied > 0 && collapse._error > passErrorLimit)) {
+                break;
+            }
+            const uint32_t from = collapse._from;
+            const uint32_t to = collapse._to;
+            if (locked[group[from]] || locked[group[to]]) {
+                continue;
+            }
+
+            uint32_t twin = kNoVertex;
+            uint32_t twinTo = kNoVertex;
+            if (kind[from] == SimplifyVertexKind::Seam) {
+                twinTo = twinTarget(from, to, twin);
+                if (twinTo == kNoVertex || !keepsOrientation(twin, twinTo)) {
+                    continue;
+                }
+            }
+            if (!keepsOrientation(from, to)) {
+                continue;
+            }
+
+            lockNeighborhood(from);
+            remap[from] = to;
+            mergeOpenEdges(from, to);
+            if (twin != kNoVertex) {
+                lockNeighborhood(twin);
+                remap[twin] = twinTo;
+                mergeOpenEdges(twin, twinTo);
+            }
+            quadrics[group[to]].Add(quadrics[group[from]]);
+            largestError = std::max(largestError, collapse._error);
+            ++applied;
+        }
+
+        if (applied == 0) {
+            break;
+        }
+
+        // Apply the pass and drop the triangles that lost their area.
+        size_t written = 0;
+        for (size_t t = 0; t < result.size(); t += 3) {
+            const uint32_t a = remap[result[t + 0]];
+            const uint32_t b = remap[result[t + 1]];
+            const uint32_t c = remap[result[t + 2]];
+            if (group[a] == group[b] || group[b] == group[c] || group[c] == group[a]) {
+                continue;
+            }
+            result[written++] = a;
+            result[written++] = b;
+            result[written++] = c;
+        }
+        result.resize(written);
+    }
+
+    for (uint32_t& index : result) {
+        index += minIndex;
+    }
+    resultError = static_cast<float>(std::sqrt(largestError));
+    return result;
+}
+
+void GenerateLods(std::vector<Model::SubMesh>& subMeshes,
+                  const std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices,
+                  std::vector<Model::Lod>& lods) {
+    struct LodChain {
+        std::vector<std::vector<uint32_t>> _indices;
+        std::vector<float> _errors;
+    };
+    std::vector<LodChain> chains(subMeshes.size());
+
+    // Each level is simplified from the previous one, but its error is measured against the
+    // full-detail surface: the quadric estimate averages over planes and runs low.
+    ThreadPool::Shared().ParallelFor(subMeshes.size(), [&](size_t s) {
+        const Model::SubMesh& subMesh = subMeshes[s];
+        const float maxError = kMaxLodError * glm::length(subMesh._maxBounds - subMesh._minBounds);
+        const uint32_t* fullDetail = indices.data() + subMesh._firstIndex;
+        std::vector<uint32_t> current(fullDetail, fullDetail + subMesh._indexCount);
+
+        for (size_t level = 0; level < kMaxLodLevels; ++level) {
+            const size_t triangleCount = current.size() / 3;
+            if (triangleCount < kMinLodTriangles) {
+                break;
+            }
+
+            const size_t target = static_cast<size_t>(triangleCount * kLodReduction) * 3;
+            float levelError = 0.0f;
+            std::vector<uint32_t> simplified = SimplifyMesh(current.data(), current.size(),
+                                                            vertices, target, maxError, levelError);
+            if (simplified.size() > current.size() * kMinLodGain) {
+                break;
+            }
+            const float error = MeasureDeviation(vertices, fullDetail, subMesh._indexCount,
+                                                 simplified, maxError);
+            if (error >= maxError) {
+                break;
+            }
+
+            // Coarse levels are drawn from afar just as often; keep them cache friendly.
+            const bool local = std::all_of(simplified.begin(), simplified.end(), [&](uint32_t i) {
+                return i >= subMesh._firstVertex && i - subMesh._firstVertex < subMesh._vertexCount;
+            });
+            if (local) {
+                for (uint32_t& index : simplified) {
+                    index -= subMesh._firstVertex;
+                }
+                OptimizeVertexCache(simplified, subMesh._vertexCount);
+                for (uint32_t& index : simplified) {
+                    index += subMesh._firstVertex;
+                }
+            }
+
+            chains[s]._indices.push_back(simplified);
+            chains[s]._errors.push_back(error);
+            current = std::move(simplified);
+        }
+    });
+
+    // LOD ranges go after every submesh's own range, leaving those untouched.
+    lods.clear();
+    for (size_t s = 0; s < subMeshes.size(); ++s) {
+        subMeshes[s]._firstLod = static_cast<uint32_t>(lods.size());
+        subMeshes[s]._lodCount = static_cast<uint32_t>(chains[s]._indices.size());
+        for (size_t level = 0; level < chains[s]._indices.size(); ++level) {
+            const std::vector<uint32_t>& levelIndices = chains[s]._indices[level];
+            lods.push_back({._firstIndex = static_cast<uint32_t>(indices.size()),
+                            ._indexCount = static_cast<uint32_t>(levelIndices.size()),
+                            ._error = chains[s]._errors[level]});
+            indices.insert(indices.end(), levelIndices.begin(), levelIndices.end());
+        }
+    }
+}
+
+void BuildMeshlets(std::vector<Model::SubMesh>& subMeshes,
+                   const std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices,
+                   std::vector<Model::Meshlet>& meshlets) {
+    std::vector<std::vector<Model::Meshlet>> subMeshMeshlets(subMeshes.size());
+
+    // Submeshes own disjoint index ranges, so they can be reordered independently.
+    ThreadPool::Shared().ParallelFor(subMeshes.size(), [&](size_t s) {
+        const Model::SubMesh& subMesh = subMeshes[s];
+        uint32_t* subMeshIndices = indices.data() + subMesh._firstIndex;
+        const uint32_t triangleCount = subMesh._indexCount / 3;
+        if (triangleCount == 0) {
+            return;
+        }
+
+        // Vertex-to-triangle adjacency over the index span the submesh actually uses.
+        const auto [minIt, maxIt] =
+            std::minmax_element(subMeshIndices, subMeshIndices + triangleCount * 3);
+        const uint32_t minIndex = *minIt;
+        const uint32_t span = *maxIt - minIndex + 1;
+
+        std::vector<uint32_t> adjacencyOffsets(span + 1, 0);
+        for (uint32_t i = 0; i < triangleCount * 3; ++i) {
+            ++adjacencyOffsets[subMeshIndices[i] - minIndex + 1];
+        }
+        for (uint32_t v = 0; v < span; ++v) {
+            adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+        }
+        std::vector<uint32_t> adjacency(triangleCount * 3);
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (uint32_t i = 0; i < triangleCount * 3; ++i) {
+            adjacency[fill[subMeshIndices[i] - minIndex]++] = i / 3;
+        }
+
+        const std::vector<uint32_t> source(subMeshIndices, subMeshIndices + triangleCount * 3);
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<uint32_t> vertexMeshlet(span, std::numeric_limits<uint32_t>::max());
+        std::vector<uint32_t> meshletVertices;
+        meshletVertices.reserve(kMaxMeshletVertices);
+        std::vector<Model::Meshlet>& output = subMeshMeshlets[s];
+        uint32_t nextTriangle = 0; // Seed for a new meshlet when nothing adjacent is left
+        uint32_t written = 0;
+
+        const auto newVertexCount = [&](uint32_t triangle) {
+            const uint32_t current = static_cast<uint32_t>(output.size() - 1);
+            uint32_t count = 0;
+            for (uint32_t k = 0; k < 3; ++k) {
+                count += vertexMeshlet[source[triangle * 3 + k] - minIndex] != current ? 1 : 0;
+            }
+            return count;
+        };
+
+        output.push_back({._firstIndex = subMesh._firstIndex});
+        for (uint32_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+            // Prefer the adjacent triangle that adds the fewest vertices to the meshlet.
+            uint32_t best = triangleCount;
+            uint32_t bestNewVertices = 4;
+            for (size_t v = 0; v < meshletVertices.size() && bestNewVertices > 0; ++v) {
+                const uint32_t vertex = meshletVertices[v];
+                for (uint32_t a = adjacencyOffsets[vertex]; a < adjacencyOffsets[vertex + 1]; ++a) {
+                    const uint32_t triangle = adjacency[a];
+                    if (emitted[triangle]) {
+                        continue;
+                    }
+                    const uint32_t count = newVertexCount(triangle);
+                    if (count < bestNewVertices) {
+                        best = triangle;
+                        bestNewVertices = count;
+                    }
+                }
+            }
+
+            if (best == triangleCount) {
+                while (emitted[nextTriangle]) {
+                    ++nextTriangle;
+                }
+                best = nextTriangle;
+                bestNewVertices = newVertexCount(best);
+            }
+
+            // Start the next meshlet from the triangle that didn't fit, to keep locality.
+            Model::Meshlet* meshlet = &output.back();
+            if (meshlet->_indexCount == kMaxMeshletTriangles * 3 ||
+                meshletVertices.size() + bestNewVertices > kMaxMeshletVertices) {
+                output.push_back({._firstIndex = subMesh._firstIndex + written});
+                meshlet = &output.back();
+                meshletVertices.clear();
+            }
+
+            emitted[best] = true;
+            for (uint32_t k = 0; k < 3; ++k) {
+                const uint32_t index = source[best * 3 + k];
+                uint32_t& owner = vertexMeshlet[index - minIndex];
+                if (owner != output.size() - 1) {
+                    owner = static_cast<uint32_t>(output.size() - 1);
+                    meshletVertices.push_back(index - minIndex);
+                }
+                subMeshIndices[written++] = index;
+            }
+            meshlet->_indexCount += 3;
+            meshlet->_vertexCount = static_cast<uint32_t>(meshletVertices.size());
+        }
+
+        for (Model::Meshlet& meshlet : output) {
+            ComputeMeshletBounds(indices.data() + meshlet._firstIndex, vertices, meshlet);
+        }
+    });
+
+    meshlets.clear();
+    for (size_t s = 0; s < subMeshes.size(); ++s) {
+        subMeshes[s]._firstMeshlet = static_cast<uint32_t>(meshlets.size());
+        subMeshes[s]._meshletCount = static_cast<uint32_t>(subMeshMeshlets[s].size());
+        meshlets.insert(meshlets.end(), subMeshMeshlets[s].begin(), subMeshMeshlets[s].end());
     }
 }
 
-} // namespace mesh_utils
\ No newline at end of file
+} // namespace mesh_utils
@@ -1,14 +1,138 @@
 /// @file  MeshUtils.h
-/// @brief Mesh processing utilities including tangent generation.
+/// @brief Mesh processing utilities including tangent generation and mesh optimization.
 
 #pragma once
 
+// Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 // Project Headers
 #include "Model.h"
 
 namespace mesh_utils {
 
+// Post-transform vertex cache behaviour of an index stream, simulated with a 16-entry FIFO.
+// ACMR = cache misses per triangle, ATVR = cache misses per referenced vertex (1.0 is optimal).
+struct VertexCacheStats {
+    size_t _triangleCount{0};
+    size_t _vertexCount{0}; // Distinct vertices referenced
+    size_t _cacheMisses{0};
+};
+
+struct OptimizeOptions {
+    bool _reduceOverdraw{false};
+};
+
+// Totals over every submesh, before and after optimization.
+struct OptimizeReport {
+    VertexCacheStats _before;
+    VertexCacheStats _after;
+    size_t _vertexCountBefore{0};
+    size_t _vertexCountAfter{0};
+};
+
+// GPU index data: every submesh's indices relative to its first vertex (drawn with that vertex as
+// the base vertex), narrowed to 16 bits wherever they fit.
+struct IndexBuffers {
+    struct Range {
+        uint32_t _firstIndex{0}; // Into _indices16 or _indices32
+        int32_t _baseVertex{0};
+        bool _is16Bit{false};
+    };
+
+    std::vector<uint16_t> _indices16; // Padded to an even count (4-byte buffer sizes)
+    std::vector<uint32_t> _indices32;
+    std::vector<Range> _ranges;             // One per submesh
+    std::vector<uint32_t> _lodFirstIndices; // One per LOD, in its submesh's buffer and format
+};
+
+// Angular difference between two sets of tangents for the same vertices.
+struct TangentDeviation {
+    size_t _vertexCount{0};
+    double _totalDegrees{0.0}; // Sum over the vertices, for the mean
+    float _maxDegrees{0.0f};
+    size_t _handednessMismatches{0}; // Vertices whose tangent.w differs
+};
+
+// Meshlet size limits (the usual mesh shader sweet spot, kept for compute culling).
+constexpr size_t kMaxMeshletVertices = 64;
+constexpr size_t kMaxMeshletTriangles = 124;
+
+// Fills in MikkTSpace tangents for the submesh's vertices. Safe to run on several submeshes at
+// once, since each only writes its own vertices.
 void GenerateTangents(const Model::SubMesh& subMesh, std::vector<Model::Vertex>& vertices,
-                      std::vector<uint32_t>& indices);
+                      const std::vector<uint32_t>& indices);
+
+// Faster alternative to GenerateTangents: accumulates per-triangle UV gradients over the vertex
+// and index arrays and orthonormalizes them per vertex. Unlike MikkTSpace it never splits a
+// vertex, so frames are averaged across UV mirroring seams that share vertices. Same threading
+// guarantees as GenerateTangents.
+void GenerateTangentsFast(const Model::SubMesh& subMesh, std::vector<Model::Vertex>& vertices,
+                          const std::vector<uint32_t>& indices);
+
+// Adds the angle between reference[i] and vertices[i]._tangent (xyz) for `count` vertices.
+void CompareTangents(const glm::vec4* reference, const Model::Vertex* vertices, size_t count,
+                     TangentDeviation& deviation);
+
+// The functions below work on a single mesh whose indices are relative to its own vertices.
+
+// Merges bit-identical vertices (first occurrence wins) and remaps the indices.
+void WeldVertices(std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices);
+
+// Reorders triangles for post-transform vertex cache locality (Forsyth's linear-speed
+// algorithm, tuned for a 32-entry LRU cache).
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+// Splits cache-optimized triangles into clusters wherever the cache would restart anyway (or
+// a patch's miss rate stays within `threshold` of its own), then draws clusters facing away
+// from the mesh center first, so they can occlude the rest. The new order is kept only if its
+// cache misses stay within `threshold` of the input's.
+void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Model::Vertex>& vertices,
+                      float threshold = 1.05f);
+
+// Renumbers vertices in the order the indices first use them, dropping unreferenced ones.
+void OptimizeVertexFetch(std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices);
+
+VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount,
+                                    size_t vertexCount);
+
+// Runs weld, vertex cache, optional overdraw and vertex fetch optimization on every submesh
+// (in parallel) and repacks the shared vertex and index arrays.
+OptimizeReport OptimizeMeshes(std::vector<Model::SubMesh>& subMeshes,
+                              std::vector<Model::Vertex>& vertices,
+                              std::vector<uint32_t>& indices, const OptimizeOptions& options);
+
+// Splits the shared index array into 16- and 32-bit buffers with per-submesh base vertices.
+// Submeshes with indices outside their own vertex range keep absolute 32-bit indices. LOD ranges
+// follow their submesh's format and base vertex.
+IndexBuffers BuildIndexBuffers(const std::vector<Model::SubMesh>& subMeshes,
+                               const std::vector<Model::Lod>& lods,
+                               const std::vector<uint32_t>& indices);
+
+// Collapses edges in order of quadric error until at most `targetIndexCount` indices remain or
+// the next collapse would move the surface further than `maxError` (model units). Vertices on
+// open borders and on UV/normal seams only slide along them, both sides of a seam together.
+// Vertices that only differ in tangent direction are merged first. Returns the simplified
+// indices; `resultError` receives the quadric estimate of the deviation introduced.
+std::vector<uint32_t> SimplifyMesh(const uint32_t* indices, size_t indexCount,
+                                   const std::vector<Model::Vertex>& vertices,
+                                   size_t targetIndexCount, float maxError, float& resultError);
+
+// Builds a chain of up to four coarser levels per submesh (in parallel), each about half the
+// triangles of the previous one, until a level's measured deviation from the full-detail
+// surface reaches 5% of the submesh's bounds diagonal. Appends their indices after the existing
+// ones and replaces `lods`. Sets each submesh's LOD range.
+void GenerateLods(std::vector<Model::SubMesh>& subMeshes,
+                  const std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices,
+                  std::vector<Model::Lod>& lods);
+
+// Splits every submesh (in parallel) into meshlets grown greedily over shared vertices, reorders
+// its triangles so each meshlet is a contiguous index range, and replaces `meshlets` with their
+// bounding spheres and backface cones. Sets each submesh's meshlet range.
+void BuildMeshlets(std::vector<Model::SubMesh>& subMeshes,
+                   const std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices,
+                   std::vector<Model::Meshlet>& meshlets);
 
-} // namespace mesh_utils
\ No newline at end of file
+} // namespace mesh_utils
@@ -0,0 +1,776 @@
+// Class Header
+#include "MeshoptDecoder.h"
+
+// Standard Library Headers
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+// Third-Party Library Headers
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GFX_MESHOPT_DECODER_X86 1
+#include <immintrin.h>
+#endif
+
+// Project Headers
+#include "VertexKernels.h"
+
+// Same per-function targeting as VertexKernels.cpp: only the SSE paths require SSE4.1.
+#if defined(GFX_MESHOPT_DECODER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define GFX_TARGET_SSE4 __attribute__((target("sse4.1")))
+#else
+#define GFX_TARGET_SSE4
+#endif
+
+//----------------------------------------------------------------------
+// Internal Constants and Utility Functions
+
+namespace {
+
+using meshopt_decoder::Filter;
+using meshopt_decoder::Mode;
+
+// Vertex codec (format version 0). Vertices are coded in blocks; within a block every byte
+// channel is delta coded against the previous vertex, zigzag encoded and bit packed in groups
+// of 16, each group stored with 0, 2, 4 or 8 bits per value.
+constexpr uint8_t kVertexHeader = 0xa0;
+constexpr size_t kVertexBlockSizeBytes = 8192;
+constexpr size_t kVertexBlockMaxSize = 256;
+constexpr size_t kMaxVertexStride = 256;
+constexpr size_t kByteGroupSize = 16;
+constexpr size_t kByteGroupDecodeLimit = 24; // Largest read of one group, exceptions included
+constexpr size_t kTailMinSize = 32;
+
+// Index codecs (format versions 0 and 1).
+constexpr uint8_t kIndexHeader = 0xe0;
+constexpr uint8_t kSequenceHeader = 0xd0;
+constexpr int kMaxIndexVersion = 1;
+constexpr size_t kCodeAuxTableSize = 16;
+constexpr size_t kSequenceTailSize = 4;
+
+bool IsSseEnabled() {
+#if defined(GFX_MESHOPT_DECODER_X86)
+    return vertex_kernels::GetActiveIsa() != vertex_kernels::Isa::Scalar;
+#else
+    return false;
+#endif
+}
+
+size_t GetVertexBlockSize(size_t stride) {
+    const size_t result = (kVertexBlockSizeBytes / stride) & ~(kByteGroupSize - 1);
+    return std::min(result, kVertexBlockMaxSize);
+}
+
+uint8_t Unzigzag8(uint8_t value) {
+    return static_cast<uint8_t>(-(value & 1) ^ (value >> 1));
+}
+
+uint32_t ReadU32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+//----------------------------------------------------------------------
+// Vertex codec
+
+// Unpacks 16 values stored with 1 << bitsLog2 bits each (most significant bits first). In the
+// 2- and 4-bit forms, an all-ones value escapes to the next byte after the packed bits.
+const uint8_t* DecodeBytesGroupScalar(const uint8_t* data, uint8_t* dst, int bitsLog2) {
+    switch (bitsLog2) {
+    case 0:
+        std::memset(dst, 0, kByteGroupSize);
+        return data;
+    case 3:
+        std::memcpy(dst, data, kByteGroupSize);
+        return data + kByteGroupSize;
+    default: {
+        const int bits = 1 << bitsLog2;
+        const int valuesPerByte = 8 / bits;
+        const uint8_t escape = static_cast<uint8_t>((1 << bits) - 1);
+        const uint8_t* packed = data;
+        const uint8_t* exceptions = data + kByteGroupSize / valuesPerByte;
+        for (size_t i = 0; i < kByteGroupSize; ++i) {
+            const int shift = 8 - bits * (1 + static_cast<int>(i) % valuesPerByte);
+            const uint8_t value = (packed[i / valuesPerByte] >> shift) & escape;
+            dst[i] = value == escape ? *exceptions++ : value;
+        }
+        return exceptions;
+    }
+    }
+}
+
+#if defined(GFX_MESHOPT_DECODER_X86)
+
+// For each 8-bit mask of escaped lanes: the pshufb indices that pull the escaped lanes from the
+// exception bytes in order (0x80 zeroes the other lanes), and the number of escapes.
+struct GroupShuffleTables {
+    std::array<std::array<uint8_t, 8>, 256> _shuffle{};
+    std::array<uint8_t, 256> _count{};
+};
+
+constexpr GroupShuffleTables BuildGroupShuffleTables() {
+    GroupShuffleTables tables;
+    for (int mask = 0; mask < 256; ++mask) {
+        uint8_t count = 0;
+        for (int lane = 0; lane < 8; ++lane) {
+            const bool escaped = (mask & (1 << lane)) != 0;
+            tables._shuffle[mask][lane] = escaped ? count++ : 0x80;
+        }
+        tables._count[mask] = count;
+    }
+    return tables;
+}
+
+constexpr GroupShuffleTables kGroupShuffleTables = BuildGroupShuffleTables();
+
+// Merges the unpacked values with the exception bytes at `rest`; returns the bytes consumed.
+GFX_TARGET_SSE4 inline size_t ResolveEscapesSSE(__m128i values, __m128i escape, __m128i rest,
+                                                uint8_t* dst) {
+    const __m128i escaped = _mm_cmpeq_epi8(values, escape);
+    const int mask = _mm_movemask_epi8(escaped);
+    const int mask0 = mask & 0xff;
+    const int mask1 = mask >> 8;
+
+    const __m128i shuffle0 = _mm_loadl_epi64(
+        reinterpret_cast<const __m128i*>(kGroupShuffleTables._shuffle[mask0].data()));
+    const __m128i shuffle1 = _mm_add_epi8(
+        _mm_loadl_epi64(
+            reinterpret_cast<const __m128i*>(kGroupShuffleTables._shuffle[mask1].data())),
+        _mm_set1_epi8(static_cast<char>(kGroupShuffleTables._count[mask0])));
+    const __m128i shuffle = _mm_unpacklo_epi64(shuffle0, shuffle1);
+
+    const __m128i result = _mm_or_si128(_mm_shuffle_epi8(rest, shuffle),
+                                        _mm_andnot_si128(escaped, values));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), result);
+    return kGroupShuffleTables._count[mask0] + kGroupShuffleTables._count[mask1];
+}
+
+// Reads at most kByteGroupDecodeLimit bytes; the caller guarantees they are in bounds.
+GFX_TARGET_SSE4 const uint8_t* DecodeBytesGroupSSE(const uint8_t* data, uint8_t* dst,
+                                                   int bitsLog2) {
+    switch (bitsLog2) {
+    case 0:
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_setzero_si128());
+        return data;
+    case 1: {
+        // Spread the 2-bit fields of 4 bytes over 16 lanes, first field in the first lane.
+        const __m128i packed = _mm_cvtsi32_si128(static_cast<int>(ReadU32(data)));
+        const __m128i nibbles = _mm_unpacklo_epi8(_mm_srli_epi16(packed, 4), packed);
+        const __m128i pairs = _mm_unpacklo_epi8(_mm_srli_epi16(nibbles, 2), nibbles);
+        const __m128i values = _mm_and_si128(pairs, _mm_set1_epi8(3));
+        const __m128i rest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 4));
+        return data + 4 + ResolveEscapesSSE(values, _mm_set1_epi8(3), rest, dst);
+    }
+    case 2: {
+        const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+        const __m128i nibbles = _mm_unpacklo_epi8(_mm_srli_epi16(packed, 4), packed);
+        const __m128i values = _mm_and_si128(nibbles, _mm_set1_epi8(15));
+        const __m128i rest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 8));
+        return data + 8 + ResolveEscapesSSE(values, _mm_set1_epi8(15), rest, dst);
+    }
+    default:
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+        return data + kByteGroupSize;
+    }
+}
+
+// Undoes the zigzag and delta coding of one byte channel, 16 vertices at a time: the running
+// sum is a log-step prefix sum across the lanes, seeded with the channel's previous byte.
+GFX_TARGET_SSE4 void DecodeDeltasSSE(const uint8_t* values, size_t count, uint8_t* dst,
+                                     size_t stride, uint8_t& last) {
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i low7 = _mm_set1_epi8(0x7f);
+    alignas(16) uint8_t decoded[kByteGroupSize];
+    for (size_t i = 0; i < count; i += kByteGroupSize) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        __m128i d = _mm_xor_si128(_mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(v, one)),
+                                  _mm_and_si128(_mm_srli_epi16(v, 1), low7));
+        d = _mm_add_epi8(d, _mm_slli_si128(d, 1));
+        d = _mm_add_epi8(d, _mm_slli_si128(d, 2));
+        d = _mm_add_epi8(d, _mm_slli_si128(d, 4));
+        d = _mm_add_epi8(d, _mm_slli_si128(d, 8));
+        d = _mm_add_epi8(d, _mm_set1_epi8(static_cast<char>(last)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(decoded), d);
+
+        const size_t lanes = std::min(kByteGroupSize, count - i);
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            dst[(i + lane) * stride] = decoded[lane];
+        }
+        last = decoded[lanes - 1];
+    }
+}
+
+#endif // GFX_MESHOPT_DECODER_X86
+
+// Decodes the packed values of one byte channel of a block (`count` is a multiple of 16).
+const uint8_t* DecodeBytes(const uint8_t* data, const uint8_t* end, uint8_t* dst, size_t count,
+                           bool sse) {
+    const size_t groupCount = count / kByteGroupSize;
+    const size_t headerSize = (groupCount + 3) / 4;
+    if (static_cast<size_t>(end - data) < headerSize) {
+        return nullptr;
+    }
+    const uint8_t* header = data;
+    data += headerSize;
+
+    for (size_t group = 0; group < groupCount; ++group) {
+        if (static_cast<size_t>(end - data) < kByteGroupDecodeLimit) {
+            return nullptr;
+        }
+        const int bitsLog2 = (header[group / 4] >> ((group % 4) * 2)) & 3;
+        uint8_t* groupDst = dst + group * kByteGroupSize;
+#if defined(GFX_MESHOPT_DECODER_X86)
+        data = sse ? DecodeBytesGroupSSE(data, groupDst, bitsLog2)
+                   : DecodeBytesGroupScalar(data, groupDst, bitsLog2);
+#else
+        (void)sse;
+        data = DecodeBytesGroupScalar(data, groupDst, bitsLog2);
+#endif
+    }
+    return data;
+}
+
+const uint8_t* DecodeVertexBlock(const uint8_t* data, const uint8_t* end, uint8_t* dst,
+                                 size_t count, size_t stride, uint8_t* lastVertex, bool sse) {
+    alignas(16) uint8_t values[kVertexBlockMaxSize];
+    const size_t alignedCount = (count + kByteGroupSize - 1) & ~(kByteGroupSize - 1);
+
+    for (size_t k = 0; k < stride; ++k) {
+        data = DecodeBytes(data, end, values, alignedCount, sse);
+        if (!data) {
+            return nullptr;
+        }
+
+#if defined(GFX_MESHOPT_DECODER_X86)
+        if (sse) {
+            DecodeDeltasSSE(values, count, dst + k, stride, lastVertex[k]);
+            continue;
+        }
+#endif
+        uint8_t previous = lastVertex[k];
+        for (size_t i = 0; i < count; ++i) {
+            previous = static_cast<uint8_t>(Unzigzag8(values[i]) + previous);
+            dst[i * stride + k] = previous;
+        }
+        lastVertex[k] = previous;
+    }
+    return data;
+}
+
+bool DecodeVertexBuffer(uint8_t* dst, size_t count, size_t stride, const uint8_t* src,
+                        size_t size) {
+    if (stride == 0 || stride > kMaxVertexStride || stride % 4 != 0 || size < 1 + stride) {
+        return false;
+    }
+    const uint8_t* data = src;
+    const uint8_t* end = src + size;
+    if ((*data & 0xf0) != kVertexHeader || (*data & 0x0f) != 0) {
+        return false; // Only version 0 is allowed by EXT_meshopt_compression
+    }
+    ++data;
+
+    // The first vertex is stored at the very end and seeds the deltas.
+    uint8_t lastVertex[kMaxVertexStride];
+    std::memcpy(lastVertex, end - stride, stride);
+
+    const bool sse = IsSseEnabled();
+    const size_t blockSize = GetVertexBlockSize(stride);
+    for (size_t offset = 0; offset < count; offset += blockSize) {
+        const size_t blockCount = std::min(blockSize, count - offset);
+        data = DecodeVertexBlock(data, end, dst + offset * stride, blockCount, stride, lastVertex,
+                                 sse);
+        if (!data) {
+            return false;
+        }
+    }
+
+    return static_cast<size_t>(end - data) == std::max(stride, kTailMinSize);
+}
+
+//----------------------------------------------------------------------
+// Index codecs
+
+uint32_t DecodeVByte(const uint8_t*& data) {
+    const uint8_t lead = *data++;
+    if (lead < 128) {
+        return lead;
+    }
+    uint32_t result = lead & 127;
+    uint32_t shift = 7;
+    for (int i = 0; i < 4; ++i) {
+        const uint8_t group = *data++;
+        result |= static_cast<uint32_t>(group & 127) << shift;
+        shift += 7;
+        if (group < 128) {
+            break;
+        }
+    }
+    return result;
+}
+
+uint32_t DecodeIndex(const uint8_t*& data, uint32_t last) {
+    const uint32_t v = DecodeVByte(data);
+    const uint32_t delta = (v >> 1) ^ (0u - (v & 1));
+    return last + delta;
+}
+
+void WriteIndex(uint8_t* dst, size_t i, size_t indexSize, uint32_t index) {
+    if (indexSize == 2) {
+        const auto value = static_cast<uint16_t>(index);
+        std::memcpy(dst + i * 2, &value, sizeof(value));
+    } else {
+        std::memcpy(dst + i * 4, &index, sizeof(index));
+    }
+}
+
+// Triangle list codec: each triangle is a code byte that either reuses an edge from a 16-entry
+// FIFO of recent edges or starts fresh, with the third vertex coming from a FIFO of recent
+// vertices, the next never-seen index, or an explicit delta.
+bool DecodeIndexBuffer(uint8_t* dst, size_t count, size_t indexSize, const uint8_t* src,
+                       size_t size) {
+    if (count % 3 != 0 || (indexSize != 2 && indexSize != 4) ||
+        size < 1 + count / 3 + kCodeAuxTableSize) {
+        return false;
+    }
+    if ((src[0] & 0xf0) != kIndexHeader || (src[0] & 0x0f) > kMaxIndexVersion) {
+        return false;
+    }
+    const int version = src[0] & 0x0f;
+
+    uint32_t edgeFifo[16][2];
+    uint32_t vertexFifo[16];
+    std::memset(edgeFifo, -1, sizeof(edgeFifo));
+    std::memset(vertexFifo, -1, sizeof(vertexFifo));
+    size_t edgeOffset = 0;
+    size_t vertexOffset = 0;
+    const auto pushVertex = [&](uint32_t v, bool advance = true) {
+        vertexFifo[vertexOffset] = v;
+        vertexOffset = (vertexOffset + (advance ? 1 : 0)) & 15;
+    };
+    const auto pushEdge = [&](uint32_t a, uint32_t b) {
+        edgeFifo[edgeOffset][0] = a;
+        edgeFifo[edgeOffset][1] = b;
+        edgeOffset = (edgeOffset + 1) & 15;
+    };
+
+    uint32_t next = 0;
+    uint32_t last = 0;
+    const int fecMax = version >= 1 ? 13 : 15;
+    const uint8_t* code = src + 1;
+    const uint8_t* data = code + count / 3;
+    const uint8_t* dataSafeEnd = src + size - kCodeAuxTableSize;
+    const uint8_t* codeAuxTable = dataSafeEnd;
+
+    for (size_t i = 0; i < count; i += 3) {
+        // A triangle reads at most 16 data bytes (a code byte and three 5-byte varints).
+        if (data > dataSafeEnd) {
+            return false;
+        }
+        const uint8_t codeTri = *code++;
+
+        if (codeTri < 0xf0) {
+            // Edge from the FIFO plus one vertex.
+            const int fe = codeTri >> 4;
+            const uint32_t a = edgeFifo[(edgeOffset - 1 - fe) & 15][0];
+            const uint32_t b = edgeFifo[(edgeOffset - 1 - fe) & 15][1];
+            const int fec = codeTri & 15;
+            uint32_t c;
+            if (fec < fecMax) {
+                c = fec == 0 ? next++ : vertexFifo[(vertexOffset - 1 - fec) & 15];
+                pushVertex(c, fec == 0);
+            } else {
+                // Version 1 codes 13 and 14 are the last free index -1 and +1.
+                c = last = fec != 15 ? last + (fec - (fec ^ 3)) : DecodeIndex(data, last);
+                pushVertex(c);
+            }
+            WriteIndex(dst, i + 0, indexSize, a);
+            WriteIndex(dst, i + 1, indexSize, b);
+            WriteIndex(dst, i + 2, indexSize, c);
+            pushEdge(c, b);
+            pushEdge(a, c);
+        } else {
+            // No shared edge: three vertices, each new, from the FIFO or explicit.
+            int fea;
+            int feb;
+            int fec;
+            if (codeTri < 0xfe) {
+                const uint8_t codeAux = codeAuxTable[codeTri & 15];
+                fea = 0;
+                feb = codeAux >> 4;
+                fec = codeAux & 15;
+            } else {
+                const uint8_t codeAux = *data++;
+                fea = codeTri == 0xfe ? 0 : 15;
+                feb = codeAux >> 4;
+                fec = codeAux & 15;
+                if (codeAux == 0) {
+                    next = 0; // Restart marker
+                }
+            }
+
+            // The FIFO lookups for b and c are relative to the position before a is pushed.
+            uint32_t a = fea == 0 ? next++ : 0;
+            uint32_t b = feb == 0 ? next++ : vertexFifo[(vertexOffset - feb) & 15];
+            uint32_t c = fec == 0 ? next++ : vertexFifo[(vertexOffset - fec) & 15];
+            if (fea == 15) {
+                last = a = DecodeIndex(data, last);
+            }
+            if (feb == 15) {
+                last = b = DecodeIndex(data, last);
+            }
+            if (fec == 15) {
+                last = c = DecodeIndex(data, last);
+            }
+
+            WriteIndex(dst, i + 0, indexSize, a);
+            WriteIndex(dst, i + 1, indexSize, b);
+            WriteIndex(dst, i + 2, indexSize, c);
+            pushVertex(a);
+            pushVertex(b, feb == 0 || feb == 15);
+            pushVertex(c, fec == 0 || fec == 15);
+            pushEdge(b, a);
+            pushEdge(c, b);
+            pushEdge(a, c);
+        }
+    }
+
+    return data == dataSafeEnd;
+}
+
+// Index sequence codec: zigzag deltas against one of two running baselines, as varints.
+bool DecodeIndexSequence(uint8_t* dst, size_t count, size_t indexSize, const uint8_t* src,
+                         size_t size) {
+    if ((indexSize != 2 && indexSize != 4) || size < 1 + count + kSequenceTailSize) {
+        return false;
+    }
+    if ((src[0] & 0xf0) != kSequenceHeader || (src[0] & 0x0f) > kMaxIndexVersion) {
+        return false;
+    }
+
+    const uint8_t* data = src + 1;
+    const uint8_t* dataSafeEnd = src + size - kSequenceTailSize;
+    uint32_t last[2] = {};
+    for (size_t i = 0; i < count; ++i) {
+        if (data >= dataSafeEnd) {
+            return false;
+        }
+        uint32_t v = DecodeVByte(data);
+        const uint32_t baseline = v & 1;
+        v >>= 1;
+        const uint32_t delta = (v >> 1) ^ (0u - (v & 1));
+        last[baseline] += delta;
+        WriteIndex(dst, i, indexSize, last[baseline]);
+    }
+
+    return data == dataSafeEnd;
+}
+
+//----------------------------------------------------------------------
+// Filters
+
+// Round half away from zero, as the reference decoder does.
+inline int RoundToInt(float value) {
+    return static_cast<int>(value + (value >= 0.0f ? 0.5f : -0.5f));
+}
+
+template <typename T>
+void DecodeOctahedralScalar(T* data, size_t count) {
+    const float maxValue = static_cast<float>((1 << (sizeof(T) * 8 - 1)) - 1);
+    for (size_t i = 0; i < count; ++i) {
+        // z holds the encoding's scale (1.0); fold the lower hemisphere back.
+        float x = static_cast<float>(data[i * 4 + 0]);
+        float y = static_cast<float>(data[i * 4 + 1]);
+        const float z = static_cast<float>(data[i * 4 + 2]) - std::fabs(x) - std::fabs(y);
+        const float t = z < 0.0f ? z : 0.0f;
+        x += x >= 0.0f ? t : -t;
+        y += y >= 0.0f ? t : -t;
+
+        const float scale = maxValue / std::sqrt(x * x + y * y + z * z);
+        data[i * 4 + 0] = static_cast<T>(RoundToInt(x * scale));
+        data[i * 4 + 1] = static_cast<T>(RoundToInt(y * scale));
+        data[i * 4 + 2] = static_cast<T>(RoundToInt(z * scale));
+    }
+}
+
+void DecodeQuaternionScalar(int16_t* data, size_t count) {
+    const float scale = 1.0f / std::sqrt(2.0f);
+    for (size_t i = 0; i < count; ++i) {
+        // The low 2 bits of w name the dropped (largest) component; the rest is its scale.
+        const int sf = data[i * 4 + 3] | 3;
+        const float ss = scale / static_cast<float>(sf);
+        const float x = static_cast<float>(data[i * 4 + 0]) * ss;
+        const float y = static_cast<float>(data[i * 4 + 1]) * ss;
+        const float z = static_cast<float>(data[i * 4 + 2]) * ss;
+        const float ww = 1.0f - x * x - y * y - z * z;
+        const float w = std::sqrt(ww >= 0.0f ? ww : 0.0f);
+
+        const int qc = data[i * 4 + 3] & 3;
+        data[i * 4 + ((qc + 1) & 3)] = static_cast<int16_t>(RoundToInt(x * 32767.0f));
+        data[i * 4 + ((qc + 2) & 3)] = static_cast<int16_t>(RoundToInt(y * 32767.0f));
+        data[i * 4 + ((qc + 3) & 3)] = static_cast<int16_t>(RoundToInt(z * 32767.0f));
+        data[i * 4 + ((qc + 0) & 3)] = static_cast<int16_t>(static_cast<int>(w * 32767.0f + 0.5f));
+    }
+}
+
+void DecodeExponentialScalar(uint32_t* data, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        // Signed 24-bit mantissa, signed 8-bit exponent: m * 2^e.
+        const int32_t mantissa = static_cast<int32_t>(data[i] << 8) >> 8;
+        const int32_t exponent = static_cast<int32_t>(data[i]) >> 24;
+        const uint32_t powerBits = static_cast<uint32_t>(exponent + 127) << 23;
+        float power;
+        std::memcpy(&power, &powerBits, sizeof(power));
+        const float value = power * static_cast<float>(mantissa);
+        std::memcpy(&data[i], &value, sizeof(value));
+    }
+}
+
+#if defined(GFX_MESHOPT_DECODER_X86)
+
+// SSE counterpart of RoundToInt(value * scale), rounding on the sign of `value`.
+GFX_TARGET_SSE4 inline __m128i RoundToIntSSE(__m128 value, __m128 scale) {
+    const __m128 half = _mm_blendv_ps(_mm_set1_ps(-0.5f), _mm_set1_ps(0.5f),
+                                      _mm_cmpge_ps(value, _mm_setzero_ps()));
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, scale), half));
+}
+
+// x, y, z as floats in, rounded and rescaled integers out; same operation order as the scalar
+// filter so both give identical results.
+GFX_TARGET_SSE4 inline void OctahedralSSE(__m128& x, __m128& y, __m128 z, float maxValue,
+                                          __m128i& xi, __m128i& yi, __m128i& zi) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    z = _mm_sub_ps(_mm_sub_ps(z, _mm_andnot_ps(signMask, x)), _mm_andnot_ps(signMask, y));
+    const __m128 t = _mm_min_ps(z, zero);
+    const __m128 negT = _mm_sub_ps(zero, t);
+    x = _mm_add_ps(x, _mm_blendv_ps(negT, t, _mm_cmpge_ps(x, zero)));
+    y = _mm_add_ps(y, _mm_blendv_ps(negT, t, _mm_cmpge_ps(y, zero)));
+
+    const __m128 length = _mm_sqrt_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+    const __m128 scale = _mm_div_ps(_mm_set1_ps(maxValue), length);
+    xi = RoundToIntSSE(x, scale);
+    yi = RoundToIntSSE(y, scale);
+    zi = RoundToIntSSE(z, scale);
+}
+
+GFX_TARGET_SSE4 void DecodeOctahedral8SSE(int8_t* data, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 4));
+        __m128 x = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(v, 24), 24));
+        __m128 y = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(v, 16), 24));
+        const __m128 z = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(v, 8), 24));
+        __m128i xi, yi, zi;
+        OctahedralSSE(x, y, z, 127.0f, xi, yi, zi);
+
+        const __m128i byteMask = _mm_set1_epi32(0xff);
+        __m128i result = _mm_and_si128(v, _mm_set1_epi32(static_cast<int>(0xff000000)));
+        result = _mm_or_si128(result, _mm_and_si128(xi, byteMask));
+        result = _mm_or_si128(result, _mm_slli_epi32(_mm_and_si128(yi, byteMask), 8));
+        result = _mm_or_si128(result, _mm_slli_epi32(_mm_and_si128(zi, byteMask), 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i * 4), result);
+    }
+    DecodeOctahedralScalar(data + i * 4, count - i);
+}
+
+GFX_TARGET_SSE4 void DecodeOctahedral16SSE(int16_t* data, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        // Two vertices per register; gather the xy and zw halves of all four.
+        const __m128 v0 = _mm_loadu_ps(reinterpret_cast<const float*>(data + i * 4));
+        const __m128 v1 = _mm_loadu_ps(reinterpret_cast<const float*>(data + i * 4 + 8));
+        const __m128i xy = _mm_castps_si128(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)));
+        const __m128i zw = _mm_castps_si128(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)));
+
+        __m128 x = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(xy, 16), 16));
+        __m128 y = _mm_cvtepi32_ps(_mm_srai_epi32(xy, 16));
+        const __m128 z = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(zw, 16), 16));
+        __m128i xi, yi, zi;
+        OctahedralSSE(x, y, z, 32767.0f, xi, yi, zi);
+
+        const __m128i low16 = _mm_set1_epi32(0xffff);
+        const __m128i outXY = _mm_or_si128(_mm_and_si128(xi, low16), _mm_slli_epi32(yi, 16));
+        const __m128i outZW = _mm_or_si128(_mm_and_si128(zi, low16),
+                                           _mm_andnot_si128(low16, zw));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i * 4),
+                         _mm_unpacklo_epi32(outXY, outZW));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i * 4 + 8),
+                         _mm_unpackhi_epi32(outXY, outZW));
+    }
+    DecodeOctahedralScalar(data + i * 4, count - i);
+}
+
+GFX_TARGET_SSE4 void DecodeQuaternionSSE(int16_t* data, size_t count) {
+    const __m128 scale = _mm_set1_ps(1.0f / std::sqrt(2.0f));
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 maxValue = _mm_set1_ps(32767.0f);
+    alignas(16) int32_t rounded[4][4];
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 v0 = _mm_loadu_ps(reinterpret_cast<const float*>(data + i * 4));
+        const __m128 v1 = _mm_loadu_ps(reinterpret_cast<const float*>(data + i * 4 + 8));
+        const __m128i xy = _mm_castps_si128(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)));
+        const __m128i zw = _mm_castps_si128(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)));
+        const __m128i w = _mm_srai_epi32(zw, 16);
+
+        const __m128 ss = _mm_div_ps(scale, _mm_cvtepi32_ps(_mm_or_si128(w, _mm_set1_epi32(3))));
+        const __m128i xi = _mm_srai_epi32(_mm_slli_epi32(xy, 16), 16);
+        const __m128i yi = _mm_srai_epi32(xy, 16);
+        const __m128i zi = _mm_srai_epi32(_mm_slli_epi32(zw, 16), 16);
+        const __m128 x = _mm_mul_ps(_mm_cvtepi32_ps(xi), ss);
+        const __m128 y = _mm_mul_ps(_mm_cvtepi32_ps(yi), ss);
+        const __m128 z = _mm_mul_ps(_mm_cvtepi32_ps(zi), ss);
+        const __m128 ww = _mm_sub_ps(
+            _mm_sub_ps(_mm_sub_ps(one, _mm_mul_ps(x, x)), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        const __m128 wf = _mm_sqrt_ps(_mm_max_ps(ww, zero));
+
+        _mm_store_si128(reinterpret_cast<__m128i*>(rounded[0]), RoundToIntSSE(x, maxValue));
+        _mm_store_si128(reinterpret_cast<__m128i*>(rounded[1]), RoundToIntSSE(y, maxValue));
+        _mm_store_si128(reinterpret_cast<__m128i*>(rounded[2]), RoundToIntSSE(z, maxValue));
+        _mm_store_si128(reinterpret_cast<__m128i*>(rounded[3]),
+                        _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(wf, maxValue), _mm_set1_ps(0.5f))));
+
+        // The output order depends on each quaternion's dropped component.
+        for (size_t lane = 0; lane < 4; ++lane) {
+            int16_t* q = data + (i + lane) * 4;
+            const int qc = q[3] & 3;
+            q[(qc + 1) & 3] = static_cast<int16_t>(rounded[0][lane]);
+            q[(qc + 2) & 3] = static_cast<int16_t>(rounded[1][lane]);
+            q[(qc + 3) & 3] = static_cast<int16_t>(rounded[2][lane]);
+            q[(qc + 0) & 3] = static_cast<int16_t>(rounded[3][lane]);
+        }
+    }
+    DecodeQuaternionScalar(data + i * 4, count - i);
+}
+
+GFX_TARGET_SSE4 void DecodeExponentialSSE(uint32_t* data, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i mantissa = _mm_srai_epi32(_mm_slli_epi32(v, 8), 8);
+        const __m128i exponent = _mm_srai_epi32(v, 24);
+        const __m128 power = _mm_castsi128_ps(
+            _mm_slli_epi32(_mm_add_epi32(exponent, _mm_set1_epi32(127)), 23));
+        _mm_storeu_ps(reinterpret_cast<float*>(data + i),
+                      _mm_mul_ps(power, _mm_cvtepi32_ps(mantissa)));
+    }
+    DecodeExponentialScalar(data + i, count - i);
+}
+
+#endif // GFX_MESHOPT_DECODER_X86
+
+bool ApplyFilter(Filter filter, uint8_t* data, size_t count, size_t stride) {
+    [[maybe_unused]] const bool sse = IsSseEnabled();
+    switch (filter) {
+    case Filter::None:
+        return true;
+    case Filter::Octahedral:
+        if (stride == 4) {
+            auto* values = reinterpret_cast<int8_t*>(data);
+#if defined(GFX_MESHOPT_DECODER_X86)
+            if (sse) {
+                DecodeOctahedral8SSE(values, count);
+                return true;
+            }
+#endif
+            DecodeOctahedralScalar(values, count);
+            return true;
+        }
+        if (stride == 8) {
+            auto* values = reinterpret_cast<int16_t*>(data);
+#if defined(GFX_MESHOPT_DECODER_X86)
+            if (sse) {
+                DecodeOctahedral16SSE(values, count);
+                return true;
+            }
+#endif
+            DecodeOctahedralScalar(values, count);
+            return true;
+        }
+        return false;
+    case Filter::Quaternion:
+        if (stride == 8) {
+            auto* values = reinterpret_cast<int16_t*>(data);
+#if defined(GFX_MESHOPT_DECODER_X86)
+            if (sse) {
+                DecodeQuaternionSSE(values, count);
+                return true;
+            }
+#endif
+            DecodeQuaternionScalar(values, count);
+            return true;
+        }
+        return false;
+    case Filter::Exponential:
+        if (stride % 4 == 0) {
+            auto* values = reinterpret_cast<uint32_t*>(data);
+#if defined(GFX_MESHOPT_DECODER_X86)
+            if (sse) {
+                DecodeExponentialSSE(values, count * stride / 4);
+                return true;
+            }
+#endif
+            DecodeExponentialScalar(values, count * stride / 4);
+            return true;
+        }
+        return false;
+    }
+    return false;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// meshopt_decoder implementation
+
+namespace meshopt_decoder {
+
+bool ParseMode(std::string_view name, Mode& mode) {
+    if (name == "ATTRIBUTES") {
+        mode = Mode::Attributes;
+    } else if (name == "TRIANGLES") {
+        mode = Mode::Triangles;
+    } else if (name == "INDICES") {
+        mode = Mode::Indices;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool ParseFilter(std::string_view name, Filter& filter) {
+    if (name == "NONE") {
+        filter = Filter::None;
+    } else if (name == "OCTAHEDRAL") {
+        filter = Filter::Octahedral;
+    } else if (name == "QUATERNION") {
+        filter = Filter::Quaternion;
+    } else if (name == "EXPONENTIAL") {
+        filter = Filter::Exponential;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool DecodeBufferView(Mode mode, Filter filter, const uint8_t* src, size_t size, size_t count,
+                      size_t stride, uint8_t* dst) {
+    switch (mode) {
+    case Mode::Attributes:
+        return DecodeVertexBuffer(dst, count, stride, src, size) &&
+               ApplyFilter(filter, dst, count, stride);
+    case Mode::Triangles:
+        return filter == Filter::None && DecodeIndexBuffer(dst, count, stride, src, size);
+    case Mode::Indices:
+        return filter == Filter::None && DecodeIndexSequence(dst, count, stride, src, size);
+    }
+    return false;
+}
+
+} // namespace meshopt_decoder
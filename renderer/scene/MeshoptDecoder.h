@@ -0,0 +1,38 @@
+/// @file  MeshoptDecoder.h
+/// @brief Decoder for EXT_meshopt_compression buffer views (meshoptimizer codecs and filters).
+
+#pragma once
+
+// Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace meshopt_decoder {
+
+// How a compressed buffer view was encoded (the extension's "mode").
+enum class Mode {
+    Attributes, // Vertex codec, any stride that is a multiple of 4 up to 256
+    Triangles,  // Index codec for triangle lists, 2- or 4-byte indices
+    Indices,    // Index sequence codec, 2- or 4-byte indices
+};
+
+// Post-decode transform applied to attribute data (the extension's "filter").
+enum class Filter {
+    None,
+    Octahedral,  // Normals/tangents: snorm8x4 or snorm16x4, xyz rebuilt from octahedral xy
+    Quaternion,  // Rotations: snorm16x4, w rebuilt from the three smallest components
+    Exponential, // Floats stored as a 24-bit mantissa and an 8-bit exponent
+};
+
+bool ParseMode(std::string_view name, Mode& mode);
+bool ParseFilter(std::string_view name, Filter& filter);
+
+// Decodes `count` elements of `stride` bytes from the `size` bytes at `src` into `dst`
+// (count * stride bytes), then applies `filter` in place. Returns false if the data is
+// malformed or the mode, filter and stride don't go together; `dst` is unspecified then.
+// The filters and the vertex codec use SSE4.1 when vertex_kernels allows it.
+bool DecodeBufferView(Mode mode, Filter filter, const uint8_t* src, size_t size, size_t count,
+                      size_t stride, uint8_t* dst);
+
+} // namespace meshopt_decoder
@@ -2,8 +2,19 @@
 #include "Model.h"
 
 // Standard Library Headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <type_traits>
 
 // Third-Party Library Headers
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -17,7 +28,14 @@
 #include <tiny_gltf.h>
 
 // Project Headers
+#include "Ktx2.h"
+#include "MappedGlb.h"
+#include "MemoryUtils.h"
 #include "MeshUtils.h"
+#include "MeshoptDecoder.h"
+#include "TextureCodecs.h"
+#include "ThreadPool.h"
+#include "VertexKernels.h"
 
 //----------------------------------------------------------------------
 // Internal Constants and Utility Functions
@@ -27,233 +45,449 @@ namespace {
 // Constants
 constexpr float PI = 3.14159265358979323846f;
 
-void ProcessMesh(const tinygltf::Model& model, const tinygltf::Mesh& mesh,
-                 std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices,
-                 std::vector<Model::SubMesh>& subMeshes, const glm::mat4& transform) {
-    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
-    glm::mat3 tangentMatrix = glm::mat3(transform);
+// glTF extensions the loader understands; files that require any other one are rejected.
+// KHR_texture_basisu images must be pre-transcoded KTX2 (see ktx2::CheckSupported); Basis
+// Universal payloads fall back to the texture's `source` image.
+constexpr const char* kSupportedExtensions[] = {"KHR_mesh_quantization", "EXT_meshopt_compression",
+                                                "KHR_texture_basisu", "EXT_mesh_gpu_instancing"};
+constexpr const char* kMeshoptExtension = "EXT_meshopt_compression";
+constexpr const char* kBasisuExtension = "KHR_texture_basisu";
+constexpr const char* kInstancingExtension = "EXT_mesh_gpu_instancing";
+
+// Vertex attributes read by ProcessPrimitive.
+constexpr const char* kExtractedAttributes[] = {"POSITION",   "NORMAL",     "TANGENT",
+                                                "TEXCOORD_0", "TEXCOORD_1", "COLOR_0"};
+
+// A node that places a mesh: its global transform and, with EXT_mesh_gpu_instancing, the
+// accessors of the per-instance translation, rotation and scale (-1 when absent).
+struct MeshPlacement {
+    int _mesh{-1};
+    glm::mat4 _transform{1.0f};
+    int _translation{-1};
+    int _rotation{-1};
+    int _scale{-1};
+};
+
+// A primitive scheduled for extraction, with its final location in the shared arrays.
+struct PrimitiveJob {
+    const tinygltf::Primitive* _primitive{nullptr};
+    glm::mat4 _transform{1.0f}; // Baked into the vertices; identity for instanced meshes
+    int _mesh{-1};
+    bool _instanced{false};
+    uint32_t _firstInstance{0};
+    uint32_t _instanceCount{1};
+    size_t _vertexCount{0};
+    size_t _indexCount{0};
+    size_t _firstVertex{0};
+    size_t _firstIndex{0};
+    std::vector<int> _buffers;     // Distinct buffers the primitive reads from
+    std::vector<int> _bufferViews; // Distinct buffer views the primitive reads from
+};
+
+// Tangent generation over a batch of submeshes. Times are summed over the jobs rather than taken
+// around the parallel loop, so the two generators compare the same way on any thread count.
+struct TangentReport {
+    double _generateMs{0.0};  // Selected generator
+    double _referenceMs{0.0}; // The other generator, when validating
+    mesh_utils::TangentDeviation _deviation;
+};
+
+// Wall-clock duration of each loader phase, in milliseconds.
+struct LoadTimings {
+    double _countMs{0.0};
+    double _extractMs{0.0};
+    double _tangentMs{0.0};
+    size_t _tangentSubMeshes{0}; // Submeshes whose tangents were generated
+    size_t _tangentsSkipped{0};  // Submeshes without tangents whose material needs none
+    TangentReport _tangents;
+    size_t _quantizedAttributes{0}; // Integer attribute accessors expanded to float
+    double _imageWaitMs{0.0}; // Time spent blocked on image decoding after the geometry was done
+    size_t _instancedSubMeshes{0};     // Submeshes stored once for several placements
+    size_t _instances{0};              // Their placements
+    size_t _instancedVerticesSaved{0}; // Vertices baking every placement would have added
+};
+
+// LoadOptions::_compressTextures totals, updated by the image tasks.
+struct CompressionStats {
+    std::atomic<size_t> _encoded{0};
+    std::atomic<size_t> _cacheHits{0};
+    std::atomic<size_t> _rgba8Bytes{0};      // Level 0 of every compressed texture as RGBA8
+    std::atomic<size_t> _compressedBytes{0}; // Whole block-compressed mip chains
+    std::atomic<int64_t> _encodeMicroseconds{0};
+};
+
+// Block format and mip filter chosen for an image from the material slots that sample it.
+struct ImageCompression {
+    bool _enabled{false};
+    Model::TextureFormat _format{Model::TextureFormat::RGBA8};
+    texture_codecs::MipFilter _filter{texture_codecs::MipFilter::Linear};
+};
+
+// Encoded image bytes captured during parsing, indexed like tinygltf::Model::images. Images
+// stored in a buffer view are read in place; only data URIs and external files (whose bytes
+// tinygltf discards) are copied.
+struct EncodedImage {
+    int _bufferView{-1};
+    std::vector<uint8_t> _ownedBytes;
+};
+
+// Tracks the largest resident set size sampled at the points where memory use peaks (just
+// before source data is released). Safe to sample from worker threads.
+class PeakMemoryTracker {
+  public:
+    void Sample() {
+        const size_t current = memory_utils::GetResidentMemoryBytes();
+        size_t peak = _peak.load();
+        while (current > peak && !_peak.compare_exchange_weak(peak, current)) {
+        }
+    }
 
-    for (const auto& primitive : mesh.primitives) {
-        if (primitive.material < 0) {
-            // TODO: Handle this in another way? Assign 'default' material?
-            continue;
+    size_t GetPeak() const { return _peak.load(); }
+
+  private:
+    std::atomic<size_t> _peak{0};
+};
+
+// Where the bytes of each glTF buffer live while extracting: normally tinygltf's own storage,
+// but the BIN chunk of a memory-mapped GLB is read in place. Also counts outstanding readers so
+// each buffer is released as soon as its last primitive or image has been decoded.
+class SourceBuffers {
+  public:
+    SourceBuffers(tinygltf::Model& model, const MappedGlb* mappedGlb,
+                  PeakMemoryTracker& memoryTracker) :
+        _model(model), _memoryTracker(memoryTracker), _data(model.buffers.size()),
+        _users(std::make_unique<std::atomic<int>[]>(model.buffers.size())) {
+        for (size_t i = 0; i < model.buffers.size(); ++i) {
+            _data[i] = model.buffers[i].data.data();
         }
 
-        Model::SubMesh subMesh;
-        subMesh._firstIndex = static_cast<uint32_t>(indices.size());
-        subMesh._materialIndex = primitive.material;
-        subMesh._minBounds = glm::vec3(std::numeric_limits<float>::max());
-        subMesh._maxBounds = glm::vec3(std::numeric_limits<float>::lowest());
-
-        uint32_t vertexOffset = static_cast<uint32_t>(vertices.size());
-
-        // Access vertex positions.
-        const auto& positionAccessor =
-            model.accessors[primitive.attributes.find("POSITION")->second];
-        const auto& positionBufferView = model.bufferViews[positionAccessor.bufferView];
-        const auto& positionBuffer = model.buffers[positionBufferView.buffer];
-        const float* positionData = reinterpret_cast<const float*>(positionBuffer.data.data() +
-                                                                   positionBufferView.byteOffset +
-                                                                   positionAccessor.byteOffset);
-        const size_t positionStride =
-            positionAccessor.ByteStride(positionBufferView) / sizeof(float);
-
-        // Optional: Access vertex normals.
-        const auto normalIter = primitive.attributes.find("NORMAL");
-        const float* normalData = nullptr;
-        size_t normalStride = 0;
-        if (normalIter != primitive.attributes.end()) {
-            const auto& normalAccessor = model.accessors[normalIter->second];
-            const auto& normalBufferView = model.bufferViews[normalAccessor.bufferView];
-            const auto& normalBuffer = model.buffers[normalBufferView.buffer];
-            normalData = reinterpret_cast<const float*>(
-                normalBuffer.data.data() + normalBufferView.byteOffset + normalAccessor.byteOffset);
-            normalStride = normalAccessor.ByteStride(normalBufferView) / sizeof(float);
-        }
-
-        // Optional: Access tangents.
-        const auto tangentIter = primitive.attributes.find("TANGENT");
-        const float* tangentData = nullptr;
-        size_t tangentStride = 0;
-        if (tangentIter != primitive.attributes.end()) {
-            const auto& tangentAccessor = model.accessors[tangentIter->second];
-            const auto& tangentBufferView = model.bufferViews[tangentAccessor.bufferView];
-            const auto& tangentBuffer = model.buffers[tangentBufferView.buffer];
-            tangentData = reinterpret_cast<const float*>(tangentBuffer.data.data() +
-                                                         tangentBufferView.byteOffset +
-                                                         tangentAccessor.byteOffset);
-            tangentStride = tangentAccessor.ByteStride(tangentBufferView) / sizeof(float);
-        }
-
-        // Optional: Access texture coordinates.
-        const auto texCoord0Iter = primitive.attributes.find("TEXCOORD_0");
-        const float* texCoord0Data = nullptr;
-        size_t texCoord0Stride = 0;
-        if (texCoord0Iter != primitive.attributes.end()) {
-            const auto& texCoordAccessor = model.accessors[texCoord0Iter->second];
-            const auto& texCoordBufferView = model.bufferViews[texCoordAccessor.bufferView];
-            const auto& texCoordBuffer = model.buffers[texCoordBufferView.buffer];
-            texCoord0Data = reinterpret_cast<const float*>(texCoordBuffer.data.data() +
-                                                           texCoordBufferView.byteOffset +
-                                                           texCoordAccessor.byteOffset);
-            texCoord0Stride = texCoordAccessor.ByteStride(texCoordBufferView) / sizeof(float);
-        }
-
-        const auto texCoord1Iter = primitive.attributes.find("TEXCOORD_1");
-        const float* texCoord1Data = nullptr;
-        size_t texCoord1Stride = 0;
-        if (texCoord1Iter != primitive.attributes.end()) {
-            const auto& texCoordAccessor = model.accessors[texCoord1Iter->second];
-            const auto& texCoordBufferView = model.bufferViews[texCoordAccessor.bufferView];
-            const auto& texCoordBuffer = model.buffers[texCoordBufferView.buffer];
-            texCoord1Data = reinterpret_cast<const float*>(texCoordBuffer.data.data() +
-                                                           texCoordBufferView.byteOffset +
-                                                           texCoordAccessor.byteOffset);
-            texCoord1Stride = texCoordAccessor.ByteStride(texCoordBufferView) / sizeof(float);
-        }
-
-        // Optional: Access vertex colors.
-        const auto colorIter = primitive.attributes.find("COLOR_0");
-        const float* colorData = nullptr;
-        size_t colorStride = 0;
-        if (colorIter != primitive.attributes.end()) {
-            const auto& colorAccessor = model.accessors[colorIter->second];
-            const auto& colorBufferView = model.bufferViews[colorAccessor.bufferView];
-            const auto& colorBuffer = model.buffers[colorBufferView.buffer];
-            colorData = reinterpret_cast<const float*>(
-                colorBuffer.data.data() + colorBufferView.byteOffset + colorAccessor.byteOffset);
-            colorStride = colorAccessor.ByteStride(colorBufferView) / sizeof(float);
-        }
-
-        // Copy vertex data into Vertex struct.
-        for (size_t i = 0; i < positionAccessor.count; ++i) {
-            Model::Vertex vertex;
-
-            // Position
-            glm::vec4 pos = glm::vec4(positionData[i * positionStride + 0],
-                                      positionData[i * positionStride + 1],
-                                      positionData[i * positionStride + 2], 1.0f);
-            vertex._position = glm::vec3(transform * pos);
-
-            // Update bounds.
-            subMesh._minBounds = glm::min(subMesh._minBounds, vertex._position);
-            subMesh._maxBounds = glm::max(subMesh._maxBounds, vertex._position);
-
-            // Normal (default to 0, 0, 1 if not provided).
-            if (normalData) {
-                vertex._normal =
-                    glm::normalize(normalMatrix * glm::vec3(normalData[i * normalStride + 0],
-                                                            normalData[i * normalStride + 1],
-                                                            normalData[i * normalStride + 2]));
-            } else {
-                vertex._normal = glm::normalize(normalMatrix * glm::vec3(0.0f, 0.0f, 1.0f));
-            }
+        // LoadMappedGlb leaves the embedded buffer empty; its bytes are the mapped BIN chunk.
+        if (mappedGlb && mappedGlb->GetBinData() && !model.buffers.empty() &&
+            model.buffers[0].uri.empty()) {
+            _mappedGlb = mappedGlb;
+            _data[0] = mappedGlb->GetBinData();
+        }
+    }
 
-            // Tangent (default to 0, 0, 0, 1 if not provided).
-            if (tangentData) {
-                glm::vec3 transformedTangent =
-                    tangentMatrix * glm::vec3(tangentData[i * tangentStride + 0],
-                                              tangentData[i * tangentStride + 1],
-                                              tangentData[i * tangentStride + 2]);
+    const uint8_t* GetData(int buffer) const { return _data[buffer]; }
 
-                vertex._tangent =
-                    glm::vec4(glm::normalize(transformedTangent),
-                              tangentData[i * tangentStride + 3]); // Preserve handedness (w)
-            } else {
-                vertex._tangent = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
-            }
+    void AddUser(int buffer) { _users[buffer].fetch_add(1); }
 
-            // Texture coordinates (default to 0, 0 if not provided).
-            if (texCoord0Data) {
-                vertex._texCoord0 = glm::vec2(texCoord0Data[i * texCoord0Stride + 0],
-                                              texCoord0Data[i * texCoord0Stride + 1]);
-            } else {
-                vertex._texCoord0 = glm::vec2(0.0f, 0.0f);
-            }
+    void Release(int buffer) {
+        if (_users[buffer].fetch_sub(1) == 1) {
+            Free(buffer);
+        }
+    }
 
-            if (texCoord1Data) {
-                vertex._texCoord1 = glm::vec2(texCoord1Data[i * texCoord1Stride + 0],
-                                              texCoord1Data[i * texCoord1Stride + 1]);
-            } else {
-                vertex._texCoord1 = glm::vec2(0.0f, 0.0f);
+    // Frees buffers that nothing we extract reads from.
+    void ReleaseUnused() {
+        for (size_t i = 0; i < _data.size(); ++i) {
+            if (_users[i].load() == 0) {
+                Free(static_cast<int>(i));
             }
+        }
+    }
 
-            // Color (default to white if not provided).
-            if (colorData) {
-                vertex._color =
-                    glm::vec4(colorData[i * colorStride + 0], colorData[i * colorStride + 1],
-                              colorData[i * colorStride + 2], colorData[i * colorStride + 3]);
-            } else {
-                vertex._color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
-            }
+    // Hints that a buffer view has been consumed. Mapped pages are dropped right away (they are
+    // faulted back in if another reader still needs them); heap buffers wait for Release().
+    void ReleaseBufferView(const tinygltf::BufferView& bufferView) const {
+        if (IsMapped(bufferView.buffer)) {
+            _mappedGlb->Release(_data[0] + bufferView.byteOffset, bufferView.byteLength);
+        }
+    }
+
+  private:
+    bool IsMapped(int buffer) const { return _mappedGlb && buffer == 0; }
 
-            vertices.push_back(vertex);
+    void Free(int buffer) {
+        _memoryTracker.Sample();
+        if (IsMapped(buffer)) {
+            _mappedGlb->Release(_mappedGlb->GetBinData(), _mappedGlb->GetBinSize());
+        } else {
+            std::vector<unsigned char>().swap(_model.buffers[buffer].data);
         }
+    }
 
-        // Access indices (if present).
-        if (primitive.indices >= 0) {
-            const auto& indexAccessor = model.accessors[primitive.indices];
-            const auto& indexBufferView = model.bufferViews[indexAccessor.bufferView];
-            const auto& indexBuffer = model.buffers[indexBufferView.buffer];
-            const void* indexData =
-                indexBuffer.data.data() + indexBufferView.byteOffset + indexAccessor.byteOffset;
+    tinygltf::Model& _model;
+    PeakMemoryTracker& _memoryTracker;
+    const MappedGlb* _mappedGlb{nullptr};
+    std::vector<const uint8_t*> _data;
+    std::unique_ptr<std::atomic<int>[]> _users;
+};
+
+// Byte view of a vertex attribute: the first element, the stride between elements and how
+// each element is stored.
+struct AttributeView {
+    const uint8_t* _data{nullptr};
+    size_t _stride{0};
+    int _componentType{TINYGLTF_COMPONENT_TYPE_FLOAT};
+    int _components{0};
+    bool _normalized{false};
+};
+
+AttributeView GetAccessorView(const tinygltf::Model& model, const SourceBuffers& buffers,
+                              int accessorIndex) {
+    if (accessorIndex < 0 || static_cast<size_t>(accessorIndex) >= model.accessors.size()) {
+        return {};
+    }
+    const auto& accessor = model.accessors[accessorIndex];
+    if (accessor.bufferView < 0) {
+        return {};
+    }
+    const auto& bufferView = model.bufferViews[accessor.bufferView];
+    return {buffers.GetData(bufferView.buffer) + bufferView.byteOffset + accessor.byteOffset,
+            static_cast<size_t>(accessor.ByteStride(bufferView)), accessor.componentType,
+            tinygltf::GetNumComponentsInType(static_cast<uint32_t>(accessor.type)),
+            accessor.normalized};
+}
 
-            if (indexAccessor.count > std::numeric_limits<uint32_t>::max()) {
-                std::cerr << "Error: Index accessor count exceeds 32-bit limit: "
-                          << indexAccessor.count << std::endl;
-                subMesh._indexCount = std::numeric_limits<uint32_t>::max();
-            } else {
-                subMesh._indexCount = static_cast<uint32_t>(indexAccessor.count);
-            }
+AttributeView GetAttributeView(const tinygltf::Model& model, const SourceBuffers& buffers,
+                               const tinygltf::Primitive& primitive, const char* name) {
+    const auto iter = primitive.attributes.find(name);
+    if (iter == primitive.attributes.end()) {
+        return {};
+    }
+    return GetAccessorView(model, buffers, iter->second);
+}
 
-            if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE) {
-                const uint8_t* data = reinterpret_cast<const uint8_t*>(indexData);
-                for (size_t i = 0; i < indexAccessor.count; ++i) {
-                    indices.push_back(vertexOffset + data[i]);
-                }
-            } else if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT) {
-                const uint16_t* data = reinterpret_cast<const uint16_t*>(indexData);
-                for (size_t i = 0; i < indexAccessor.count; ++i) {
-                    indices.push_back(vertexOffset + static_cast<uint32_t>(data[i]));
-                }
-            } else if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT) {
-                const uint32_t* data = reinterpret_cast<const uint32_t*>(indexData);
-                for (size_t i = 0; i < indexAccessor.count; ++i) {
-                    indices.push_back(vertexOffset + data[i]);
-                }
-            } else {
-                assert(false && "Invalid index accessor component type");
-            }
+// Converts the first `components` components of every element to float, following the glTF
+// rules for normalized integers. Non-normalized integers (allowed by KHR_mesh_quantization for
+// positions and texture coordinates) keep their value; the node transform dequantizes them.
+template <typename T>
+void DequantizeAttribute(const AttributeView& view, size_t count, int components,
+                         size_t dstStride, float* dst) {
+    float scale = 1.0f;
+    float minValue = std::numeric_limits<float>::lowest();
+    if constexpr (std::is_integral_v<T>) {
+        if (view._normalized) {
+            scale = 1.0f / static_cast<float>(std::numeric_limits<T>::max());
+            minValue = std::is_signed_v<T> ? -1.0f : 0.0f;
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* element = view._data + i * view._stride;
+        for (int c = 0; c < components; ++c) {
+            T value;
+            std::memcpy(&value, element + c * sizeof(T), sizeof(T));
+            dst[i * dstStride + c] = std::max(static_cast<float>(value) * scale, minValue);
+        }
+    }
+}
+
+// Returns `view` unchanged when it already holds `components` floats per element. Otherwise
+// decodes it into `storage` as tightly packed floats, padding missing components from
+// `defaults` (e.g. the alpha of an RGB color), and returns a view of that.
+AttributeView DecodeAttribute(const AttributeView& view, size_t count, int components,
+                              const glm::vec4& defaults, std::vector<float>& storage) {
+    if (!view._data || (view._componentType == TINYGLTF_COMPONENT_TYPE_FLOAT &&
+                        view._components == components)) {
+        return view;
+    }
+
+    const auto dstStride = static_cast<size_t>(components);
+    storage.resize(count * dstStride);
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t c = 0; c < dstStride; ++c) {
+            storage[i * dstStride + c] = defaults[static_cast<int>(c)];
+        }
+    }
+
+    const int read = std::min(view._components, components);
+    float* dst = storage.data();
+    switch (view._componentType) {
+    case TINYGLTF_COMPONENT_TYPE_BYTE:
+        DequantizeAttribute<int8_t>(view, count, read, dstStride, dst);
+        break;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+        DequantizeAttribute<uint8_t>(view, count, read, dstStride, dst);
+        break;
+    case TINYGLTF_COMPONENT_TYPE_SHORT:
+        DequantizeAttribute<int16_t>(view, count, read, dstStride, dst);
+        break;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+        DequantizeAttribute<uint16_t>(view, count, read, dstStride, dst);
+        break;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+        DequantizeAttribute<uint32_t>(view, count, read, dstStride, dst);
+        break;
+    case TINYGLTF_COMPONENT_TYPE_FLOAT:
+        DequantizeAttribute<float>(view, count, read, dstStride, dst);
+        break;
+    default:
+        std::cerr << "Unsupported attribute component type: " << view._componentType
+                  << std::endl;
+        break;
+    }
+
+    return {reinterpret_cast<const uint8_t*>(dst), dstStride * sizeof(float),
+            TINYGLTF_COMPONENT_TYPE_FLOAT, components, false};
+}
+
+// Copies an untransformed attribute into every vertex, or fills in its default if absent.
+template <typename T>
+void CopyAttribute(const AttributeView& view, size_t count, const T& defaultValue,
+                   T Model::Vertex::*member, Model::Vertex* dst) {
+    if (!view._data) {
+        for (size_t i = 0; i < count; ++i) {
+            dst[i].*member = defaultValue;
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(&(dst[i].*member), view._data + i * view._stride, sizeof(T));
+    }
+}
+
+// Decodes one primitive into pre-sized slices of the shared vertex and index arrays.
+void ProcessPrimitive(const tinygltf::Model& model, const SourceBuffers& buffers,
+                      const PrimitiveJob& job,
+                      std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices,
+                      Model::SubMesh& subMesh) {
+    const tinygltf::Primitive& primitive = *job._primitive;
+    const glm::mat4& transform = job._transform;
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+    glm::mat3 tangentMatrix = glm::mat3(transform);
+
+    subMesh._firstIndex = static_cast<uint32_t>(job._firstIndex);
+    subMesh._firstVertex = static_cast<uint32_t>(job._firstVertex);
+    subMesh._vertexCount = static_cast<uint32_t>(job._vertexCount);
+    subMesh._materialIndex = primitive.material;
+    subMesh._firstInstance = job._firstInstance;
+    subMesh._instanceCount = job._instanceCount;
+    subMesh._instanced = job._instanced;
+    subMesh._minBounds = glm::vec3(std::numeric_limits<float>::max());
+    subMesh._maxBounds = glm::vec3(std::numeric_limits<float>::lowest());
+
+    const uint32_t vertexOffset = static_cast<uint32_t>(job._firstVertex);
+    Model::Vertex* dstVertices = vertices.data() + job._firstVertex;
+    uint32_t* dstIndices = indices.data() + job._firstIndex;
+
+    // Resolve attribute accessors. Only POSITION is required. Integer (quantized) and
+    // short-vector attributes are expanded to the float layout the kernels below expect.
+    const auto& positionAccessor = model.accessors[primitive.attributes.find("POSITION")->second];
+    const size_t vertexCount = job._vertexCount;
+    const auto resolve = [&](const char* name, int components, const glm::vec4& defaults,
+                             std::vector<float>& storage) {
+        const AttributeView view = GetAttributeView(model, buffers, primitive, name);
+        return DecodeAttribute(view, vertexCount, components, defaults, storage);
+    };
+    std::vector<float> positionStorage, normalStorage, tangentStorage;
+    std::vector<float> texCoord0Storage, texCoord1Storage, colorStorage;
+    const glm::vec4 unitW(0.0f, 0.0f, 0.0f, 1.0f);
+    const AttributeView positions = resolve("POSITION", 3, unitW, positionStorage);
+    const AttributeView normals = resolve("NORMAL", 3, unitW, normalStorage);
+    const AttributeView tangents = resolve("TANGENT", 4, unitW, tangentStorage);
+    const AttributeView texCoords0 = resolve("TEXCOORD_0", 2, unitW, texCoord0Storage);
+    const AttributeView texCoords1 = resolve("TEXCOORD_1", 2, unitW, texCoord1Storage);
+    const AttributeView colors = resolve("COLOR_0", 4, glm::vec4(1.0f), colorStorage);
+
+    // Each attribute is decoded in its own pass over the whole range, so the presence checks
+    // happen once per primitive rather than once per vertex.
+    vertex_kernels::TransformPositions(positions._data, positions._stride, vertexCount, transform,
+                                       dstVertices, subMesh._minBounds, subMesh._maxBounds);
+
+    // Normal (default to 0, 0, 1 if not provided).
+    if (normals._data) {
+        vertex_kernels::TransformNormals(normals._data, normals._stride, vertexCount,
+                                         normalMatrix, dstVertices);
+    } else {
+        const glm::vec3 defaultNormal = glm::normalize(normalMatrix * glm::vec3(0.0f, 0.0f, 1.0f));
+        for (size_t i = 0; i < vertexCount; ++i) {
+            dstVertices[i]._normal = defaultNormal;
+        }
+    }
+
+    // Tangent (default to 0, 0, 0, 1 if not provided, until a normal map needs real ones).
+    subMesh._hasTangents = tangents._data != nullptr;
+    if (tangents._data) {
+        vertex_kernels::TransformTangents(tangents._data, tangents._stride, vertexCount,
+                                          tangentMatrix, dstVertices);
+    } else {
+        CopyAttribute(tangents, vertexCount, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f),
+                      &Model::Vertex::_tangent, dstVertices);
+    }
+
+    // Texture coordinates (default to 0, 0 if not provided).
+    CopyAttribute(texCoords0, vertexCount, glm::vec2(0.0f, 0.0f), &Model::Vertex::_texCoord0,
+                  dstVertices);
+    CopyAttribute(texCoords1, vertexCount, glm::vec2(0.0f, 0.0f), &Model::Vertex::_texCoord1,
+                  dstVertices);
+
+    // Color (default to white if not provided).
+    CopyAttribute(colors, vertexCount, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f), &Model::Vertex::_color,
+                  dstVertices);
+
+    // Access indices (if present).
+    if (primitive.indices >= 0) {
+        const auto& indexAccessor = model.accessors[primitive.indices];
+        const auto& indexBufferView = model.bufferViews[indexAccessor.bufferView];
+        const void* indexData = buffers.GetData(indexBufferView.buffer) +
+                                indexBufferView.byteOffset + indexAccessor.byteOffset;
+
+        if (indexAccessor.count > std::numeric_limits<uint32_t>::max()) {
+            std::cerr << "Error: Index accessor count exceeds 32-bit limit: "
+                      << indexAccessor.count << std::endl;
+            subMesh._indexCount = std::numeric_limits<uint32_t>::max();
         } else {
-            // Non-indexed mesh: generate sequential indices.
-            if (positionAccessor.count > std::numeric_limits<uint32_t>::max()) {
-                std::cerr << "Error: Position accessor count exceeds 32-bit limit: "
-                          << positionAccessor.count << std::endl;
-                subMesh._indexCount = std::numeric_limits<uint32_t>::max();
-            } else {
-                subMesh._indexCount = static_cast<uint32_t>(positionAccessor.count);
-            }
+            subMesh._indexCount = static_cast<uint32_t>(indexAccessor.count);
+        }
 
-            for (uint32_t i = 0; i < positionAccessor.count; ++i) {
-                indices.push_back(vertexOffset + i);
+        if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE) {
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(indexData);
+            for (size_t i = 0; i < indexAccessor.count; ++i) {
+                dstIndices[i] = vertexOffset + data[i];
+            }
+        } else if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT) {
+            const uint16_t* data = reinterpret_cast<const uint16_t*>(indexData);
+            for (size_t i = 0; i < indexAccessor.count; ++i) {
+                dstIndices[i] = vertexOffset + static_cast<uint32_t>(data[i]);
             }
+        } else if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT) {
+            const uint32_t* data = reinterpret_cast<const uint32_t*>(indexData);
+            for (size_t i = 0; i < indexAccessor.count; ++i) {
+                dstIndices[i] = vertexOffset + data[i];
+            }
+        } else {
+            assert(false && "Invalid index accessor component type");
+        }
+    } else {
+        // Non-indexed mesh: generate sequential indices.
+        if (positionAccessor.count > std::numeric_limits<uint32_t>::max()) {
+            std::cerr << "Error: Position accessor count exceeds 32-bit limit: "
+                      << positionAccessor.count << std::endl;
+            subMesh._indexCount = std::numeric_limits<uint32_t>::max();
+        } else {
+            subMesh._indexCount = static_cast<uint32_t>(positionAccessor.count);
         }
 
-        if (!tangentData) {
-            // Generate tangents if not provided.
-            std::cout << "Generating tangents for submesh " << subMeshes.size() << std::endl;
-            mesh_utils::GenerateTangents(subMesh, vertices, indices);
+        for (uint32_t i = 0; i < positionAccessor.count; ++i) {
+            dstIndices[i] = vertexOffset + i;
         }
+    }
+}
 
-        subMeshes.push_back(subMesh);
+// Records the buffer view and buffer behind an accessor, once each.
+void AddAccessorSource(const tinygltf::Model& model, int accessorIndex, PrimitiveJob& job) {
+    if (accessorIndex < 0 || model.accessors[accessorIndex].bufferView < 0) {
+        return;
+    }
+    const int bufferView = model.accessors[accessorIndex].bufferView;
+    if (std::find(job._bufferViews.begin(), job._bufferViews.end(), bufferView) ==
+        job._bufferViews.end()) {
+        job._bufferViews.push_back(bufferView);
+    }
+    const int buffer = model.bufferViews[bufferView].buffer;
+    if (std::find(job._buffers.begin(), job._buffers.end(), buffer) == job._buffers.end()) {
+        job._buffers.push_back(buffer);
     }
 }
 
-void ProcessNode(const tinygltf::Model& model, int nodeIndex, const glm::mat4& parentTransform,
-                 std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices,
-                 std::vector<Model::SubMesh>& subMeshes) {
+// Walks the node hierarchy and records every node that places a mesh, in traversal order.
+void CollectPlacements(const tinygltf::Model& model, int nodeIndex,
+                       const glm::mat4& parentTransform, std::vector<MeshPlacement>& placements) {
     const tinygltf::Node& node = model.nodes[nodeIndex];
-
     // Compute the local transformation matrix.
     glm::mat4 localTransform(1.0f);
 
@@ -282,19 +516,328 @@ void ProcessNode(const tinygltf::Model& model, int nodeIndex, const glm::mat4& p
     // Combine with parent transform.
     glm::mat4 globalTransform = parentTransform * localTransform;
 
-    // If this node has a mesh, process it.
+    // If this node has a mesh, record where it goes.
     if (node.mesh >= 0) {
-        const tinygltf::Mesh& mesh = model.meshes[node.mesh];
-        ProcessMesh(model, mesh, vertices, indices, subMeshes, globalTransform);
+        MeshPlacement placement;
+        placement._mesh = node.mesh;
+        placement._transform = globalTransform;
+        const auto extension = node.extensions.find(kInstancingExtension);
+        if (extension != node.extensions.end() && extension->second.Has("attributes")) {
+            const tinygltf::Value& attributes = extension->second.Get("attributes");
+            const auto accessor = [&](const char* name) {
+                const int index = attributes.Has(name) ? attributes.Get(name).GetNumberAsInt() : -1;
+                return index < static_cast<int>(model.accessors.size()) ? index : -1;
+            };
+            placement._translation = accessor("TRANSLATION");
+            placement._rotation = accessor("ROTATION");
+            placement._scale = accessor("SCALE");
+        }
+        placements.push_back(placement);
     }
 
     // Recursively process children nodes.
     for (int childIndex : node.children) {
-        ProcessNode(model, childIndex, globalTransform, vertices, indices, subMeshes);
+        CollectPlacements(model, childIndex, globalTransform, placements);
+    }
+}
+
+bool UsesGpuInstancing(const MeshPlacement& placement) {
+    return placement._translation >= 0 || placement._rotation >= 0 || placement._scale >= 0;
+}
+
+// Schedules the primitives of every placed mesh once. A mesh with a single plain placement gets
+// its node transform baked in; meshes placed several times or through EXT_mesh_gpu_instancing
+// stay in mesh space and are marked instanced.
+void CollectPrimitives(const tinygltf::Model& model, const std::vector<MeshPlacement>& placements,
+                       std::vector<PrimitiveJob>& jobs) {
+    std::vector<size_t> placementCounts(model.meshes.size(), 0);
+    std::vector<bool> gpuInstanced(model.meshes.size(), false);
+    for (const MeshPlacement& placement : placements) {
+        ++placementCounts[placement._mesh];
+        if (UsesGpuInstancing(placement)) {
+            gpuInstanced[placement._mesh] = true;
+        }
+    }
+
+    std::vector<bool> scheduled(model.meshes.size(), false);
+    for (const MeshPlacement& placement : placements) {
+        if (scheduled[placement._mesh]) {
+            continue;
+        }
+        scheduled[placement._mesh] = true;
+        const bool instanced =
+            placementCounts[placement._mesh] > 1 || gpuInstanced[placement._mesh];
+
+        const tinygltf::Mesh& mesh = model.meshes[placement._mesh];
+        for (const auto& primitive : mesh.primitives) {
+            if (primitive.material < 0) {
+                // TODO: Handle this in another way? Assign 'default' material?
+                continue;
+            }
+
+            const auto& positionAccessor =
+                model.accessors[primitive.attributes.find("POSITION")->second];
+
+            PrimitiveJob job;
+            job._primitive = &primitive;
+            for (const char* name : kExtractedAttributes) {
+                const auto iter = primitive.attributes.find(name);
+                if (iter != primitive.attributes.end()) {
+                    AddAccessorSource(model, iter->second, job);
+                }
+            }
+            AddAccessorSource(model, primitive.indices, job);
+            job._transform = instanced ? glm::mat4(1.0f) : placement._transform;
+            job._mesh = placement._mesh;
+            job._instanced = instanced;
+            job._vertexCount = positionAccessor.count;
+            job._indexCount = primitive.indices >= 0 ? model.accessors[primitive.indices].count
+                                                     : positionAccessor.count;
+            jobs.push_back(job);
+        }
+    }
+}
+
+// Fills `instanceTransforms` and every job's instance range. Index 0 is the identity shared by
+// the baked submeshes; each instanced mesh then gets one transform per placement, expanded to
+// one per instance for EXT_mesh_gpu_instancing nodes (node transform * T * R * S). The primitives
+// of a mesh share its range.
+void ExpandInstances(const tinygltf::Model& model, const SourceBuffers& buffers,
+                     const std::vector<MeshPlacement>& placements, std::vector<PrimitiveJob>& jobs,
+                     std::vector<glm::mat4>& instanceTransforms) {
+    instanceTransforms.assign(1, glm::mat4(1.0f));
+    std::vector<uint32_t> firstInstance(model.meshes.size(), 0);
+    std::vector<uint32_t> instanceCount(model.meshes.size(), 0);
+    std::vector<bool> expanded(model.meshes.size(), false);
+    for (const PrimitiveJob& job : jobs) {
+        if (!job._instanced || expanded[job._mesh]) {
+            continue;
+        }
+        expanded[job._mesh] = true;
+        firstInstance[job._mesh] = static_cast<uint32_t>(instanceTransforms.size());
+
+        for (const MeshPlacement& placement : placements) {
+            if (placement._mesh != job._mesh) {
+                continue;
+            }
+            if (!UsesGpuInstancing(placement)) {
+                instanceTransforms.push_back(placement._transform);
+                continue;
+            }
+
+            // Every attribute accessor holds one element per instance.
+            size_t count = std::numeric_limits<size_t>::max();
+            for (int accessor : {placement._translation, placement._rotation, placement._scale}) {
+                if (accessor >= 0) {
+                    count = std::min(count, model.accessors[accessor].count);
+                }
+            }
+            std::vector<float> translationStorage, rotationStorage, scaleStorage;
+            const auto decode = [&](int accessor, int components, const glm::vec4& defaults,
+                                    std::vector<float>& storage) {
+                return DecodeAttribute(GetAccessorView(model, buffers, accessor), count,
+                                       components, defaults, storage);
+            };
+            const AttributeView translations =
+                decode(placement._translation, 3, glm::vec4(0.0f), translationStorage);
+            const AttributeView rotations =
+                decode(placement._rotation, 4, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), rotationStorage);
+            const AttributeView scales = decode(placement._scale, 3, glm::vec4(1.0f), scaleStorage);
+
+            for (size_t i = 0; i < count; ++i) {
+                glm::vec3 translation(0.0f);
+                glm::vec4 rotation(0.0f, 0.0f, 0.0f, 1.0f);
+                glm::vec3 scale(1.0f);
+                if (translations._data) {
+                    std::memcpy(&translation, translations._data + i * translations._stride,
+                                sizeof(translation));
+                }
+                if (rotations._data) {
+                    std::memcpy(&rotation, rotations._data + i * rotations._stride,
+                                sizeof(rotation));
+                }
+                if (scales._data) {
+                    std::memcpy(&scale, scales._data + i * scales._stride, sizeof(scale));
+                }
+                const glm::quat quaternion(rotation.w, rotation.x, rotation.y, rotation.z);
+                const glm::mat4 local = glm::translate(glm::mat4(1.0f), translation) *
+                                        glm::mat4_cast(quaternion) *
+                                        glm::scale(glm::mat4(1.0f), scale);
+                instanceTransforms.push_back(placement._transform * local);
+            }
+        }
+        instanceCount[job._mesh] =
+            static_cast<uint32_t>(instanceTransforms.size()) - firstInstance[job._mesh];
+    }
+
+    for (PrimitiveJob& job : jobs) {
+        if (job._instanced) {
+            job._firstInstance = firstInstance[job._mesh];
+            job._instanceCount = instanceCount[job._mesh];
+        }
+    }
+}
+
+// The encoded bytes of an image: in place in its buffer view, or the copy captured while parsing.
+// Empty for external files that have not been read yet.
+const uint8_t* GetEncodedBytes(const tinygltf::Model& model, const SourceBuffers& buffers,
+                               const EncodedImage& encoded, size_t& size) {
+    if (encoded._bufferView >= 0) {
+        const tinygltf::BufferView& bufferView = model.bufferViews[encoded._bufferView];
+        size = bufferView.byteLength;
+        return buffers.GetData(bufferView.buffer) + bufferView.byteOffset;
+    }
+    size = encoded._ownedBytes.size();
+    return encoded._ownedBytes.data();
+}
+
+// Maps glTF textures to images, which is what Model::Material's texture slots index.
+// KHR_texture_basisu points a texture at a KTX2 image and keeps `source` as an optional PNG or
+// JPEG fallback, which is used when the KTX2 payload is one ktx2::ReadTexture cannot read.
+// Images that textures reference but none ends up using are flagged in `skipImages` so they are
+// never decoded.
+std::vector<int> ResolveTextureImages(const tinygltf::Model& model, const SourceBuffers& buffers,
+                                      std::vector<EncodedImage>& encodedImages,
+                                      const std::string& basePath, std::vector<bool>& skipImages) {
+    std::vector<int> textureImages(model.textures.size(), -1);
+    std::vector<bool> referenced(model.images.size(), false);
+    std::vector<bool> used(model.images.size(), false);
+    const auto isImage = [&](int image) {
+        return image >= 0 && static_cast<size_t>(image) < model.images.size();
+    };
+
+    for (size_t i = 0; i < model.textures.size(); ++i) {
+        const tinygltf::Texture& texture = model.textures[i];
+        textureImages[i] = texture.source;
+
+        const auto extension = texture.extensions.find(kBasisuExtension);
+        if (extension == texture.extensions.end() || !extension->second.Has("source")) {
+            continue;
+        }
+        const int ktx2Image = extension->second.Get("source").GetNumberAsInt();
+        if (!isImage(ktx2Image)) {
+            continue;
+        }
+        referenced[ktx2Image] = true;
+        if (isImage(texture.source)) {
+            referenced[texture.source] = true;
+        }
+
+        // Without a fallback there is nothing to choose; ProcessImage reports failures.
+        bool readable = true;
+        if (isImage(texture.source)) {
+            EncodedImage& encoded = encodedImages[ktx2Image];
+            const tinygltf::Image& image = model.images[ktx2Image];
+            if (encoded._bufferView < 0 && encoded._ownedBytes.empty() && !image.uri.empty()) {
+                std::ifstream file(basePath + "/" + image.uri, std::ios::binary);
+                encoded._ownedBytes.assign(std::istreambuf_iterator<char>(file), {});
+            }
+            size_t size = 0;
+            const uint8_t* bytes = GetEncodedBytes(model, buffers, encoded, size);
+            std::string reason;
+            readable = ktx2::CheckSupported(bytes, size, reason);
+            if (!readable) {
+                std::cout << "Texture " << i << ": using fallback image, KTX2 image " << ktx2Image
+                          << " is unsupported (" << reason << ")" << std::endl;
+            }
+        }
+        if (readable) {
+            textureImages[i] = ktx2Image;
+        }
+    }
+
+    for (int image : textureImages) {
+        if (isImage(image)) {
+            used[image] = true;
+        }
+    }
+    skipImages.assign(model.images.size(), false);
+    for (size_t i = 0; i < model.images.size(); ++i) {
+        skipImages[i] = referenced[i] && !used[i];
+    }
+    return textureImages;
+}
+
+// Picks a block format per image: BC7 for color (base color, emissive), BC5 for normal maps,
+// BC4 for occlusion alone and BC1 for metallic-roughness, which keeps occlusion in red when an
+// ORM texture packs it there. Images sampled by slots that disagree get BC7, which keeps every
+// channel.
+std::vector<ImageCompression> PlanTextureCompression(const tinygltf::Model& model,
+                                                     const std::vector<int>& textureImages) {
+    using Format = Model::TextureFormat;
+    using texture_codecs::MipFilter;
+    enum Usage : uint32_t {
+        kColor = 1,
+        kNormal = 2,
+        kOcclusion = 4,
+        kMetallicRoughness = 8,
+    };
+
+    std::vector<uint32_t> usage(model.images.size(), 0);
+    const auto use = [&](int texture, uint32_t slot) {
+        if (texture >= 0 && static_cast<size_t>(texture) < textureImages.size() &&
+            textureImages[texture] >= 0) {
+            usage[textureImages[texture]] |= slot;
+        }
+    };
+    for (const tinygltf::Material& material : model.materials) {
+        use(material.pbrMetallicRoughness.baseColorTexture.index, kColor);
+        use(material.emissiveTexture.index, kColor);
+        use(material.normalTexture.index, kNormal);
+        use(material.occlusionTexture.index, kOcclusion);
+        use(material.pbrMetallicRoughness.metallicRoughnessTexture.index, kMetallicRoughness);
+    }
+
+    std::vector<ImageCompression> plan(model.images.size());
+    for (size_t i = 0; i < plan.size(); ++i) {
+        ImageCompression& compression = plan[i];
+        compression._enabled = usage[i] != 0;
+        switch (usage[i]) {
+        case kColor:
+            compression._format = Format::BC7;
+            compression._filter = MipFilter::Srgb;
+            break;
+        case kNormal:
+            compression._format = Format::BC5;
+            compression._filter = MipFilter::Normal;
+            break;
+        case kOcclusion:
+            compression._format = Format::BC4;
+            break;
+        case kMetallicRoughness:
+        case kMetallicRoughness | kOcclusion:
+            compression._format = Format::BC1;
+            break;
+        default:
+            compression._format = Format::BC7;
+            break;
+        }
     }
+    return plan;
 }
 
-void ProcessMaterial(const tinygltf::Material& material, std::vector<Model::Material>& materials) {
+// Cache file of an encoded image: FNV-1a of its bytes, the target format and the encoder version.
+std::filesystem::path GetTextureCachePath(const std::string& cacheDir, const uint8_t* bytes,
+                                          size_t size, const ImageCompression& compression) {
+    uint64_t hash = 14695981039346656037ull;
+    const auto mix = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    };
+    for (size_t i = 0; i < size; ++i) {
+        mix(bytes[i]);
+    }
+    mix(static_cast<uint64_t>(compression._format));
+    mix(static_cast<uint64_t>(compression._filter));
+    mix(texture_codecs::kEncoderVersion);
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.ktx2", static_cast<unsigned long long>(hash));
+    return std::filesystem::path(cacheDir) / name;
+}
+
+void ProcessMaterial(const tinygltf::Material& material, const std::vector<int>& textureImages,
+                     std::vector<Model::Material>& materials) {
     Model::Material mat;
 
     // Copy scalar and vector properties.
@@ -316,28 +859,107 @@ void ProcessMaterial(const tinygltf::Material& material, std::vector<Model::Mate
         mat._alphaMode = Model::AlphaMode::Opaque;
     }
 
-    // Copy texture indices.
-    mat._baseColorTexture = material.pbrMetallicRoughness.baseColorTexture.index;
-    mat._metallicRoughnessTexture = material.pbrMetallicRoughness.metallicRoughnessTexture.index;
-    mat._normalTexture = material.normalTexture.index;
-    mat._emissiveTexture = material.emissiveTexture.index;
-    mat._occlusionTexture = material.occlusionTexture.index;
+    // Copy texture indices, as image indices.
+    const auto image = [&](int texture) {
+        return texture >= 0 && static_cast<size_t>(texture) < textureImages.size()
+                   ? textureImages[texture]
+                   : -1;
+    };
+    mat._baseColorTexture = image(material.pbrMetallicRoughness.baseColorTexture.index);
+    mat._metallicRoughnessTexture =
+        image(material.pbrMetallicRoughness.metallicRoughnessTexture.index);
+    mat._normalTexture = image(material.normalTexture.index);
+    mat._emissiveTexture = image(material.emissiveTexture.index);
+    mat._occlusionTexture = image(material.occlusionTexture.index);
 
     materials.push_back(mat);
 }
 
-void ProcessImage(const tinygltf::Image& image, const std::string& basePath,
-                  std::vector<Model::Texture>& textures) {
+// Image loader callback that only captures where the encoded bytes are, so decoding can run on
+// the worker pool once parsing is done instead of serially inside tinygltf.
+bool DeferImageDecode(tinygltf::Image* image, const int imageIndex, std::string* err,
+                      std::string* warn, int reqWidth, int reqHeight, const unsigned char* bytes,
+                      int size, void* userData) {
+    (void)err;
+    (void)warn;
+    (void)reqWidth;
+    (void)reqHeight;
+
+    auto& encodedImages = *static_cast<std::vector<EncodedImage>*>(userData);
+    if (encodedImages.size() <= static_cast<size_t>(imageIndex)) {
+        encodedImages.resize(imageIndex + 1);
+    }
+    EncodedImage& encoded = encodedImages[imageIndex];
 
-    Model::Texture texture;
+    // Buffer views stay valid after parsing, so those images are read in place later.
+    if (image->bufferView >= 0) {
+        encoded._bufferView = image->bufferView;
+    } else {
+        encoded._ownedBytes.assign(bytes, bytes + size);
+    }
+    return true;
+}
+
+// Decodes encoded image bytes the way tinygltf would (forced RGBA, 16 bits per channel when the
+// source has them), keeping the decoder's allocation as the texture storage.
+bool DecodeImage(const uint8_t* bytes, size_t byteCount, Model::Texture& texture) {
+    const int size = static_cast<int>(byteCount);
+    int width = 0;
+    int height = 0;
+    int components = 0;
+    int bytesPerChannel = 1;
+    uint8_t* pixels = nullptr;
+
+    if (stbi_is_16_bit_from_memory(bytes, size)) {
+        pixels = reinterpret_cast<uint8_t*>(
+            stbi_load_16_from_memory(bytes, size, &width, &height, &components, 4));
+        bytesPerChannel = 2;
+    }
+    if (!pixels) {
+        pixels = stbi_load_from_memory(bytes, size, &width, &height, &components, 4);
+        bytesPerChannel = 1;
+    }
+    if (!pixels) {
+        return false;
+    }
+
+    texture._width = width;
+    texture._height = height;
+    texture._components = 4;
+    texture._data = Model::ImageData(pixels, static_cast<size_t>(width) * height * 4 *
+                                                 bytesPerChannel);
+    return true;
+}
+
+void ProcessImage(const tinygltf::Model& model, const SourceBuffers& buffers, int imageIndex,
+                  EncodedImage& encoded, const std::string& basePath, Model::Texture& texture) {
+    const tinygltf::Image& image = model.images[imageIndex];
     texture._name = image.name;
-    texture._width = image.width;
-    texture._height = image.height;
-    texture._components = image.component;
 
-    if (!image.image.empty()) {
-        // Image data is embedded.
-        texture._data = image.image;
+    // External KTX2 files are read here; stb_image loads the other external images itself.
+    if (encoded._bufferView < 0 && encoded._ownedBytes.empty() && !image.uri.empty() &&
+        (image.mimeType == "image/ktx2" || image.uri.ends_with(".ktx2"))) {
+        std::ifstream file(basePath + "/" + image.uri, std::ios::binary);
+        encoded._ownedBytes.assign(std::istreambuf_iterator<char>(file), {});
+    }
+
+    size_t byteCount = 0;
+    const uint8_t* bytes = GetEncodedBytes(model, buffers, encoded, byteCount);
+
+    if (byteCount > 0 && ktx2::IsKtx2(bytes, byteCount)) {
+        std::string err;
+        if (!ktx2::ReadTexture(bytes, byteCount, texture, err)) {
+            std::cerr << "Failed to read KTX2 image " << texture._name << ": " << err
+                      << std::endl;
+        }
+        std::vector<uint8_t>().swap(encoded._ownedBytes);
+    } else if (byteCount > 0) {
+        // Image data is embedded (or was fetched by tinygltf).
+        if (!DecodeImage(bytes, byteCount, texture)) {
+            std::cerr << "Failed to decode image " << texture._name << ": "
+                      << stbi_failure_reason() << std::endl;
+        }
+        std::vector<uint8_t>().swap(encoded._ownedBytes);
     } else if (!image.uri.empty()) {
         // Image data is external, load it using stb_image.
         std::string imagePath = basePath + "/" + image.uri;
@@ -347,9 +969,8 @@ void ProcessImage(const tinygltf::Image& image, const std::string& basePath,
         if (data) {
             texture._width = width;
             texture._height = height;
-            texture._components = components;
-            texture._data = std::vector<uint8_t>(data, data + (width * height * components));
-            stbi_image_free(data);
+            texture._components = 4;
+            texture._data = Model::ImageData(data, static_cast<size_t>(width) * height * 4);
         } else {
             std::cerr << "Failed to load image: " << imagePath << std::endl;
         }
@@ -357,33 +978,627 @@ void ProcessImage(const tinygltf::Image& image, const std::string& basePath,
         std::cerr << "Warning: Texture " << texture._name << " has no valid image source."
                   << std::endl;
     }
+}
+
+// ProcessImage followed by block compression, reading from and filling the texture cache when
+// there is one. A cache hit skips decoding the image altogether. Images that are already KTX2 or
+// have 16-bit channels keep their format.
+void ProcessCompressedImage(const tinygltf::Model& model, const SourceBuffers& buffers,
+                            int imageIndex, EncodedImage& encoded, const std::string& basePath,
+                            const ImageCompression& compression, const std::string& cacheDir,
+                            Model::Texture& texture, CompressionStats& stats) {
+    const tinygltf::Image& image = model.images[imageIndex];
+    std::filesystem::path cachePath;
+    if (!cacheDir.empty()) {
+        // External images are hashed too, so read them here rather than through stb_image.
+        if (encoded._bufferView < 0 && encoded._ownedBytes.empty() && !image.uri.empty()) {
+            std::ifstream file(basePath + "/" + image.uri, std::ios::binary);
+            encoded._ownedBytes.assign(std::istreambuf_iterator<char>(file), {});
+        }
+        size_t byteCount = 0;
+        const uint8_t* bytes = GetEncodedBytes(model, buffers, encoded, byteCount);
+        if (byteCount > 0 && !ktx2::IsKtx2(bytes, byteCount)) {
+            cachePath = GetTextureCachePath(cacheDir, bytes, byteCount, compression);
+            std::ifstream file(cachePath, std::ios::binary);
+            const std::vector<uint8_t> cached{std::istreambuf_iterator<char>(file), {}};
+            std::string err;
+            if (!cached.empty() && ktx2::ReadTexture(cached.data(), cached.size(), texture, err) &&
+                texture._format == compression._format) {
+                texture._name = image.name;
+                std::vector<uint8_t>().swap(encoded._ownedBytes);
+                ++stats._cacheHits;
+                stats._rgba8Bytes += static_cast<size_t>(texture._width) * texture._height * 4;
+                stats._compressedBytes += texture._data.size();
+                return;
+            }
+            texture = Model::Texture();
+        }
+    }
+
+    ProcessImage(model, buffers, imageIndex, encoded, basePath, texture);
+    const size_t rgba8Bytes = texture._data.size();
+    const auto start = std::chrono::high_resolution_clock::now();
+    if (!texture_codecs::CompressTexture(texture, compression._format, compression._filter)) {
+        return;
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    ++stats._encoded;
+    stats._encodeMicroseconds +=
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    stats._rgba8Bytes += rgba8Bytes;
+    stats._compressedBytes += texture._data.size();
+
+    // Written under a unique name and renamed, so concurrent loads never read a partial file.
+    std::vector<uint8_t> file;
+    if (cachePath.empty() || !ktx2::WriteTexture(texture, file)) {
+        return;
+    }
+    std::error_code error;
+    std::filesystem::create_directories(cachePath.parent_path(), error);
+    std::filesystem::path tempPath = cachePath;
+    tempPath += "." + std::to_string(imageIndex) + ".tmp";
+    std::ofstream stream(tempPath, std::ios::binary);
+    stream.write(reinterpret_cast<const char*>(file.data()),
+                 static_cast<std::streamsize>(file.size()));
+    stream.close();
+    if (!stream.good()) {
+        // A short write (e.g. a full disk) must not become a truncated cache entry.
+        std::cerr << "Failed to write texture cache file " << tempPath << std::endl;
+        std::filesystem::remove(tempPath, error);
+        return;
+    }
+    std::filesystem::rename(tempPath, cachePath, error);
+    if (error) {
+        std::cerr << "Failed to write texture cache file " << cachePath << ": " << error.message()
+                  << std::endl;
+        std::filesystem::remove(tempPath, error);
+    }
+}
+
+// Appends a little-endian 32-bit value (GLB header and chunk fields).
+void AppendU32(std::vector<uint8_t>& bytes, uint32_t value) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&value);
+    bytes.insert(bytes.end(), data, data + sizeof(value));
+}
+
+// EXT_meshopt_compression fallback buffers have no uri and no bytes in the file, which tinygltf
+// rejects: a uri-less buffer must fit in the BIN chunk and a .gltf may not have one at all. Each
+// is given a one-byte data uri instead; DecodeMeshoptBufferViews later sizes and fills it.
+// Returns whether any buffer was rewritten.
+bool StubMeshoptFallbackBuffers(nlohmann::json& document) {
+    bool stubbed = false;
+    auto buffers = document.find("buffers");
+    if (buffers == document.end() || !buffers->is_array()) {
+        return false;
+    }
+    for (nlohmann::json& buffer : *buffers) {
+        if (!buffer.is_object() || buffer.contains("uri")) {
+            continue;
+        }
+        const auto extensions = buffer.find("extensions");
+        if (extensions != buffer.end() && extensions->is_object() &&
+            extensions->contains(kMeshoptExtension)) {
+            buffer["uri"] = "data:application/octet-stream;base64,AA==";
+            buffer["byteLength"] = 1;
+            stubbed = true;
+        }
+    }
+    return stubbed;
+}
+
+// Parses a glTF (binary or not) held in memory. Documents that use EXT_meshopt_compression are
+// handed to tinygltf with their fallback buffers stubbed; a GLB keeps its other chunks as is.
+bool LoadGltfFromMemory(tinygltf::TinyGLTF& loader, const uint8_t* bytes, size_t size,
+                        bool binary, const std::string& baseDir, tinygltf::Model& model,
+                        std::string& err, std::string& warn) {
+    const auto loadUnchanged = [&]() {
+        return binary ? loader.LoadBinaryFromMemory(&model, &err, &warn, bytes,
+                                                    static_cast<unsigned int>(size), baseDir)
+                      : loader.LoadASCIIFromString(&model, &err, &warn,
+                                                   reinterpret_cast<const char*>(bytes),
+                                                   static_cast<unsigned int>(size), baseDir);
+    };
+
+    // Locate the JSON; anything malformed is left for tinygltf to report.
+    size_t jsonOffset = 0;
+    size_t jsonSize = size;
+    if (binary) {
+        uint32_t header[5] = {};
+        if (size < sizeof(header)) {
+            return loadUnchanged();
+        }
+        std::memcpy(header, bytes, sizeof(header));
+        if (header[0] != 0x46546C67 || header[4] != 0x4E4F534A ||
+            header[3] > size - sizeof(header)) {
+            return loadUnchanged();
+        }
+        jsonOffset = sizeof(header);
+        jsonSize = header[3];
+    }
+
+    const std::string_view json(reinterpret_cast<const char*>(bytes) + jsonOffset, jsonSize);
+    if (json.find(kMeshoptExtension) == std::string_view::npos) {
+        return loadUnchanged();
+    }
+    nlohmann::json document = nlohmann::json::parse(json.begin(), json.end(), nullptr, false);
+    if (document.is_discarded() || !document.is_object() ||
+        !StubMeshoptFallbackBuffers(document)) {
+        return loadUnchanged();
+    }
+
+    std::string rewrittenJson = document.dump();
+    if (!binary) {
+        return loader.LoadASCIIFromString(&model, &err, &warn, rewrittenJson.data(),
+                                          static_cast<unsigned int>(rewrittenJson.size()),
+                                          baseDir);
+    }
+
+    // Rewritten GLB: header, new JSON chunk (space padded) and the original remaining chunks.
+    rewrittenJson.resize((rewrittenJson.size() + 3) & ~size_t{3}, ' ');
+    const size_t chunksOffset = jsonOffset + jsonSize;
+    const size_t rewrittenSize = 12 + 8 + rewrittenJson.size() + (size - chunksOffset);
+    std::vector<uint8_t> rewritten;
+    rewritten.reserve(rewrittenSize);
+    AppendU32(rewritten, 0x46546C67); // "glTF"
+    AppendU32(rewritten, 2);
+    AppendU32(rewritten, static_cast<uint32_t>(rewrittenSize));
+    AppendU32(rewritten, static_cast<uint32_t>(rewrittenJson.size()));
+    AppendU32(rewritten, 0x4E4F534A); // "JSON"
+    rewritten.insert(rewritten.end(), rewrittenJson.begin(), rewrittenJson.end());
+    rewritten.insert(rewritten.end(), bytes + chunksOffset, bytes + size);
+    return loader.LoadBinaryFromMemory(&model, &err, &warn, rewritten.data(),
+                                       static_cast<unsigned int>(rewritten.size()), baseDir);
+}
+
+// Parses a memory-mapped GLB without copying its BIN chunk. tinygltf always copies the embedded
+// buffer into its own storage, so it is handed a rewritten document instead: the embedded buffer
+// shrinks to a 4-byte stub and the images are taken out and registered here, which keeps
+// tinygltf from touching the BIN chunk at all. SourceBuffers then reads the chunk in place.
+bool LoadMappedGlb(tinygltf::TinyGLTF& loader, const MappedGlb& glb, const std::string& baseDir,
+                   tinygltf::Model& model, std::vector<EncodedImage>& encodedImages,
+                   std::string& err, std::string& warn) {
+    constexpr uint32_t kStubBinSize = 4;
+
+    const std::string_view json = glb.GetJson();
+    nlohmann::json document = nlohmann::json::parse(json.begin(), json.end(), nullptr, false);
+    if (document.is_discarded() || !document.is_object()) {
+        err = "Invalid JSON chunk in glTF binary.";
+        return false;
+    }
+
+    StubMeshoptFallbackBuffers(document);
+
+    // The embedded buffer is the first one and has no uri.
+    bool hasEmbeddedBuffer = false;
+    auto buffers = document.find("buffers");
+    if (buffers != document.end() && buffers->is_array() && !buffers->empty() &&
+        (*buffers)[0].is_object() && !(*buffers)[0].contains("uri")) {
+        nlohmann::json& buffer = (*buffers)[0];
+        const size_t byteLength = buffer.value("byteLength", size_t{0});
+        if (!glb.GetBinData() || byteLength > glb.GetBinSize()) {
+            err = "Embedded buffer exceeds the BIN chunk of the glTF binary.";
+            return false;
+        }
+        buffer["byteLength"] = kStubBinSize;
+        hasEmbeddedBuffer = true;
+    }
+
+    nlohmann::json images = nlohmann::json::array();
+    if (auto iter = document.find("images"); iter != document.end()) {
+        images = std::move(*iter);
+        document.erase(iter);
+    }
+
+    // Stub GLB: header, rewritten JSON chunk (space padded) and the BIN stub if needed.
+    std::string stubJson = document.dump();
+    stubJson.resize((stubJson.size() + 3) & ~size_t{3}, ' ');
+    std::vector<uint8_t> stub;
+    const size_t stubSize = 12 + 8 + stubJson.size() + (hasEmbeddedBuffer ? 8 + kStubBinSize : 0);
+    stub.reserve(stubSize);
+    AppendU32(stub, 0x46546C67); // "glTF"
+    AppendU32(stub, 2);
+    AppendU32(stub, static_cast<uint32_t>(stubSize));
+    AppendU32(stub, static_cast<uint32_t>(stubJson.size()));
+    AppendU32(stub, 0x4E4F534A); // "JSON"
+    stub.insert(stub.end(), stubJson.begin(), stubJson.end());
+    if (hasEmbeddedBuffer) {
+        AppendU32(stub, kStubBinSize);
+        AppendU32(stub, 0x004E4942); // "BIN\0"
+        stub.insert(stub.end(), kStubBinSize, 0);
+    }
+
+    if (!loader.LoadBinaryFromMemory(&model, &err, &warn, stub.data(),
+                                     static_cast<unsigned int>(stub.size()), baseDir)) {
+        return false;
+    }
+
+    // Register the images the way DeferImageDecode would have.
+    encodedImages.resize(images.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        const nlohmann::json& source = images[i];
+        tinygltf::Image image;
+        if (source.is_object()) {
+            image.name = source.value("name", std::string());
+            image.uri = source.value("uri", std::string());
+            image.mimeType = source.value("mimeType", std::string());
+            image.bufferView = source.value("bufferView", -1);
+        }
+
+        if (image.bufferView >= static_cast<int>(model.bufferViews.size())) {
+            err = "image[" + std::to_string(i) + "] bufferView not found in the scene.";
+            return false;
+        }
+
+        if (image.bufferView >= 0) {
+            encodedImages[i]._bufferView = image.bufferView;
+        } else if (tinygltf::IsDataURI(image.uri)) {
+            std::string mimeType;
+            tinygltf::DecodeDataURI(&encodedImages[i]._ownedBytes, mimeType, image.uri, 0, false);
+            image.uri.clear();
+        }
+        // Any other uri is an external file, loaded by ProcessImage.
+
+        model.images.push_back(std::move(image));
+    }
+
+    return true;
+}
+
+// Decompresses EXT_meshopt_compression buffer views into their own (fallback) buffer, before
+// anything reads them. Views decode in parallel; each writes a disjoint range.
+bool DecodeMeshoptBufferViews(tinygltf::Model& model, const MappedGlb* mappedGlb,
+                              std::string& err, size_t& decodedViews, size_t& decodedBytes) {
+    struct DecodeJob {
+        const tinygltf::BufferView* _bufferView{nullptr};
+        meshopt_decoder::Mode _mode{meshopt_decoder::Mode::Attributes};
+        meshopt_decoder::Filter _filter{meshopt_decoder::Filter::None};
+        const uint8_t* _source{nullptr};
+        size_t _sourceSize{0};
+        size_t _count{0};
+        size_t _stride{0};
+    };
+
+    // Source bytes of a buffer: the mapped BIN chunk or tinygltf's copy.
+    const auto getBufferBytes = [&](size_t buffer, size_t& size) -> const uint8_t* {
+        if (mappedGlb && buffer == 0 && model.buffers[0].uri.empty()) {
+            size = mappedGlb->GetBinSize();
+            return mappedGlb->GetBinData();
+        }
+        size = model.buffers[buffer].data.size();
+        return model.buffers[buffer].data.data();
+    };
+
+    std::vector<DecodeJob> jobs;
+    std::vector<size_t> requiredSizes(model.buffers.size(), 0);
+    for (const tinygltf::BufferView& bufferView : model.bufferViews) {
+        const auto extension = bufferView.extensions.find(kMeshoptExtension);
+        if (extension == bufferView.extensions.end()) {
+            continue;
+        }
+
+        const tinygltf::Value& value = extension->second;
+        DecodeJob job;
+        job._bufferView = &bufferView;
+        const int sourceBuffer = value.Get("buffer").GetNumberAsInt();
+        const auto sourceOffset = static_cast<size_t>(value.Get("byteOffset").GetNumberAsDouble());
+        job._sourceSize = static_cast<size_t>(value.Get("byteLength").GetNumberAsDouble());
+        job._count = static_cast<size_t>(value.Get("count").GetNumberAsDouble());
+        job._stride = static_cast<size_t>(value.Get("byteStride").GetNumberAsInt());
+        const std::string filter =
+            value.Has("filter") ? value.Get("filter").Get<std::string>() : "NONE";
+        if (!meshopt_decoder::ParseMode(value.Get("mode").Get<std::string>(), job._mode) ||
+            !meshopt_decoder::ParseFilter(filter, job._filter)) {
+            err = "Unsupported EXT_meshopt_compression mode or filter.";
+            return false;
+        }
+
+        size_t sourceBufferSize = 0;
+        const uint8_t* sourceBytes =
+            sourceBuffer >= 0 && static_cast<size_t>(sourceBuffer) < model.buffers.size()
+                ? getBufferBytes(static_cast<size_t>(sourceBuffer), sourceBufferSize)
+                : nullptr;
+        const size_t target = static_cast<size_t>(bufferView.buffer);
+        if (!sourceBytes || sourceOffset + job._sourceSize > sourceBufferSize ||
+            job._count * job._stride > bufferView.byteLength ||
+            (mappedGlb && target == 0 && model.buffers[0].uri.empty())) {
+            err = "EXT_meshopt_compression buffer view is out of bounds.";
+            return false;
+        }
+        job._source = sourceBytes + sourceOffset;
+        requiredSizes[target] =
+            std::max(requiredSizes[target], bufferView.byteOffset + bufferView.byteLength);
+        jobs.push_back(job);
+    }
+
+    for (size_t i = 0; i < model.buffers.size(); ++i) {
+        if (model.buffers[i].data.size() < requiredSizes[i]) {
+            model.buffers[i].data.resize(requiredSizes[i]);
+        }
+    }
+
+    std::atomic<bool> failed{false};
+    ThreadPool::Shared().ParallelFor(jobs.size(), [&](size_t i) {
+        const DecodeJob& job = jobs[i];
+        uint8_t* dst =
+            model.buffers[job._bufferView->buffer].data.data() + job._bufferView->byteOffset;
+        if (!meshopt_decoder::DecodeBufferView(job._mode, job._filter, job._source,
+                                               job._sourceSize, job._count, job._stride, dst)) {
+            failed = true;
+        }
+    });
+    if (failed) {
+        err = "Malformed EXT_meshopt_compression data.";
+        return false;
+    }
 
-    textures.push_back(texture);
+    decodedViews = jobs.size();
+    decodedBytes = 0;
+    for (const DecodeJob& job : jobs) {
+        decodedBytes += job._count * job._stride;
+    }
+    return true;
 }
 
-void ProcessModel(const tinygltf::Model& model, std::vector<Model::Vertex>& vertices,
-                  std::vector<uint32_t>& indices, std::vector<Model::Material>& materials,
-                  std::vector<Model::Texture>& textures, std::vector<Model::SubMesh>& subMeshes) {
+void RunTangentGenerator(Model::TangentGenerator generator, const Model::SubMesh& subMesh,
+                         std::vector<Model::Vertex>& vertices,
+                         const std::vector<uint32_t>& indices) {
+    if (generator == Model::TangentGenerator::Fast) {
+        mesh_utils::GenerateTangentsFast(subMesh, vertices, indices);
+    } else {
+        mesh_utils::GenerateTangents(subMesh, vertices, indices);
+    }
+}
+
+// Generates tangents for subMeshes[jobs[i]] in parallel with the generator picked by `options`.
+// When validating, the other generator runs first and its result is the comparison baseline.
+void GenerateTangents(const Model::LoadOptions& options, const std::vector<size_t>& jobs,
+                      std::vector<Model::SubMesh>& subMeshes, std::vector<Model::Vertex>& vertices,
+                      const std::vector<uint32_t>& indices, TangentReport& report) {
+    using Clock = std::chrono::high_resolution_clock;
+    const Model::TangentGenerator generator = options._tangentGenerator;
+    const Model::TangentGenerator reference = generator == Model::TangentGenerator::Fast
+                                                  ? Model::TangentGenerator::MikkTSpace
+                                                  : Model::TangentGenerator::Fast;
+
+    std::vector<TangentReport> jobReports(jobs.size());
+    ThreadPool::Shared().ParallelFor(jobs.size(), [&](size_t i) {
+        Model::SubMesh& subMesh = subMeshes[jobs[i]];
+        TangentReport& jobReport = jobReports[i];
+        std::vector<glm::vec4> baseline;
+        if (options._validateTangents) {
+            auto t0 = Clock::now();
+            RunTangentGenerator(reference, subMesh, vertices, indices);
+            auto t1 = Clock::now();
+            jobReport._referenceMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+            baseline.resize(subMesh._vertexCount);
+            for (uint32_t k = 0; k < subMesh._vertexCount; ++k) {
+                baseline[k] = vertices[subMesh._firstVertex + k]._tangent;
+            }
+        }
+
+        auto t0 = Clock::now();
+        RunTangentGenerator(generator, subMesh, vertices, indices);
+        auto t1 = Clock::now();
+        jobReport._generateMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        subMesh._hasTangents = true;
+
+        if (options._validateTangents) {
+            mesh_utils::CompareTangents(baseline.data(), vertices.data() + subMesh._firstVertex,
+                                        subMesh._vertexCount, jobReport._deviation);
+        }
+    });
+
+    for (const TangentReport& jobReport : jobReports) {
+        report._generateMs += jobReport._generateMs;
+        report._referenceMs += jobReport._referenceMs;
+        report._deviation._vertexCount += jobReport._deviation._vertexCount;
+        report._deviation._totalDegrees += jobReport._deviation._totalDegrees;
+        report._deviation._maxDegrees =
+            std::max(report._deviation._maxDegrees, jobReport._deviation._maxDegrees);
+        report._deviation._handednessMismatches += jobReport._deviation._handednessMismatches;
+    }
+}
+
+void LogTangentValidation(const Model::LoadOptions& options, const TangentReport& report) {
+    const bool fast = options._tangentGenerator == Model::TangentGenerator::Fast;
+    const double mikkMs = fast ? report._referenceMs : report._generateMs;
+    const double fastMs = fast ? report._generateMs : report._referenceMs;
+    const mesh_utils::TangentDeviation& deviation = report._deviation;
+    const double meanDegrees =
+        deviation._vertexCount > 0 ? deviation._totalDegrees / deviation._vertexCount : 0.0;
+    std::cout << "Tangent validation: fast vs MikkTSpace over " << deviation._vertexCount
+              << " vertices: mean " << meanDegrees << " deg, max " << deviation._maxDegrees
+              << " deg, " << deviation._handednessMismatches
+              << " handedness mismatches; CPU time MikkTSpace " << mikkMs << "ms, fast " << fastMs
+              << "ms (" << (fastMs > 0.0 ? mikkMs / fastMs : 0.0) << "x)" << std::endl;
+}
+
+void ProcessModel(tinygltf::Model& model, const MappedGlb* mappedGlb,
+                  std::vector<EncodedImage>& encodedImages, const std::string& basePath,
+                  std::vector<Model::Vertex>& vertices, std::vector<uint32_t>& indices,
+                  std::vector<Model::Material>& materials, std::vector<Model::Texture>& textures,
+                  std::vector<Model::SubMesh>& subMeshes,
+                  std::vector<glm::mat4>& instanceTransforms, const Model::LoadOptions& options,
+                  LoadTimings& timings, CompressionStats& compressionStats,
+                  PeakMemoryTracker& memoryTracker) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+
+    // Phase 1: Count. Collect primitives in traversal order and place each one in the shared
+    // arrays via prefix sums, so the extraction pass can write without synchronization.
+    std::vector<MeshPlacement> placements;
     if (model.scenes.size() > 0) {
         const tinygltf::Scene& scene =
             model.scenes[model.defaultScene > -1 ? model.defaultScene : 0];
 
         for (int nodeIndex : scene.nodes) {
-            ProcessNode(model, nodeIndex, glm::mat4(1.0f), vertices, indices, subMeshes);
+            CollectPlacements(model, nodeIndex, glm::mat4(1.0f), placements);
+        }
+    }
+    std::vector<PrimitiveJob> jobs;
+    CollectPrimitives(model, placements, jobs);
+
+    for (const PrimitiveJob& job : jobs) {
+        for (const char* name : kExtractedAttributes) {
+            const auto iter = job._primitive->attributes.find(name);
+            if (iter != job._primitive->attributes.end() &&
+                model.accessors[iter->second].componentType != TINYGLTF_COMPONENT_TYPE_FLOAT) {
+                ++timings._quantizedAttributes;
+            }
+        }
+    }
+
+    // Register every reader of every buffer before anything is decoded, so no buffer can be
+    // released while a later reader still needs it.
+    encodedImages.resize(model.images.size());
+    SourceBuffers buffers(model, mappedGlb, memoryTracker);
+    ExpandInstances(model, buffers, placements, jobs, instanceTransforms);
+    for (const PrimitiveJob& job : jobs) {
+        if (job._instanced) {
+            ++timings._instancedSubMeshes;
+            timings._instances += job._instanceCount;
+            timings._instancedVerticesSaved += job._vertexCount * (job._instanceCount - 1);
         }
     }
+    std::vector<bool> skipImages;
+    const std::vector<int> textureImages =
+        ResolveTextureImages(model, buffers, encodedImages, basePath, skipImages);
+    for (const PrimitiveJob& job : jobs) {
+        for (int buffer : job._buffers) {
+            buffers.AddUser(buffer);
+        }
+    }
+    for (size_t i = 0; i < encodedImages.size(); ++i) {
+        if (encodedImages[i]._bufferView >= 0 && !skipImages[i]) {
+            buffers.AddUser(model.bufferViews[encodedImages[i]._bufferView].buffer);
+        }
+    }
+    buffers.ReleaseUnused();
+    std::vector<ImageCompression> compression(model.images.size());
+    if (options._compressTextures) {
+        compression = PlanTextureCompression(model, textureImages);
+    }
+
+    // Start decoding images right away; they only touch their own texture and overlap with the
+    // geometry work below.
+    ThreadPool& pool = ThreadPool::Shared();
+    textures.resize(model.images.size());
+    std::vector<std::future<void>> imageTasks;
+    imageTasks.reserve(model.images.size());
+    for (size_t i = 0; i < model.images.size(); ++i) {
+        if (skipImages[i]) {
+            continue;
+        }
+        imageTasks.push_back(pool.Submit([&, i]() {
+            if (compression[i]._enabled) {
+                ProcessCompressedImage(model, buffers, static_cast<int>(i), encodedImages[i],
+                                       basePath, compression[i], options._textureCacheDir,
+                                       textures[i], compressionStats);
+            } else {
+                ProcessImage(model, buffers, static_cast<int>(i), encodedImages[i], basePath,
+                             textures[i]);
+            }
+            if (encodedImages[i]._bufferView >= 0) {
+                const tinygltf::BufferView& bufferView =
+                    model.bufferViews[encodedImages[i]._bufferView];
+                buffers.ReleaseBufferView(bufferView);
+                buffers.Release(bufferView.buffer);
+            }
+        }));
+    }
+
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        jobs[i]._firstVertex = vertexCount;
+        jobs[i]._firstIndex = indexCount;
+        vertexCount += jobs[i]._vertexCount;
+        indexCount += jobs[i]._indexCount;
+    }
+
+    vertices.resize(vertexCount);
+    indices.resize(indexCount);
+    subMeshes.resize(jobs.size());
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    // Phase 2: Extract. Every primitive decodes into its own slice on the worker pool and drops
+    // its claim on the source buffers when done.
+    pool.ParallelFor(jobs.size(), [&](size_t i) {
+        ProcessPrimitive(model, buffers, jobs[i], vertices, indices, subMeshes[i]);
+        for (int bufferView : jobs[i]._bufferViews) {
+            buffers.ReleaseBufferView(model.bufferViews[bufferView]);
+        }
+        for (int buffer : jobs[i]._buffers) {
+            buffers.Release(buffer);
+        }
+    });
 
     for (const auto& material : model.materials) {
-        ProcessMaterial(material, materials);
+        ProcessMaterial(material, textureImages, materials);
     }
 
-    for (const auto& image : model.images) {
-        ProcessImage(image, "", textures);
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    // Phase 3: Tangents. Only normal mapping reads them, so primitives without a TANGENT
+    // attribute get tangents only if their material samples a normal map (see
+    // Model::SetMaterial for materials that gain one later). Each job writes its own vertices.
+    std::vector<size_t> tangentJobs;
+    for (size_t i = 0; i < subMeshes.size(); ++i) {
+        if (subMeshes[i]._hasTangents) {
+            if (options._regenerateTangents) {
+                tangentJobs.push_back(i);
+            }
+            continue;
+        }
+        const int materialIndex = subMeshes[i]._materialIndex;
+        if (materialIndex >= 0 && static_cast<size_t>(materialIndex) < materials.size() &&
+            materials[materialIndex]._normalTexture >= 0) {
+            tangentJobs.push_back(i);
+        } else {
+            ++timings._tangentsSkipped;
+        }
+    }
+    GenerateTangents(options, tangentJobs, subMeshes, vertices, indices, timings._tangents);
+
+    auto t3 = std::chrono::high_resolution_clock::now();
+    timings._countMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    timings._extractMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    timings._tangentMs = std::chrono::duration<double, std::milli>(t3 - t2).count();
+    timings._tangentSubMeshes = tangentJobs.size();
+
+    auto t4 = std::chrono::high_resolution_clock::now();
+    for (std::future<void>& task : imageTasks) {
+        task.get();
     }
+    auto t5 = std::chrono::high_resolution_clock::now();
+    timings._imageWaitMs = std::chrono::duration<double, std::milli>(t5 - t4).count();
+    memoryTracker.Sample();
 }
 
 } // namespace
 
+//----------------------------------------------------------------------
+// Model::ImageData Implementation
+
+Model::ImageData::ImageData(uint8_t* pixels, size_t size) noexcept :
+    _pixels(pixels), _size(size) {}
+
+const uint8_t* Model::ImageData::data() const noexcept {
+    return _pixels.get();
+}
+
+size_t Model::ImageData::size() const noexcept {
+    return _size;
+}
+
+bool Model::ImageData::empty() const noexcept {
+    return _size == 0;
+}
+
+void Model::ImageData::Deleter::operator()(uint8_t* pixels) const noexcept {
+    stbi_image_free(pixels);
+}
+
 //----------------------------------------------------------------------
 // Model Class Implementation
 
@@ -392,40 +1607,153 @@ void Model::Load(const std::string& filename, const uint8_t* data, uint32_t size
 
     tinygltf::Model model;
     tinygltf::TinyGLTF loader;
+    std::vector<EncodedImage> encodedImages;
+    loader.SetImageLoader(DeferImageDecode, &encodedImages);
+    MappedGlb mappedGlb; // Outlives ProcessModel, which reads geometry straight from the mapping.
+    std::string basePath;
     std::string err;
     std::string warn;
     bool result = false;
 
     if (data) {
         // Load from memory, binary file.
-        result = loader.LoadBinaryFromMemory(&model, &err, &warn, data, size);
+        result = LoadGltfFromMemory(loader, data, size, true, "", model, err, warn);
     } else {
         // Load from file, either ASCII or binary.
 
-        const std::string basePath = filename.substr(0, filename.find_last_of("/"));
+        basePath = filename.substr(0, filename.find_last_of("/"));
         std::string extension = filename.substr(filename.find_last_of(".") + 1);
 
+        // Reads the whole file for the paths that do not map it.
+        const auto loadFile = [&](bool binary) {
+            std::ifstream file(filename, std::ios::binary);
+            std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                                       std::istreambuf_iterator<char>());
+            if (!file.is_open() || bytes.empty()) {
+                err = "Failed to read file: " + filename;
+                return false;
+            }
+            return LoadGltfFromMemory(loader, bytes.data(), bytes.size(), binary,
+                                      std::filesystem::path(filename).parent_path().string(),
+                                      model, err, warn);
+        };
+
         if (extension == "gltf") {
-            result = loader.LoadASCIIFromFile(&model, &err, &warn, filename);
+            result = loadFile(false);
         } else if (extension == "glb") {
-            result = loader.LoadBinaryFromFile(&model, &err, &warn, filename);
+            if (mappedGlb.Open(filename)) {
+                result = LoadMappedGlb(loader, mappedGlb, basePath, model, encodedImages, err,
+                                       warn);
+            } else {
+                result = loadFile(true);
+            }
         } else {
             std::cerr << "Unsupported file format: " << extension << std::endl;
             return;
         }
     }
 
+    for (const std::string& extension : model.extensionsRequired) {
+        if (result && std::find_if(std::begin(kSupportedExtensions), std::end(kSupportedExtensions),
+                                   [&](const char* supported) { return extension == supported; }) ==
+                          std::end(kSupportedExtensions)) {
+            err = "required extension " + extension + " is not supported";
+            result = false;
+        }
+    }
+
+    size_t decodedViews = 0;
+    size_t decodedBytes = 0;
+    auto decodeStart = std::chrono::high_resolution_clock::now();
+    if (result) {
+        result = DecodeMeshoptBufferViews(model, mappedGlb.IsOpen() ? &mappedGlb : nullptr, err,
+                                          decodedViews, decodedBytes);
+    }
+    auto decodeEnd = std::chrono::high_resolution_clock::now();
+    if (decodedViews > 0) {
+        std::cout << "Decoded " << decodedViews << " meshopt buffer views ("
+                  << decodedBytes / 1024 << " KB) in "
+                  << std::chrono::duration<double, std::milli>(decodeEnd - decodeStart).count()
+                  << "ms" << std::endl;
+    }
+
     // If successful, process the model.
     if (result) {
         ClearData();
         auto t1 = std::chrono::high_resolution_clock::now();
-        ProcessModel(model, _vertices, _indices, _materials, _textures, _subMeshes);
+        LoadTimings timings;
+        CompressionStats compressionStats;
+        PeakMemoryTracker memoryTracker;
+        memoryTracker.Sample();
+        ProcessModel(model, mappedGlb.IsOpen() ? &mappedGlb : nullptr, encodedImages, basePath,
+                     _vertices, _indices, _materials, _textures, _subMeshes,
+                     _instanceTransforms, _loadOptions, timings, compressionStats, memoryTracker);
+        if (_loadOptions._optimizeMeshes) {
+            OptimizeMeshes();
+        }
+        if (_loadOptions._generateLods) {
+            GenerateLods();
+        }
+        if (_loadOptions._buildMeshlets) {
+            BuildMeshlets();
+        }
         RecomputeBounds();
         auto t2 = std::chrono::high_resolution_clock::now();
         double totalMs = std::chrono::duration<double, std::milli>(t2 - t0).count();
-        double processMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
-        std::cout << "Loaded model in " << totalMs << "ms (processing took: " << processMs << "ms)"
+        double parseMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        std::cout << "Loaded model in " << totalMs << "ms (parse: " << parseMs
+                  << "ms, count: " << timings._countMs << "ms, extract: " << timings._extractMs
+                  << "ms, tangents: " << timings._tangentMs << "ms for "
+                  << timings._tangentSubMeshes << " submeshes ("
+                  << (_loadOptions._tangentGenerator == TangentGenerator::Fast ? "fast"
+                                                                                : "MikkTSpace")
+                  << "), " << timings._tangentsSkipped
+                  << " skipped without normal maps, image wait: " << timings._imageWaitMs
+                  << "ms, " << _subMeshes.size() << " primitives on "
+                  << ThreadPool::Shared().GetWorkerCount() + 1 << " threads, "
+                  << vertex_kernels::GetIsaName(vertex_kernels::GetActiveIsa()) << " kernels)"
                   << std::endl;
+        if (timings._instancedSubMeshes > 0) {
+            std::cout << "Instanced " << timings._instancedSubMeshes << " submeshes over "
+                      << timings._instances << " instances, " << timings._instancedVerticesSaved
+                      << " vertices not duplicated" << std::endl;
+        }
+        if (timings._quantizedAttributes > 0) {
+            std::cout << "Dequantized " << timings._quantizedAttributes
+                      << " integer vertex attributes" << std::endl;
+        }
+        if (compressionStats._encoded + compressionStats._cacheHits > 0) {
+            // Encode time is summed over the image tasks, so it can exceed the load time.
+            std::cout << "Compressed " << compressionStats._encoded + compressionStats._cacheHits
+                      << " textures to BC formats with mips (" << compressionStats._cacheHits
+                      << " from cache, " << compressionStats._encoded << " encoded in "
+                      << compressionStats._encodeMicroseconds / 1000.0 << "ms): "
+                      << compressionStats._rgba8Bytes / 1024 << " KB RGBA8 level 0 -> "
+                      << compressionStats._compressedBytes / 1024 << " KB with mips"
+                      << std::endl;
+        }
+        size_t fileLevelTextures = 0;
+        size_t fileLevelBytes = 0;
+        for (const Texture& texture : _textures) {
+            if (!texture._mipLevels.empty()) {
+                ++fileLevelTextures;
+                fileLevelBytes += texture._data.size();
+            }
+        }
+        // Textures compressed at import also carry mips but were counted above.
+        fileLevelTextures -= compressionStats._encoded + compressionStats._cacheHits;
+        fileLevelBytes -= compressionStats._compressedBytes;
+        if (fileLevelTextures > 0) {
+            std::cout << "Read " << fileLevelTextures << " KTX2 textures with their mip chains ("
+                      << fileLevelBytes / 1024 << " KB)" << std::endl;
+        }
+        if (_loadOptions._validateTangents && timings._tangentSubMeshes > 0) {
+            LogTangentValidation(_loadOptions, timings._tangents);
+        }
+        if (const size_t peakBytes = memoryTracker.GetPeak(); peakBytes > 0) {
+            std::cout << "Peak resident memory during load: " << peakBytes / (1024 * 1024)
+                      << " MB" << std::endl;
+        }
     } else {
         std::cerr << "Failed to load model: " << err << std::endl;
     }
@@ -446,6 +1774,43 @@ void Model::ResetOrientation() noexcept {
     _rotationAngle = 0.0f;
 }
 
+void Model::SetLoadOptions(const LoadOptions& options) noexcept {
+    _loadOptions = options;
+}
+
+void Model::SetMaterial(size_t index, const Material& material) {
+    if (index >= _materials.size()) {
+        std::cerr << "SetMaterial: material index " << index << " out of range" << std::endl;
+        return;
+    }
+    _materials[index] = material;
+    if (material._normalTexture < 0) {
+        return;
+    }
+
+    std::vector<size_t> tangentJobs;
+    for (size_t i = 0; i < _subMeshes.size(); ++i) {
+        const SubMesh& subMesh = _subMeshes[i];
+        if (!subMesh._hasTangents && subMesh._materialIndex == static_cast<int>(index)) {
+            tangentJobs.push_back(i);
+        }
+    }
+    if (tangentJobs.empty()) {
+        return;
+    }
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    TangentReport report;
+    GenerateTangents(_loadOptions, tangentJobs, _subMeshes, _vertices, _indices, report);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    std::cout << "Generated tangents for " << tangentJobs.size() << " submeshes of material "
+              << index << " in " << std::chrono::duration<double, std::milli>(t1 - t0).count()
+              << "ms" << std::endl;
+    if (_loadOptions._validateTangents) {
+        LogTangentValidation(_loadOptions, report);
+    }
+}
+
 const glm::mat4& Model::GetTransform() const noexcept {
     return _transform;
 }
@@ -482,6 +1847,22 @@ const std::vector<Model::SubMesh>& Model::GetSubMeshes() const noexcept {
     return _subMeshes;
 }
 
+const std::vector<Model::Lod>& Model::GetLods() const noexcept {
+    return _lods;
+}
+
+const std::vector<Model::Meshlet>& Model::GetMeshlets() const noexcept {
+    return _meshlets;
+}
+
+const std::vector<glm::mat4>& Model::GetInstanceTransforms() const noexcept {
+    return _instanceTransforms;
+}
+
+const Model::LoadOptions& Model::GetLoadOptions() const noexcept {
+    return _loadOptions;
+}
+
 void Model::ClearData() {
     _transform = glm::mat4(1.0f);
     _rotationAngle = 0.0f;
@@ -492,15 +1873,109 @@ void Model::ClearData() {
     _materials.clear();
     _textures.clear();
     _subMeshes.clear();
+    _lods.clear();
+    _meshlets.clear();
+    _instanceTransforms.clear();
+}
+
+void Model::OptimizeMeshes() {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    mesh_utils::OptimizeOptions options;
+    options._reduceOverdraw = _loadOptions._reduceOverdraw;
+    const mesh_utils::OptimizeReport report =
+        mesh_utils::OptimizeMeshes(_subMeshes, _vertices, _indices, options);
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    const auto acmr = [](const mesh_utils::VertexCacheStats& stats) {
+        return stats._triangleCount ? static_cast<float>(stats._cacheMisses) /
+                                          static_cast<float>(stats._triangleCount)
+                                    : 0.0f;
+    };
+    const auto atvr = [](const mesh_utils::VertexCacheStats& stats) {
+        return stats._vertexCount ? static_cast<float>(stats._cacheMisses) /
+                                        static_cast<float>(stats._vertexCount)
+                                  : 0.0f;
+    };
+
+    std::cout << "Optimized " << _subMeshes.size() << " submeshes in "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count()
+              << "ms: vertices " << report._vertexCountBefore << " -> "
+              << report._vertexCountAfter << ", ACMR " << acmr(report._before) << " -> "
+              << acmr(report._after) << ", ATVR " << atvr(report._before) << " -> "
+              << atvr(report._after) << std::endl;
+}
+
+void Model::GenerateLods() {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    mesh_utils::GenerateLods(_subMeshes, _vertices, _indices, _lods);
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    // Triangles per level, summed over the submeshes that reach it.
+    std::vector<size_t> levelTriangles(1, 0);
+    for (const SubMesh& subMesh : _subMeshes) {
+        levelTriangles[0] += subMesh._indexCount / 3;
+        levelTriangles.resize(std::max<size_t>(levelTriangles.size(), subMesh._lodCount + 1), 0);
+        for (uint32_t level = 0; level < subMesh._lodCount; ++level) {
+            levelTriangles[level + 1] += _lods[subMesh._firstLod + level]._indexCount / 3;
+        }
+    }
+
+    std::cout << "Generated " << _lods.size() << " LODs in "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << "ms: triangles ";
+    for (size_t level = 0; level < levelTriangles.size(); ++level) {
+        std::cout << (level ? " -> " : "") << levelTriangles[level];
+    }
+    std::cout << std::endl;
+}
+
+void Model::BuildMeshlets() {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    mesh_utils::BuildMeshlets(_subMeshes, _vertices, _indices, _meshlets);
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    size_t vertexCount = 0;
+    size_t triangleCount = 0;
+    size_t coneCount = 0;
+    for (const Meshlet& meshlet : _meshlets) {
+        vertexCount += meshlet._vertexCount;
+        triangleCount += meshlet._indexCount / 3;
+        coneCount += meshlet._coneCutoff <= 1.0f ? 1 : 0;
+    }
+    const float meshletCount = static_cast<float>(std::max<size_t>(_meshlets.size(), 1));
+
+    std::cout << "Built " << _meshlets.size() << " meshlets in "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << "ms: "
+              << static_cast<float>(vertexCount) / meshletCount << " vertices, "
+              << static_cast<float>(triangleCount) / meshletCount
+              << " triangles per meshlet, " << 100.0f * static_cast<float>(coneCount) / meshletCount
+              << "% with a backface cone" << std::endl;
 }
 
 void Model::RecomputeBounds() {
     _minBounds = glm::vec3(std::numeric_limits<float>::max());
     _maxBounds = glm::vec3(std::numeric_limits<float>::lowest());
 
-    // Calculate the bounding box of the model.
-    for (const auto& vertex : _vertices) {
-        _minBounds = glm::min(_minBounds, vertex._position);
-        _maxBounds = glm::max(_maxBounds, vertex._position);
+    // Calculate the bounding box of the model. Instanced submeshes are in mesh space, so the
+    // corners of their boxes are moved into place by every instance transform.
+    for (const SubMesh& subMesh : _subMeshes) {
+        if (!subMesh._instanced) {
+            for (uint32_t i = 0; i < subMesh._vertexCount; ++i) {
+                const glm::vec3& position = _vertices[subMesh._firstVertex + i]._position;
+                _minBounds = glm::min(_minBounds, position);
+                _maxBounds = glm::max(_maxBounds, position);
+            }
+            continue;
+        }
+        for (uint32_t instance = 0; instance < subMesh._instanceCount; ++instance) {
+            const glm::mat4& transform = _instanceTransforms[subMesh._firstInstance + instance];
+            for (int corner = 0; corner < 8; ++corner) {
+                const glm::vec3 local((corner & 1) ? subMesh._maxBounds.x : subMesh._minBounds.x,
+                                      (corner & 2) ? subMesh._maxBounds.y : subMesh._minBounds.y,
+                                      (corner & 4) ? subMesh._maxBounds.z : subMesh._minBounds.z);
+                const glm::vec3 position = glm::vec3(transform * glm::vec4(local, 1.0f));
+                _minBounds = glm::min(_minBounds, position);
+                _maxBounds = glm::max(_maxBounds, position);
+            }
+        }
     }
 }
\ No newline at end of file
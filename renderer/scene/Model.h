@@ -4,7 +4,9 @@
 #pragma once
 
 // Standard Library Headers
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -36,6 +38,7 @@ class Model {
         AlphaMode _alphaMode{AlphaMode::Opaque}; // Alpha rendering mode
         float _alphaCutoff{0.5f};                // Alpha cutoff value
         bool _doubleSided{false};                // Double-sided rendering
+        // Texture slots index GetTextures(), which holds one entry per glTF image.
         int _baseColorTexture{-1};               // Index of base color texture
         int _metallicRoughnessTexture{-1};       // Index of metallic-roughness texture
         int _normalTexture{-1};                  // Index of normal texture
@@ -43,20 +46,118 @@ class Model {
         int _occlusionTexture{-1};               // Index of occlusion texture
     };
 
+    // Decoded pixels. Holds on to the image decoder's own allocation so the pixels are handed
+    // over from the loader without a copy.
+    class ImageData {
+      public:
+        ImageData() = default;
+        ImageData(uint8_t* pixels, size_t size) noexcept; // Takes ownership of a malloc'd buffer
+
+        const uint8_t* data() const noexcept;
+        size_t size() const noexcept;
+        bool empty() const noexcept;
+
+      private:
+        struct Deleter {
+            void operator()(uint8_t* pixels) const noexcept;
+        };
+
+        std::unique_ptr<uint8_t[], Deleter> _pixels;
+        size_t _size{0};
+    };
+
+    // Layout of Texture::_data. Block-compressed formats come from KTX2 files or from
+    // LoadOptions::_compressTextures; color space follows the material slot, like it does for
+    // RGBA8.
+    enum class TextureFormat {
+        RGBA8,
+        BC1,      // RGB(A) 565 endpoints, 8 bytes per 4x4 block
+        BC3,      // BC1 color plus a BC4 alpha block, 16 bytes
+        BC4,      // One channel, 8 bytes
+        BC5,      // Two BC4 channels (normal map xy), 16 bytes
+        BC7,      // RGBA, 16 bytes
+        ETC2RGB8, // 8 bytes
+        ETC2RGBA8,
+        ASTC4x4,
+    };
+
+    struct MipLevel {
+        uint32_t _width{0};
+        uint32_t _height{0};
+        size_t _offset{0}; // Byte offset of the level in Texture::_data
+        size_t _size{0};
+    };
+
     struct Texture {
-        std::string _name;          // Name of the texture
-        uint32_t _width{0};         // Width of the texture
-        uint32_t _height{0};        // Height of the texture
-        uint32_t _components{0};    // Components per pixel (e.g., 3 = RGB, 4 = RGBA)
-        std::vector<uint8_t> _data; // Raw pixel data
+        std::string _name;       // Name of the texture
+        uint32_t _width{0};      // Width of the texture
+        uint32_t _height{0};     // Height of the texture
+        uint32_t _components{0}; // Components per pixel (e.g., 3 = RGB, 4 = RGBA)
+        ImageData _data;         // Raw pixel data, or every mip level back to back
+        TextureFormat _format{TextureFormat::RGBA8};
+        std::vector<MipLevel> _mipLevels; // Levels from the file; empty if the renderer mips it
     };
 
     struct SubMesh {
-        uint32_t _firstIndex{0}; // First index in the index buffer
-        uint32_t _indexCount{0}; // Number of indices in the submesh
+        uint32_t _firstIndex{0};  // First index in the index buffer
+        uint32_t _indexCount{0};  // Number of indices in the submesh
+        uint32_t _firstVertex{0}; // First vertex referenced by the submesh
+        uint32_t _vertexCount{0}; // Number of vertices owned by the submesh
         int _materialIndex{-1};  // Material index for the submesh
         glm::vec3 _minBounds{0.0f};
         glm::vec3 _maxBounds{0.0f};
+        uint32_t _firstMeshlet{0}; // First meshlet in GetMeshlets()
+        uint32_t _meshletCount{0}; // Zero unless meshlets were built
+        uint32_t _firstLod{0};     // First coarser level in GetLods()
+        uint32_t _lodCount{0};     // Zero unless LODs were generated
+        bool _hasTangents{false};  // From the file, or generated because a normal map needs them
+        // Placements in GetInstanceTransforms(). Meshes that several nodes place, or that use
+        // EXT_mesh_gpu_instancing, are stored once in mesh space (vertices and bounds) with one
+        // transform per placement. Other submeshes have their node transform baked in and use a
+        // single identity transform.
+        uint32_t _firstInstance{0};
+        uint32_t _instanceCount{1};
+        bool _instanced{false};
+    };
+
+    // A simplified version of a submesh, stored after all submesh ranges in the index buffer.
+    // Levels of a submesh are ordered from fine to coarse.
+    struct Lod {
+        uint32_t _firstIndex{0}; // First index in the index buffer
+        uint32_t _indexCount{0}; // Number of indices in the level
+        float _error{0.0f};      // Largest deviation from the full-detail surface (model units)
+    };
+
+    // A cluster of at most 64 vertices and 124 triangles. The submesh's indices are reordered so
+    // that every meshlet is a contiguous index range.
+    struct Meshlet {
+        uint32_t _firstIndex{0};  // First index in the index buffer
+        uint32_t _indexCount{0};  // Number of indices in the meshlet
+        uint32_t _vertexCount{0}; // Distinct vertices referenced
+        glm::vec3 _center{0.0f};  // Bounding sphere
+        float _radius{0.0f};
+        glm::vec3 _coneApex{0.0f}; // Backface cone: every triangle faces away from an eye with
+        glm::vec3 _coneAxis{0.0f}; // dot(normalize(_coneApex - eye), _coneAxis) >= _coneCutoff
+        float _coneCutoff{2.0f};   // Above 1 when the normals are too spread out to cull
+    };
+
+    // How tangents are generated for normal-mapped submeshes that have none in the file.
+    enum class TangentGenerator {
+        MikkTSpace, // Reference implementation, matches what most bakers expect
+        Fast,       // Vectorized per-vertex accumulation (mesh_utils::GenerateTangentsFast)
+    };
+
+    // Processing applied by Load() once the geometry has been extracted.
+    struct LoadOptions {
+        TangentGenerator _tangentGenerator{TangentGenerator::MikkTSpace};
+        bool _validateTangents{false};   // Also run the other generator; log deviation and timings
+        bool _regenerateTangents{false}; // Ignore TANGENT attributes (for benchmarking)
+        bool _optimizeMeshes{false}; // Weld vertices, reorder for vertex cache and fetch locality
+        bool _reduceOverdraw{false}; // Also reorder triangle clusters to reduce overdraw
+        bool _generateLods{false};   // Build simplified index ranges per submesh
+        bool _buildMeshlets{false};  // Split submeshes into meshlets for GPU culling
+        bool _compressTextures{false}; // Encode PNG/JPEG images to BC formats with full mips
+        std::string _textureCacheDir;  // Compressed textures are cached here; empty disables
     };
 
     // Constructor
@@ -66,6 +167,11 @@ class Model {
     void Load(const std::string& filename, const uint8_t* data = 0, uint32_t size = 0);
     void Update(float deltaTime, bool animate);
     void ResetOrientation() noexcept;
+    void SetLoadOptions(const LoadOptions& options) noexcept;
+
+    // Replaces a material. If it now samples a normal map, the submeshes using it get tangents
+    // generated on the spot; renderers pick the change up on their next model update.
+    void SetMaterial(size_t index, const Material& material);
 
     // Accessors
     const glm::mat4& GetTransform() const noexcept;
@@ -76,10 +182,17 @@ class Model {
     const std::vector<Texture>& GetTextures() const noexcept;
     const Texture* GetTexture(int index) const noexcept;
     const std::vector<SubMesh>& GetSubMeshes() const noexcept;
+    const std::vector<Lod>& GetLods() const noexcept;
+    const std::vector<Meshlet>& GetMeshlets() const noexcept;
+    const std::vector<glm::mat4>& GetInstanceTransforms() const noexcept;
+    const LoadOptions& GetLoadOptions() const noexcept;
 
   private:
     // Private Member Functions
     void ClearData();
+    void OptimizeMeshes();
+    void GenerateLods();
+    void BuildMeshlets();
     void RecomputeBounds();
 
     // Private Member Variables
@@ -92,4 +205,8 @@ class Model {
     std::vector<Material> _materials;
     std::vector<Texture> _textures;
     std::vector<SubMesh> _subMeshes;
+    std::vector<Lod> _lods;
+    std::vector<Meshlet> _meshlets;
+    std::vector<glm::mat4> _instanceTransforms;
+    LoadOptions _loadOptions;
 };
\ No newline at end of file
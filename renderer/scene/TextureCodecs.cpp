@@ -0,0 +1,762 @@
+// Class Header
+#include "TextureCodecs.h"
+
+// Standard Library Headers
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Third-Party Library Headers
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GFX_TEXTURE_CODECS_X86 1
+#include <immintrin.h>
+#endif
+
+// Project Headers
+#include "ThreadPool.h"
+#include "VertexKernels.h"
+
+// Same per-function targeting as VertexKernels.cpp: only the SSE paths require SSE4.1.
+#if defined(GFX_TEXTURE_CODECS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define GFX_TARGET_SSE4 __attribute__((target("sse4.1")))
+#else
+#define GFX_TARGET_SSE4
+#endif
+
+//----------------------------------------------------------------------
+// Internal Utility Functions
+
+namespace {
+
+using Format = Model::TextureFormat;
+
+uint16_t ReadU16(const uint8_t* bytes) {
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+// Expands a 565 color to 8 bits per channel by replicating the top bits.
+void Unpack565(uint16_t color, uint8_t rgb[3]) {
+    const uint32_t r = (color >> 11) & 31;
+    const uint32_t g = (color >> 5) & 63;
+    const uint32_t b = color & 31;
+    rgb[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+    rgb[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+    rgb[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+}
+
+// BC1 color block into a 4x4 RGBA tile. BC3's color half always uses the four-color palette.
+void DecodeColorBlock(const uint8_t* block, bool allowTransparent, uint8_t tile[16][4]) {
+    const uint16_t color0 = ReadU16(block);
+    const uint16_t color1 = ReadU16(block + 2);
+    uint8_t palette[4][4] = {};
+    Unpack565(color0, palette[0]);
+    Unpack565(color1, palette[1]);
+    palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+
+    if (color0 > color1 || !allowTransparent) {
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c] + 1) / 3);
+            palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c] + 1) / 3);
+        }
+    } else {
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c] + 1) / 2);
+            palette[3][c] = 0;
+        }
+        palette[3][3] = 0;
+    }
+
+    uint32_t selectors = 0;
+    std::memcpy(&selectors, block + 4, sizeof(selectors));
+    for (int i = 0; i < 16; ++i) {
+        std::memcpy(tile[i], palette[(selectors >> (2 * i)) & 3], 4);
+    }
+}
+
+// BC4 block (also BC3 alpha and each BC5 channel) into channel `channel` of a 4x4 tile.
+void DecodeChannelBlock(const uint8_t* block, int channel, uint8_t tile[16][4]) {
+    const uint32_t value0 = block[0];
+    const uint32_t value1 = block[1];
+    uint8_t palette[8] = {static_cast<uint8_t>(value0), static_cast<uint8_t>(value1)};
+    if (value0 > value1) {
+        for (uint32_t i = 1; i <= 6; ++i) {
+            palette[i + 1] = static_cast<uint8_t>(((7 - i) * value0 + i * value1 + 3) / 7);
+        }
+    } else {
+        for (uint32_t i = 1; i <= 4; ++i) {
+            palette[i + 1] = static_cast<uint8_t>(((5 - i) * value0 + i * value1 + 2) / 5);
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    uint64_t selectors = 0;
+    for (int i = 0; i < 6; ++i) {
+        selectors |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+    }
+    for (int i = 0; i < 16; ++i) {
+        tile[i][channel] = palette[(selectors >> (3 * i)) & 7];
+    }
+}
+
+void DecodeBlock(Format format, const uint8_t* block, uint8_t tile[16][4]) {
+    switch (format) {
+    case Format::BC1:
+        DecodeColorBlock(block, true, tile);
+        break;
+    case Format::BC3:
+        DecodeColorBlock(block + 8, false, tile);
+        DecodeChannelBlock(block, 3, tile);
+        break;
+    case Format::BC4:
+        std::memset(tile, 0, 16 * 4);
+        DecodeChannelBlock(block, 0, tile);
+        break;
+    case Format::BC5:
+        std::memset(tile, 0, 16 * 4);
+        DecodeChannelBlock(block, 0, tile);
+        DecodeChannelBlock(block + 8, 1, tile);
+        break;
+    default:
+        break;
+    }
+    if (format == Format::BC4 || format == Format::BC5) {
+        for (int i = 0; i < 16; ++i) {
+            tile[i][3] = 255;
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+// Mip generation
+
+using Level = std::vector<uint8_t>; // Tightly packed RGBA8
+
+float SrgbToLinear(float value) {
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+float LinearToSrgb(float value) {
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+uint8_t ToUnorm8(float value) {
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+// One 2x2 box-filtered level; odd edges repeat their last row or column.
+Level Downsample(const Level& source, uint32_t width, uint32_t height,
+                 texture_codecs::MipFilter filter) {
+    using texture_codecs::MipFilter;
+    static const std::vector<float> kSrgbToLinear = [] {
+        std::vector<float> table(256);
+        for (int i = 0; i < 256; ++i) {
+            table[i] = SrgbToLinear(i / 255.0f);
+        }
+        return table;
+    }();
+
+    const uint32_t dstWidth = std::max(width / 2, 1u);
+    const uint32_t dstHeight = std::max(height / 2, 1u);
+    Level level(static_cast<size_t>(dstWidth) * dstHeight * 4);
+    ThreadPool::Shared().ParallelFor(dstHeight, [&](size_t y) {
+        for (uint32_t x = 0; x < dstWidth; ++x) {
+            const uint8_t* texels[4];
+            for (uint32_t i = 0; i < 4; ++i) {
+                const size_t sx = std::min(x * 2 + (i & 1), width - 1);
+                const size_t sy = std::min(y * 2 + (i >> 1), static_cast<size_t>(height - 1));
+                texels[i] = &source[(sy * width + sx) * 4];
+            }
+            uint8_t* dst = &level[(y * dstWidth + x) * 4];
+            dst[3] = static_cast<uint8_t>(
+                (texels[0][3] + texels[1][3] + texels[2][3] + texels[3][3] + 2) / 4);
+
+            if (filter == MipFilter::Srgb) {
+                for (int c = 0; c < 3; ++c) {
+                    const float sum = kSrgbToLinear[texels[0][c]] + kSrgbToLinear[texels[1][c]] +
+                                      kSrgbToLinear[texels[2][c]] + kSrgbToLinear[texels[3][c]];
+                    dst[c] = ToUnorm8(LinearToSrgb(sum * 0.25f));
+                }
+            } else if (filter == MipFilter::Normal) {
+                float normal[3] = {0.0f, 0.0f, 0.0f};
+                for (const uint8_t* texel : texels) {
+                    for (int c = 0; c < 3; ++c) {
+                        normal[c] += texel[c] / 127.5f - 1.0f;
+                    }
+                }
+                const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] +
+                                               normal[2] * normal[2]);
+                const float scale = length > 0.0f ? 1.0f / length : 0.0f;
+                for (int c = 0; c < 3; ++c) {
+                    dst[c] = ToUnorm8(normal[c] * scale * 0.5f + 0.5f);
+                }
+            } else {
+                for (int c = 0; c < 3; ++c) {
+                    dst[c] = static_cast<uint8_t>(
+                        (texels[0][c] + texels[1][c] + texels[2][c] + texels[3][c] + 2) / 4);
+                }
+            }
+        }
+    });
+    return level;
+}
+
+//----------------------------------------------------------------------
+// Block encoders. Each takes a 4x4 tile of RGBA8 texels (edge blocks repeat the last texel).
+
+using Tile = uint8_t[16][4];
+
+uint16_t Pack565(const int rgb[3]) {
+    return static_cast<uint16_t>((((rgb[0] * 31 + 127) / 255) << 11) |
+                                 (((rgb[1] * 63 + 127) / 255) << 5) | ((rgb[2] * 31 + 127) / 255));
+}
+
+// Principal axis of the tile's first `channels` channels (power iteration on the covariance),
+// with the mean. The axis is zero for flat tiles.
+void PrincipalAxis(const Tile& tile, int channels, float mean[4], float axis[4]) {
+    for (int c = 0; c < 4; ++c) {
+        mean[c] = 0.0f;
+        axis[c] = 0.0f;
+        for (int i = 0; i < 16; ++i) {
+            mean[c] += tile[i][c];
+        }
+        mean[c] /= 16.0f;
+    }
+
+    float covariance[4][4] = {};
+    for (int i = 0; i < 16; ++i) {
+        for (int a = 0; a < channels; ++a) {
+            for (int b = 0; b < channels; ++b) {
+                covariance[a][b] += (tile[i][a] - mean[a]) * (tile[i][b] - mean[b]);
+            }
+        }
+    }
+
+    // Start from the channel with the largest spread, which can't be orthogonal to the answer.
+    int largest = 0;
+    for (int c = 1; c < channels; ++c) {
+        largest = covariance[c][c] > covariance[largest][largest] ? c : largest;
+    }
+    if (covariance[largest][largest] <= 0.0f) {
+        return;
+    }
+    float vector[4] = {};
+    vector[largest] = 1.0f;
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[4] = {};
+        float length = 0.0f;
+        for (int a = 0; a < channels; ++a) {
+            for (int b = 0; b < channels; ++b) {
+                next[a] += covariance[a][b] * vector[b];
+            }
+            length += next[a] * next[a];
+        }
+        length = std::sqrt(length);
+        if (length <= 0.0f) {
+            return;
+        }
+        for (int c = 0; c < channels; ++c) {
+            vector[c] = next[c] / length;
+        }
+    }
+    std::copy(vector, vector + 4, axis);
+}
+
+void EncodeBC1Block(const Tile& tile, uint8_t* block) {
+    float mean[4];
+    float axis[4];
+    PrincipalAxis(tile, 3, mean, axis);
+
+    // Endpoints are the texels that project furthest along the axis.
+    int minTexel = 0;
+    int maxTexel = 0;
+    float minT = 0.0f;
+    float maxT = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float t = 0.0f;
+        for (int c = 0; c < 3; ++c) {
+            t += (tile[i][c] - mean[c]) * axis[c];
+        }
+        if (i == 0 || t < minT) {
+            minT = t;
+            minTexel = i;
+        }
+        if (i == 0 || t > maxT) {
+            maxT = t;
+            maxTexel = i;
+        }
+    }
+    const int high[3] = {tile[maxTexel][0], tile[maxTexel][1], tile[maxTexel][2]};
+    const int low[3] = {tile[minTexel][0], tile[minTexel][1], tile[minTexel][2]};
+    uint16_t color0 = Pack565(high);
+    uint16_t color1 = Pack565(low);
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+    block[0] = static_cast<uint8_t>(color0);
+    block[1] = static_cast<uint8_t>(color0 >> 8);
+    block[2] = static_cast<uint8_t>(color1);
+    block[3] = static_cast<uint8_t>(color1 >> 8);
+
+    // Equal endpoints decode every selector to color0.
+    uint32_t selectors = 0;
+    if (color0 != color1) {
+        uint8_t palette[4][3];
+        Unpack565(color0, palette[0]);
+        Unpack565(color1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c] + 1) / 3);
+            palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c] + 1) / 3);
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int bestError = 1 << 30;
+            for (int k = 0; k < 4; ++k) {
+                int error = 0;
+                for (int c = 0; c < 3; ++c) {
+                    const int d = tile[i][c] - palette[k][c];
+                    error += d * d;
+                }
+                if (error < bestError) {
+                    bestError = error;
+                    best = k;
+                }
+            }
+            selectors |= static_cast<uint32_t>(best) << (2 * i);
+        }
+    }
+    std::memcpy(block + 4, &selectors, sizeof(selectors));
+}
+
+// Eight-value mode (value0 > value1) spanning the channel's range.
+void EncodeBC4Block(const Tile& tile, int channel, uint8_t* block) {
+    int low = 255;
+    int high = 0;
+    for (int i = 0; i < 16; ++i) {
+        low = std::min(low, static_cast<int>(tile[i][channel]));
+        high = std::max(high, static_cast<int>(tile[i][channel]));
+    }
+    block[0] = static_cast<uint8_t>(high);
+    block[1] = static_cast<uint8_t>(low);
+
+    uint64_t selectors = 0;
+    if (high > low) {
+        int palette[8] = {high, low};
+        for (int i = 1; i <= 6; ++i) {
+            palette[i + 1] = ((7 - i) * high + i * low + 3) / 7;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            for (int k = 1; k < 8; ++k) {
+                if (std::abs(tile[i][channel] - palette[k]) <
+                    std::abs(tile[i][channel] - palette[best])) {
+                    best = k;
+                }
+            }
+            selectors |= static_cast<uint64_t>(best) << (3 * i);
+        }
+    }
+    for (int i = 0; i < 6; ++i) {
+        block[2 + i] = static_cast<uint8_t>(selectors >> (8 * i));
+    }
+}
+
+// BC7 mode 6: RGBA endpoints of 7 bits plus a shared low bit (p-bit) each, 4-bit indices.
+constexpr int kBC7Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+struct BC7Endpoints {
+    int _values[2][4]; // 8-bit endpoint values, (7-bit value << 1) | p-bit
+};
+
+// Rounds an ideal endpoint to the closest value with a shared p-bit.
+void QuantizeEndpoint(const float ideal[4], int values[4]) {
+    int bestError = 1 << 30;
+    for (int p = 0; p < 2; ++p) {
+        int candidate[4];
+        int error = 0;
+        for (int c = 0; c < 4; ++c) {
+            const int q = std::clamp(static_cast<int>(std::lround((ideal[c] - p) / 2.0f)), 0, 127);
+            candidate[c] = (q << 1) | p;
+            const int d = candidate[c] - static_cast<int>(std::lround(ideal[c]));
+            error += d * d;
+        }
+        if (error < bestError) {
+            bestError = error;
+            std::copy(candidate, candidate + 4, values);
+        }
+    }
+}
+
+void BuildBC7Palette(const BC7Endpoints& endpoints, int16_t palette[16][4]) {
+    for (int k = 0; k < 16; ++k) {
+        for (int c = 0; c < 4; ++c) {
+            palette[k][c] = static_cast<int16_t>(((64 - kBC7Weights[k]) * endpoints._values[0][c] +
+                                                  kBC7Weights[k] * endpoints._values[1][c] + 32) >>
+                                                 6);
+        }
+    }
+}
+
+// Picks the closest palette entry (first on ties) for every texel; returns the summed error.
+uint32_t SelectIndicesScalar(const Tile& tile, const int16_t palette[16][4], uint8_t indices[16]) {
+    uint32_t total = 0;
+    for (int i = 0; i < 16; ++i) {
+        uint32_t bestError = UINT32_MAX;
+        for (int k = 0; k < 16; ++k) {
+            uint32_t error = 0;
+            for (int c = 0; c < 4; ++c) {
+                const int d = palette[k][c] - tile[i][c];
+                error += static_cast<uint32_t>(d * d);
+            }
+            if (error < bestError) {
+                bestError = error;
+                indices[i] = static_cast<uint8_t>(k);
+            }
+        }
+        total += bestError;
+    }
+    return total;
+}
+
+#if defined(GFX_TEXTURE_CODECS_X86)
+// Same search with all 16 entries in four registers: madd squares and pairs the channels of two
+// entries at a time, hadd finishes each entry's sum.
+GFX_TARGET_SSE4 uint32_t SelectIndicesSSE(const Tile& tile, const int16_t palette[16][4],
+                                          uint8_t indices[16]) {
+    __m128i entries[8];
+    for (int k = 0; k < 8; ++k) {
+        entries[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(palette[2 * k]));
+    }
+
+    uint32_t total = 0;
+    for (int i = 0; i < 16; ++i) {
+        const __m128i texel = _mm_set_epi16(tile[i][3], tile[i][2], tile[i][1], tile[i][0],
+                                            tile[i][3], tile[i][2], tile[i][1], tile[i][0]);
+        __m128i errors[4];
+        for (int r = 0; r < 4; ++r) {
+            const __m128i d0 = _mm_sub_epi16(entries[2 * r], texel);
+            const __m128i d1 = _mm_sub_epi16(entries[2 * r + 1], texel);
+            errors[r] = _mm_hadd_epi32(_mm_madd_epi16(d0, d0), _mm_madd_epi16(d1, d1));
+        }
+
+        __m128i best = _mm_min_epi32(_mm_min_epi32(errors[0], errors[1]),
+                                     _mm_min_epi32(errors[2], errors[3]));
+        best = _mm_min_epi32(best, _mm_shuffle_epi32(best, _MM_SHUFFLE(1, 0, 3, 2)));
+        best = _mm_min_epi32(best, _mm_shuffle_epi32(best, _MM_SHUFFLE(2, 3, 0, 1)));
+        uint32_t mask = 0;
+        for (int r = 0; r < 4; ++r) {
+            mask |= static_cast<uint32_t>(
+                        _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(errors[r], best))))
+                    << (4 * r);
+        }
+        int index = 0;
+        while (!(mask & (1u << index))) {
+            ++index;
+        }
+        indices[i] = static_cast<uint8_t>(index);
+        total += static_cast<uint32_t>(_mm_cvtsi128_si32(best));
+    }
+    return total;
+}
+#endif
+
+uint32_t SelectIndices(const Tile& tile, const int16_t palette[16][4], uint8_t indices[16]) {
+#if defined(GFX_TEXTURE_CODECS_X86)
+    if (vertex_kernels::GetActiveIsa() != vertex_kernels::Isa::Scalar) {
+        return SelectIndicesSSE(tile, palette, indices);
+    }
+#endif
+    return SelectIndicesScalar(tile, palette, indices);
+}
+
+// Least-squares endpoints for fixed indices; false if the indices don't constrain both ends.
+bool FitEndpoints(const Tile& tile, const uint8_t indices[16], float ideal[2][4]) {
+    float aa = 0.0f;
+    float ab = 0.0f;
+    float bb = 0.0f;
+    float ax[4] = {};
+    float bx[4] = {};
+    for (int i = 0; i < 16; ++i) {
+        const float b = kBC7Weights[indices[i]] / 64.0f;
+        const float a = 1.0f - b;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (int c = 0; c < 4; ++c) {
+            ax[c] += a * tile[i][c];
+            bx[c] += b * tile[i][c];
+        }
+    }
+    const float determinant = aa * bb - ab * ab;
+    if (std::fabs(determinant) < 1e-6f) {
+        return false;
+    }
+    for (int c = 0; c < 4; ++c) {
+        ideal[0][c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+        ideal[1][c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+class BitWriter {
+  public:
+    explicit BitWriter(uint8_t* bytes) : _bytes(bytes) {}
+
+    void Write(uint32_t value, int bits) {
+        for (int i = 0; i < bits; ++i, ++_position) {
+            _bytes[_position >> 3] |= static_cast<uint8_t>(((value >> i) & 1) << (_position & 7));
+        }
+    }
+
+  private:
+    uint8_t* _bytes;
+    size_t _position{0};
+};
+
+void EncodeBC7Block(const Tile& tile, uint8_t* block) {
+    float mean[4];
+    float axis[4];
+    PrincipalAxis(tile, 4, mean, axis);
+    float minT = 0.0f;
+    float maxT = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float t = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            t += (tile[i][c] - mean[c]) * axis[c];
+        }
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+    float ideal[2][4];
+    for (int c = 0; c < 4; ++c) {
+        ideal[0][c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+        ideal[1][c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+    }
+
+    // Start from the extent along the principal axis, then refit to the chosen indices twice.
+    BC7Endpoints best{};
+    uint8_t bestIndices[16] = {};
+    uint32_t bestError = UINT32_MAX;
+    for (int pass = 0; pass < 3; ++pass) {
+        BC7Endpoints endpoints{};
+        QuantizeEndpoint(ideal[0], endpoints._values[0]);
+        QuantizeEndpoint(ideal[1], endpoints._values[1]);
+        int16_t palette[16][4];
+        BuildBC7Palette(endpoints, palette);
+        uint8_t indices[16];
+        const uint32_t error = SelectIndices(tile, palette, indices);
+        if (error < bestError) {
+            bestError = error;
+            best = endpoints;
+            std::copy(indices, indices + 16, bestIndices);
+        }
+        if (error == 0 || !FitEndpoints(tile, indices, ideal)) {
+            break;
+        }
+    }
+
+    // The first texel's index drops its top bit, so it must be below 8.
+    if (bestIndices[0] >= 8) {
+        std::swap(best._values[0], best._values[1]);
+        for (uint8_t& index : bestIndices) {
+            index = static_cast<uint8_t>(15 - index);
+        }
+    }
+
+    std::memset(block, 0, 16);
+    BitWriter writer(block);
+    writer.Write(1u << 6, 7); // Mode 6
+    for (int c = 0; c < 4; ++c) {
+        writer.Write(static_cast<uint32_t>(best._values[0][c] >> 1), 7);
+        writer.Write(static_cast<uint32_t>(best._values[1][c] >> 1), 7);
+    }
+    writer.Write(static_cast<uint32_t>(best._values[0][0] & 1), 1);
+    writer.Write(static_cast<uint32_t>(best._values[1][0] & 1), 1);
+    writer.Write(bestIndices[0], 3);
+    for (int i = 1; i < 16; ++i) {
+        writer.Write(bestIndices[i], 4);
+    }
+}
+
+void EncodeBlock(Format format, const Tile& tile, uint8_t* block) {
+    switch (format) {
+    case Format::BC1:
+        EncodeBC1Block(tile, block);
+        break;
+    case Format::BC4:
+        EncodeBC4Block(tile, 0, block);
+        break;
+    case Format::BC5:
+        EncodeBC4Block(tile, 0, block);
+        EncodeBC4Block(tile, 1, block + 8);
+        break;
+    case Format::BC7:
+        EncodeBC7Block(tile, block);
+        break;
+    default:
+        break;
+    }
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// texture_codecs implementation
+
+namespace texture_codecs {
+
+BlockInfo GetBlockInfo(Model::TextureFormat format) noexcept {
+    switch (format) {
+    case Format::RGBA8:
+        return {1, 1, 4};
+    case Format::BC1:
+    case Format::BC4:
+    case Format::ETC2RGB8:
+        return {4, 4, 8};
+    case Format::BC3:
+    case Format::BC5:
+    case Format::BC7:
+    case Format::ETC2RGBA8:
+    case Format::ASTC4x4:
+        return {4, 4, 16};
+    }
+    return {};
+}
+
+const char* GetFormatName(Model::TextureFormat format) noexcept {
+    switch (format) {
+    case Format::RGBA8:
+        return "RGBA8";
+    case Format::BC1:
+        return "BC1";
+    case Format::BC3:
+        return "BC3";
+    case Format::BC4:
+        return "BC4";
+    case Format::BC5:
+        return "BC5";
+    case Format::BC7:
+        return "BC7";
+    case Format::ETC2RGB8:
+        return "ETC2 RGB8";
+    case Format::ETC2RGBA8:
+        return "ETC2 RGBA8";
+    case Format::ASTC4x4:
+        return "ASTC 4x4";
+    }
+    return "unknown";
+}
+
+size_t GetLevelSize(Model::TextureFormat format, uint32_t width, uint32_t height) noexcept {
+    const BlockInfo block = GetBlockInfo(format);
+    const size_t blocksWide = (width + block._width - 1) / block._width;
+    const size_t blocksHigh = (height + block._height - 1) / block._height;
+    return blocksWide * blocksHigh * block._bytes;
+}
+
+bool CanDecode(Model::TextureFormat format) noexcept {
+    return format == Format::RGBA8 || format == Format::BC1 || format == Format::BC3 ||
+           format == Format::BC4 || format == Format::BC5;
+}
+
+bool DecodeToRgba8(Model::TextureFormat format, const uint8_t* blocks, uint32_t width,
+                   uint32_t height, uint8_t* rgba) {
+    if (!CanDecode(format)) {
+        return false;
+    }
+    if (format == Format::RGBA8) {
+        std::memcpy(rgba, blocks, static_cast<size_t>(width) * height * 4);
+        return true;
+    }
+
+    const uint32_t blockBytes = GetBlockInfo(format)._bytes;
+    const uint32_t blocksWide = (width + 3) / 4;
+    const uint32_t blocksHigh = (height + 3) / 4;
+    uint8_t tile[16][4];
+    for (uint32_t by = 0; by < blocksHigh; ++by) {
+        for (uint32_t bx = 0; bx < blocksWide; ++bx) {
+            DecodeBlock(format, blocks + (static_cast<size_t>(by) * blocksWide + bx) * blockBytes,
+                        tile);
+
+            // Edge blocks cover texels past the level's size; those are dropped.
+            const uint32_t columns = std::min(4u, width - bx * 4);
+            const uint32_t rows = std::min(4u, height - by * 4);
+            for (uint32_t y = 0; y < rows; ++y) {
+                uint8_t* dst = rgba + ((static_cast<size_t>(by) * 4 + y) * width + bx * 4) * 4;
+                std::memcpy(dst, tile[y * 4], columns * 4);
+            }
+        }
+    }
+    return true;
+}
+
+bool CanEncode(Model::TextureFormat format) noexcept {
+    return format == Format::BC1 || format == Format::BC4 || format == Format::BC5 ||
+           format == Format::BC7;
+}
+
+bool CompressTexture(Model::Texture& texture, Model::TextureFormat format, MipFilter filter) {
+    const uint32_t width = texture._width;
+    const uint32_t height = texture._height;
+    if (!CanEncode(format) || texture._format != Format::RGBA8 || !texture._mipLevels.empty() ||
+        width == 0 || height == 0 ||
+        texture._data.size() != static_cast<size_t>(width) * height * 4) {
+        return false;
+    }
+
+    // Filter the whole chain from level 0 first; every level is encoded from its RGBA8 copy.
+    std::vector<Level> levels;
+    levels.emplace_back(texture._data.data(), texture._data.data() + texture._data.size());
+    std::vector<Model::MipLevel> mipLevels(1);
+    mipLevels[0]._width = width;
+    mipLevels[0]._height = height;
+    while (mipLevels.back()._width > 1 || mipLevels.back()._height > 1) {
+        const Model::MipLevel& previous = mipLevels.back();
+        const uint32_t nextWidth = std::max(previous._width / 2, 1u);
+        const uint32_t nextHeight = std::max(previous._height / 2, 1u);
+        levels.push_back(Downsample(levels.back(), previous._width, previous._height, filter));
+        mipLevels.push_back({nextWidth, nextHeight});
+    }
+
+    size_t totalSize = 0;
+    for (Model::MipLevel& mip : mipLevels) {
+        mip._offset = totalSize;
+        mip._size = GetLevelSize(format, mip._width, mip._height);
+        totalSize += mip._size;
+    }
+    uint8_t* data = static_cast<uint8_t*>(std::malloc(totalSize));
+    if (!data) {
+        return false;
+    }
+
+    const uint32_t blockBytes = GetBlockInfo(format)._bytes;
+    for (size_t level = 0; level < mipLevels.size(); ++level) {
+        const Model::MipLevel& mip = mipLevels[level];
+        const Level& texels = levels[level];
+        const uint32_t blocksWide = (mip._width + 3) / 4;
+        const uint32_t blocksHigh = (mip._height + 3) / 4;
+        ThreadPool::Shared().ParallelFor(blocksHigh, [&](size_t by) {
+            Tile tile;
+            for (uint32_t bx = 0; bx < blocksWide; ++bx) {
+                for (uint32_t i = 0; i < 16; ++i) {
+                    const size_t x = std::min(bx * 4 + (i & 3), mip._width - 1);
+                    const size_t y =
+                        std::min(by * 4 + (i >> 2), static_cast<size_t>(mip._height - 1));
+                    std::memcpy(tile[i], &texels[(y * mip._width + x) * 4], 4);
+                }
+                EncodeBlock(format, tile,
+                            data + mip._offset + (by * blocksWide + bx) * blockBytes);
+            }
+        });
+    }
+
+    texture._data = Model::ImageData(data, totalSize);
+    texture._format = format;
+    texture._components = format == Format::BC4 ? 1 : format == Format::BC5 ? 2 : 4;
+    texture._mipLevels = std::move(mipLevels);
+    return true;
+}
+
+} // namespace texture_codecs
@@ -0,0 +1,54 @@
+/// @file  TextureCodecs.h
+/// @brief Block layouts of Model::TextureFormat and CPU decoders for block-compressed textures.
+
+#pragma once
+
+// Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+
+// Project Headers
+#include "Model.h"
+
+namespace texture_codecs {
+
+// Footprint of one block; RGBA8 counts as 1x1 blocks of 4 bytes.
+struct BlockInfo {
+    uint32_t _width{1};
+    uint32_t _height{1};
+    uint32_t _bytes{4};
+};
+
+BlockInfo GetBlockInfo(Model::TextureFormat format) noexcept;
+const char* GetFormatName(Model::TextureFormat format) noexcept;
+
+// Bytes of one mip level, whole blocks in each dimension.
+size_t GetLevelSize(Model::TextureFormat format, uint32_t width, uint32_t height) noexcept;
+
+// True for the formats DecodeToRgba8 handles (RGBA8, BC1, BC3, BC4 and BC5). The others can
+// only be used on devices that sample them.
+bool CanDecode(Model::TextureFormat format) noexcept;
+
+// Expands one level to width * height RGBA8 pixels the way GPUs sample it: BC4 as (r, 0, 0, 1)
+// and BC5 as (r, g, 0, 1). Returns false for formats CanDecode rejects.
+bool DecodeToRgba8(Model::TextureFormat format, const uint8_t* blocks, uint32_t width,
+                   uint32_t height, uint8_t* rgba);
+
+// How CompressTexture filters mip levels: sRGB color is averaged in linear space and normal maps
+// are renormalized; everything else uses a plain 2x2 box filter.
+enum class MipFilter { Linear, Srgb, Normal };
+
+// Changes whenever the encoders' output does; texture caches key on it.
+constexpr uint32_t kEncoderVersion = 1;
+
+// True for the formats CompressTexture encodes (BC1, BC4, BC5 and BC7).
+bool CanEncode(Model::TextureFormat format) noexcept;
+
+// Replaces a single-level RGBA8 texture with its full mip chain in `format`. Mips are filtered
+// from level 0 first. Blocks are encoded in parallel on the shared thread pool. BC7 uses mode 6
+// (one subset, RGBA endpoints) with an SSE4.1 index search when vertex_kernels allows it. BC4
+// keeps red and BC5 red and green. Returns false and leaves the texture alone if `format` has
+// no encoder or the texture is not 8-bit RGBA.
+bool CompressTexture(Model::Texture& texture, Model::TextureFormat format, MipFilter filter);
+
+} // namespace texture_codecs
@@ -0,0 +1,132 @@
+// Class Header
+#include "ThreadPool.h"
+
+// Standard Library Headers
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+//----------------------------------------------------------------------
+// Internal Types
+
+namespace {
+
+// Shared between the caller of ParallelFor and the helper tasks it submits. Helpers may start
+// after the loop has already finished, so the state outlives the call via shared ownership.
+struct ParallelForState {
+    std::atomic<size_t> _next{0};
+    std::atomic<size_t> _completed{0};
+    size_t _count{0};
+    const std::function<void(size_t)>* _func{nullptr};
+    std::mutex _mutex;
+    std::condition_variable _condition;
+};
+
+// Claims and runs iterations until none are left.
+void RunIterations(ParallelForState& state) {
+    size_t finished = 0;
+    for (size_t i = state._next.fetch_add(1); i < state._count; i = state._next.fetch_add(1)) {
+        (*state._func)(i);
+        ++finished;
+    }
+
+    if (finished > 0 && state._completed.fetch_add(finished) + finished == state._count) {
+        std::lock_guard<std::mutex> lock(state._mutex);
+        state._condition.notify_all();
+    }
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// ThreadPool Class implementation
+
+ThreadPool::ThreadPool(size_t workerCount) {
+    _workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        _workers.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _condition.notify_all();
+
+    for (std::thread& worker : _workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::Shared() {
+#if defined(__EMSCRIPTEN__)
+    // No pthread support in the web build; everything runs on the main thread.
+    static ThreadPool pool(0);
+#else
+    // The calling thread also participates in ParallelFor, so leave one core for it.
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+#endif
+    return pool;
+}
+
+size_t ThreadPool::GetWorkerCount() const noexcept {
+    return _workers.size();
+}
+
+std::future<void> ThreadPool::Submit(std::function<void()> task) {
+    std::packaged_task<void()> packagedTask(std::move(task));
+    std::future<void> future = packagedTask.get_future();
+
+    if (_workers.empty()) {
+        packagedTask();
+        return future;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(std::move(packagedTask));
+    }
+    _condition.notify_one();
+
+    return future;
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& func) {
+    if (count == 0) {
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>();
+    state->_count = count;
+    state->_func = &func;
+
+    // Never wait on the helpers themselves: when called from a pool task they might still be
+    // queued behind us. Completion is tracked per iteration instead.
+    const size_t helperCount = std::min(_workers.size(), count - 1);
+    for (size_t i = 0; i < helperCount; ++i) {
+        Submit([state]() { RunIterations(*state); });
+    }
+
+    RunIterations(*state);
+
+    std::unique_lock<std::mutex> lock(state->_mutex);
+    state->_condition.wait(lock, [&state, count]() { return state->_completed.load() == count; });
+}
+
+void ThreadPool::WorkerLoop() {
+    for (;;) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+            if (_tasks.empty()) {
+                return; // Stopping and fully drained.
+            }
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        task();
+    }
+}
@@ -0,0 +1,52 @@
+/// @file  ThreadPool.h
+/// @brief Fixed-size worker pool used to parallelize scene loading and processing.
+
+#pragma once
+
+// Standard Library Headers
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ThreadPool Class
+class ThreadPool {
+  public:
+    // Constructor (a pool with zero workers runs every task inline on the calling thread)
+    explicit ThreadPool(size_t workerCount);
+
+    // Destructor (drains queued tasks, then joins all workers)
+    ~ThreadPool();
+
+    // Non-copyable and non-movable
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    // Process-wide pool sized to the hardware concurrency (no workers on Emscripten).
+    static ThreadPool& Shared();
+
+    // Public Interface
+    size_t GetWorkerCount() const noexcept;
+    std::future<void> Submit(std::function<void()> task);
+
+    // Invokes func(i) for every i in [0, count). The calling thread takes part in the work, so
+    // this is safe to call from inside a pool task.
+    void ParallelFor(size_t count, const std::function<void(size_t)>& func);
+
+  private:
+    // Private Member Functions
+    void WorkerLoop();
+
+    // Private Member Variables
+    std::vector<std::thread> _workers;
+    std::deque<std::packaged_task<void()>> _tasks;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _stopping{false};
+};
@@ -0,0 +1,689 @@
+// Class Header
+#include "VertexKernels.h"
+
+// Standard Library Headers
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+// Third-Party Library Headers
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GFX_VERTEX_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang compile each kernel for its own ISA so the rest of the build keeps the baseline
+// target. MSVC exposes all intrinsics unconditionally.
+#if defined(GFX_VERTEX_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define GFX_TARGET_SSE4 __attribute__((target("sse4.1")))
+#define GFX_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define GFX_TARGET_SSE4
+#define GFX_TARGET_AVX2
+#endif
+
+//----------------------------------------------------------------------
+// Internal Utility Functions
+
+namespace {
+
+using vertex_kernels::Isa;
+
+std::atomic<int> s_activeIsa{-1};
+
+Isa DetectIsa() {
+#if defined(GFX_VERTEX_KERNELS_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool sse41 = (info[2] & (1 << 19)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    const bool sse41 = __builtin_cpu_supports("sse4.1");
+    const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2) {
+        return Isa::AVX2;
+    }
+    if (sse41) {
+        return Isa::SSE4;
+    }
+#endif
+    return Isa::Scalar;
+}
+
+//----------------------------------------------------------------------
+// Scalar kernels (reference path, matches glm exactly)
+
+glm::vec3 LoadFloat3(const uint8_t* src) {
+    float v[3];
+    std::memcpy(v, src, sizeof(v));
+    return glm::vec3(v[0], v[1], v[2]);
+}
+
+void TransformPositionsScalar(const uint8_t* src, size_t stride, size_t count,
+                              const glm::mat4& matrix, Model::Vertex* dst, glm::vec3& minBounds,
+                              glm::vec3& maxBounds) {
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec4 source(LoadFloat3(src + i * stride), 1.0f);
+        const glm::vec3 position = glm::vec3(matrix * source);
+        dst[i]._position = position;
+        minBounds = glm::min(minBounds, position);
+        maxBounds = glm::max(maxBounds, position);
+    }
+}
+
+void TransformNormalsScalar(const uint8_t* src, size_t stride, size_t count,
+                            const glm::mat3& matrix, Model::Vertex* dst) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i]._normal = glm::normalize(matrix * LoadFloat3(src + i * stride));
+    }
+}
+
+void TransformTangentsScalar(const uint8_t* src, size_t stride, size_t count,
+                             const glm::mat3& matrix, Model::Vertex* dst) {
+    for (size_t i = 0; i < count; ++i) {
+        float w;
+        std::memcpy(&w, src + i * stride + 3 * sizeof(float), sizeof(w));
+        dst[i]._tangent = glm::vec4(glm::normalize(matrix * LoadFloat3(src + i * stride)), w);
+    }
+}
+
+// Orthonormalized tangents shorter than this fraction of the accumulated one (squared) are
+// treated as parallel to the normal.
+constexpr float kMinTangentLengthRatioSq = 1e-6f;
+
+// Any unit tangent perpendicular to `normal` (the same fallback the MikkTSpace path uses).
+glm::vec4 PerpendicularTangent(const glm::vec3& normal) {
+    constexpr float kSingularityThreshold = -0.99998796f;
+    if (normal.z < kSingularityThreshold) {
+        return glm::vec4(0.0f, -1.0f, 0.0f, 1.0f);
+    }
+    const float a = 1.0f / (1.0f + normal.z);
+    const float b = -normal.x * normal.y * a;
+    return glm::vec4(1.0f - normal.x * normal.x * a, b, -normal.x, 1.0f);
+}
+
+// Handedness as stored in Model::Vertex::_tangent.w (the negated MikkTSpace sign).
+float Handedness(const glm::vec3& normal, const glm::vec3& tangent, const glm::vec3& bitangent) {
+    return glm::dot(glm::cross(normal, tangent), bitangent) < 0.0f ? 1.0f : -1.0f;
+}
+
+void AccumulateTangentFramesScalar(const Model::Vertex* vertices, const uint32_t* indices,
+                                   size_t triangleCount, uint32_t baseVertex,
+                                   glm::vec4* frames) {
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t i0 = indices[t * 3 + 0] - baseVertex;
+        const uint32_t i1 = indices[t * 3 + 1] - baseVertex;
+        const uint32_t i2 = indices[t * 3 + 2] - baseVertex;
+        const glm::vec3 e1 = vertices[i1]._position - vertices[i0]._position;
+        const glm::vec3 e2 = vertices[i2]._position - vertices[i0]._position;
+        const glm::vec2 d1 = vertices[i1]._texCoord0 - vertices[i0]._texCoord0;
+        const glm::vec2 d2 = vertices[i2]._texCoord0 - vertices[i0]._texCoord0;
+
+        // dP/du and dP/dv scaled by the UV determinant, which weights them by triangle size.
+        const float sign = d1.x * d2.y - d2.x * d1.y < 0.0f ? -1.0f : 1.0f;
+        const glm::vec4 tangent((e1 * d2.y - e2 * d1.y) * sign, 0.0f);
+        const glm::vec4 bitangent((e2 * d1.x - e1 * d2.x) * sign, 0.0f);
+        for (uint32_t i : {i0, i1, i2}) {
+            frames[2 * i + 0] += tangent;
+            frames[2 * i + 1] += bitangent;
+        }
+    }
+}
+
+void OrthonormalizeTangentFramesScalar(const glm::vec4* frames, size_t count, Model::Vertex* dst) {
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec3 normal = dst[i]._normal;
+        const glm::vec3 tangent(frames[2 * i]);
+        const glm::vec3 ortho = tangent - normal * glm::dot(normal, tangent);
+        const float lengthSq = glm::dot(ortho, ortho);
+        if (lengthSq > kMinTangentLengthRatioSq * glm::dot(tangent, tangent) && lengthSq > 0.0f) {
+            const glm::vec3 unit = ortho * (1.0f / std::sqrt(lengthSq));
+            const glm::vec3 bitangent(frames[2 * i + 1]);
+            dst[i]._tangent = glm::vec4(unit, Handedness(normal, unit, bitangent));
+        } else {
+            dst[i]._tangent = PerpendicularTangent(normal);
+        }
+    }
+}
+
+// The corner of every box furthest along a plane's normal, as the arrays holding its coordinates.
+// A box is outside the plane exactly when that corner is.
+struct PlaneCorners {
+    const float* _x;
+    const float* _y;
+    const float* _z;
+};
+
+PlaneCorners GetPlaneCorners(const vertex_kernels::AabbArrays& boxes, const glm::vec4& plane) {
+    return {plane.x >= 0.0f ? boxes._max[0] : boxes._min[0],
+            plane.y >= 0.0f ? boxes._max[1] : boxes._min[1],
+            plane.z >= 0.0f ? boxes._max[2] : boxes._min[2]};
+}
+
+// Tests boxes [first, count); the SIMD kernels finish their remainder here.
+size_t CullAabbsScalar(const vertex_kernels::AabbArrays& boxes, size_t first, size_t count,
+                       const glm::vec4 planes[6], uint8_t* visible) {
+    PlaneCorners corners[6];
+    for (int p = 0; p < 6; ++p) {
+        corners[p] = GetPlaneCorners(boxes, planes[p]);
+    }
+
+    size_t visibleCount = 0;
+    for (size_t i = first; i < count; ++i) {
+        bool inside = true;
+        for (int p = 0; p < 6; ++p) {
+            const float distance = planes[p].x * corners[p]._x[i] +
+                                   planes[p].y * corners[p]._y[i] +
+                                   planes[p].z * corners[p]._z[i] + planes[p].w;
+            inside = inside && distance >= 0.0f;
+        }
+        visible[i] = inside ? 1 : 0;
+        visibleCount += inside ? 1 : 0;
+    }
+    return visibleCount;
+}
+
+#if defined(GFX_VERTEX_KERNELS_X86)
+
+//----------------------------------------------------------------------
+// SSE4.1 kernels (one vertex per iteration)
+//
+// The operation order mirrors glm's scalar code and no FMA is used, so every ISA produces
+// bit-identical vertices.
+
+GFX_TARGET_SSE4 inline __m128 LoadFloat3SSE(const uint8_t* src) {
+    // Two loads so the last element of a tightly packed accessor never reads past its end.
+    const __m128 xy = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+    float z;
+    std::memcpy(&z, src + 2 * sizeof(float), sizeof(z));
+    return _mm_movelh_ps(xy, _mm_set_ss(z));
+}
+
+GFX_TARGET_SSE4 inline void StoreFloat3SSE(float* dst, __m128 v) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_castps_si128(v));
+    _mm_store_ss(dst + 2, _mm_movehl_ps(v, v));
+}
+
+GFX_TARGET_SSE4 inline __m128 Transform3x3SSE(__m128 c0, __m128 c1, __m128 c2, __m128 v) {
+    const __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, x), _mm_mul_ps(c1, y)), _mm_mul_ps(c2, z));
+}
+
+GFX_TARGET_SSE4 inline __m128 NormalizeSSE(__m128 v) {
+    const __m128 lengthSq = _mm_dp_ps(v, v, 0x7F);
+    return _mm_mul_ps(v, _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSq)));
+}
+
+GFX_TARGET_SSE4 void TransformPositionsSSE4(const uint8_t* src, size_t stride, size_t count,
+                                            const glm::mat4& matrix, Model::Vertex* dst,
+                                            glm::vec3& minBounds, glm::vec3& maxBounds) {
+    const __m128 c0 = _mm_loadu_ps(&matrix[0][0]);
+    const __m128 c1 = _mm_loadu_ps(&matrix[1][0]);
+    const __m128 c2 = _mm_loadu_ps(&matrix[2][0]);
+    const __m128 c3 = _mm_loadu_ps(&matrix[3][0]);
+    __m128 vmin = _mm_setr_ps(minBounds.x, minBounds.y, minBounds.z, 0.0f);
+    __m128 vmax = _mm_setr_ps(maxBounds.x, maxBounds.y, maxBounds.z, 0.0f);
+
+    for (size_t i = 0; i < count; ++i) {
+        const __m128 p = LoadFloat3SSE(src + i * stride);
+        const __m128 x = _mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m128 y = _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m128 z = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, x), _mm_mul_ps(c1, y)),
+                                    _mm_add_ps(_mm_mul_ps(c2, z), c3));
+        StoreFloat3SSE(&dst[i]._position.x, r);
+        vmin = _mm_min_ps(vmin, r);
+        vmax = _mm_max_ps(vmax, r);
+    }
+
+    alignas(16) float result[4];
+    _mm_store_ps(result, vmin);
+    minBounds = glm::vec3(result[0], result[1], result[2]);
+    _mm_store_ps(result, vmax);
+    maxBounds = glm::vec3(result[0], result[1], result[2]);
+}
+
+GFX_TARGET_SSE4 void TransformNormalsSSE4(const uint8_t* src, size_t stride, size_t count,
+                                          const glm::mat3& matrix, Model::Vertex* dst) {
+    const __m128 c0 = _mm_setr_ps(matrix[0][0], matrix[0][1], matrix[0][2], 0.0f);
+    const __m128 c1 = _mm_setr_ps(matrix[1][0], matrix[1][1], matrix[1][2], 0.0f);
+    const __m128 c2 = _mm_setr_ps(matrix[2][0], matrix[2][1], matrix[2][2], 0.0f);
+
+    for (size_t i = 0; i < count; ++i) {
+        const __m128 n = Transform3x3SSE(c0, c1, c2, LoadFloat3SSE(src + i * stride));
+        StoreFloat3SSE(&dst[i]._normal.x, NormalizeSSE(n));
+    }
+}
+
+GFX_TARGET_SSE4 void TransformTangentsSSE4(const uint8_t* src, size_t stride, size_t count,
+                                           const glm::mat3& matrix, Model::Vertex* dst) {
+    const __m128 c0 = _mm_setr_ps(matrix[0][0], matrix[0][1], matrix[0][2], 0.0f);
+    const __m128 c1 = _mm_setr_ps(matrix[1][0], matrix[1][1], matrix[1][2], 0.0f);
+    const __m128 c2 = _mm_setr_ps(matrix[2][0], matrix[2][1], matrix[2][2], 0.0f);
+
+    for (size_t i = 0; i < count; ++i) {
+        const __m128 t = _mm_loadu_ps(reinterpret_cast<const float*>(src + i * stride));
+        const __m128 n = NormalizeSSE(Transform3x3SSE(c0, c1, c2, t));
+        _mm_storeu_ps(&dst[i]._tangent.x, _mm_blend_ps(n, t, 0x8)); // Keep handedness (w).
+    }
+}
+
+GFX_TARGET_SSE4 inline __m128 CrossSSE(__m128 a, __m128 b) {
+    const __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+    return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+GFX_TARGET_SSE4 void AccumulateTangentFramesSSE4(const Model::Vertex* vertices,
+                                                 const uint32_t* indices, size_t triangleCount,
+                                                 uint32_t baseVertex, glm::vec4* frames) {
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t i0 = indices[t * 3 + 0] - baseVertex;
+        const uint32_t i1 = indices[t * 3 + 1] - baseVertex;
+        const uint32_t i2 = indices[t * 3 + 2] - baseVertex;
+        const __m128 p0 = LoadFloat3SSE(reinterpret_cast<const uint8_t*>(&vertices[i0]._position));
+        const __m128 e1 = _mm_sub_ps(
+            LoadFloat3SSE(reinterpret_cast<const uint8_t*>(&vertices[i1]._position)), p0);
+        const __m128 e2 = _mm_sub_ps(
+            LoadFloat3SSE(reinterpret_cast<const uint8_t*>(&vertices[i2]._position)), p0);
+        const glm::vec2 d1 = vertices[i1]._texCoord0 - vertices[i0]._texCoord0;
+        const glm::vec2 d2 = vertices[i2]._texCoord0 - vertices[i0]._texCoord0;
+
+        const __m128 sign = _mm_set1_ps(d1.x * d2.y - d2.x * d1.y < 0.0f ? -1.0f : 1.0f);
+        const __m128 tangent = _mm_mul_ps(
+            _mm_sub_ps(_mm_mul_ps(e1, _mm_set1_ps(d2.y)), _mm_mul_ps(e2, _mm_set1_ps(d1.y))),
+            sign);
+        const __m128 bitangent = _mm_mul_ps(
+            _mm_sub_ps(_mm_mul_ps(e2, _mm_set1_ps(d1.x)), _mm_mul_ps(e1, _mm_set1_ps(d2.x))),
+            sign);
+        for (uint32_t i : {i0, i1, i2}) {
+            float* frame = &frames[2 * i].x;
+            _mm_storeu_ps(frame, _mm_add_ps(_mm_loadu_ps(frame), tangent));
+            _mm_storeu_ps(frame + 4, _mm_add_ps(_mm_loadu_ps(frame + 4), bitangent));
+        }
+    }
+}
+
+GFX_TARGET_SSE4 void OrthonormalizeTangentFramesSSE4(const glm::vec4* frames, size_t count,
+                                                     Model::Vertex* dst) {
+    for (size_t i = 0; i < count; ++i) {
+        const __m128 normal = LoadFloat3SSE(reinterpret_cast<const uint8_t*>(&dst[i]._normal));
+        const __m128 tangent = _mm_loadu_ps(&frames[2 * i].x);
+        const __m128 ortho =
+            _mm_sub_ps(tangent, _mm_mul_ps(normal, _mm_dp_ps(normal, tangent, 0x7F)));
+        const __m128 lengthSq = _mm_dp_ps(ortho, ortho, 0x7F);
+        const float length = _mm_cvtss_f32(lengthSq);
+        const float tangentLengthSq = _mm_cvtss_f32(_mm_dp_ps(tangent, tangent, 0x71));
+        if (!(length > kMinTangentLengthRatioSq * tangentLengthSq && length > 0.0f)) {
+            dst[i]._tangent = PerpendicularTangent(dst[i]._normal);
+            continue;
+        }
+
+        const __m128 unit = _mm_mul_ps(ortho, _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSq)));
+        const __m128 bitangent = _mm_loadu_ps(&frames[2 * i + 1].x);
+        const float side = _mm_cvtss_f32(_mm_dp_ps(CrossSSE(normal, unit), bitangent, 0x71));
+        _mm_storeu_ps(&dst[i]._tangent.x,
+                      _mm_blend_ps(unit, _mm_set1_ps(side < 0.0f ? 1.0f : -1.0f), 0x8));
+    }
+}
+
+// Four boxes per iteration, same operation order as the scalar test.
+GFX_TARGET_SSE4 size_t CullAabbsSSE4(const vertex_kernels::AabbArrays& boxes, size_t count,
+                                     const glm::vec4 planes[6], uint8_t* visible) {
+    PlaneCorners corners[6];
+    for (int p = 0; p < 6; ++p) {
+        corners[p] = GetPlaneCorners(boxes, planes[p]);
+    }
+
+    const __m128 zero = _mm_setzero_ps();
+    size_t visibleCount = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            const __m128 x = _mm_mul_ps(_mm_set1_ps(planes[p].x), _mm_loadu_ps(corners[p]._x + i));
+            const __m128 y = _mm_mul_ps(_mm_set1_ps(planes[p].y), _mm_loadu_ps(corners[p]._y + i));
+            const __m128 z = _mm_mul_ps(_mm_set1_ps(planes[p].z), _mm_loadu_ps(corners[p]._z + i));
+            const __m128 distance =
+                _mm_add_ps(_mm_add_ps(_mm_add_ps(x, y), z), _mm_set1_ps(planes[p].w));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, zero));
+        }
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_ps(inside));
+        for (size_t lane = 0; lane < 4; ++lane) {
+            visible[i + lane] = static_cast<uint8_t>((mask >> lane) & 1u);
+        }
+        visibleCount += static_cast<size_t>(std::popcount(mask));
+    }
+    return visibleCount + CullAabbsScalar(boxes, i, count, planes, visible);
+}
+
+//----------------------------------------------------------------------
+// AVX2 kernels (two vertices per iteration, one per 128-bit lane)
+
+GFX_TARGET_AVX2 inline __m256 LoadFloat3PairAVX2(const uint8_t* src, size_t stride) {
+    return _mm256_set_m128(LoadFloat3SSE(src + stride), LoadFloat3SSE(src));
+}
+
+GFX_TARGET_AVX2 inline __m256 Transform3x3AVX2(__m256 c0, __m256 c1, __m256 c2, __m256 v) {
+    const __m256 x = _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m256 y = _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m256 z = _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2));
+    return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0, x), _mm256_mul_ps(c1, y)),
+                         _mm256_mul_ps(c2, z));
+}
+
+GFX_TARGET_AVX2 inline __m256 NormalizeAVX2(__m256 v) {
+    const __m256 lengthSq = _mm256_dp_ps(v, v, 0x7F);
+    return _mm256_mul_ps(v, _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSq)));
+}
+
+GFX_TARGET_AVX2 void TransformPositionsAVX2(const uint8_t* src, size_t stride, size_t count,
+                                            const glm::mat4& matrix, Model::Vertex* dst,
+                                            glm::vec3& minBounds, glm::vec3& maxBounds) {
+    const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&matrix[0][0]));
+    const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&matrix[1][0]));
+    const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&matrix[2][0]));
+    const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&matrix[3][0]));
+    const __m128 initialMin = _mm_setr_ps(minBounds.x, minBounds.y, minBounds.z, 0.0f);
+    const __m128 initialMax = _mm_setr_ps(maxBounds.x, maxBounds.y, maxBounds.z, 0.0f);
+    __m256 vmin = _mm256_set_m128(initialMin, initialMin);
+    __m256 vmax = _mm256_set_m128(initialMax, initialMax);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m256 p = LoadFloat3PairAVX2(src + i * stride, stride);
+        const __m256 x = _mm256_permute_ps(p, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m256 y = _mm256_permute_ps(p, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m256 z = _mm256_permute_ps(p, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(c0, x), _mm256_mul_ps(c1, y)),
+                                       _mm256_add_ps(_mm256_mul_ps(c2, z), c3));
+        StoreFloat3SSE(&dst[i]._position.x, _mm256_castps256_ps128(r));
+        StoreFloat3SSE(&dst[i + 1]._position.x, _mm256_extractf128_ps(r, 1));
+        vmin = _mm256_min_ps(vmin, r);
+        vmax = _mm256_max_ps(vmax, r);
+    }
+
+    // Fold both lanes, then let the SSE kernel finish an odd tail vertex.
+    alignas(16) float result[4];
+    _mm_store_ps(result, _mm_min_ps(_mm256_castps256_ps128(vmin), _mm256_extractf128_ps(vmin, 1)));
+    minBounds = glm::vec3(result[0], result[1], result[2]);
+    _mm_store_ps(result, _mm_max_ps(_mm256_castps256_ps128(vmax), _mm256_extractf128_ps(vmax, 1)));
+    maxBounds = glm::vec3(result[0], result[1], result[2]);
+
+    if (i < count) {
+        TransformPositionsSSE4(src + i * stride, stride, count - i, matrix, dst + i, minBounds,
+                               maxBounds);
+    }
+}
+
+GFX_TARGET_AVX2 void TransformNormalsAVX2(const uint8_t* src, size_t stride, size_t count,
+                                          const glm::mat3& matrix, Model::Vertex* dst) {
+    const __m128 m0 = _mm_setr_ps(matrix[0][0], matrix[0][1], matrix[0][2], 0.0f);
+    const __m128 m1 = _mm_setr_ps(matrix[1][0], matrix[1][1], matrix[1][2], 0.0f);
+    const __m128 m2 = _mm_setr_ps(matrix[2][0], matrix[2][1], matrix[2][2], 0.0f);
+    const __m256 c0 = _mm256_set_m128(m0, m0);
+    const __m256 c1 = _mm256_set_m128(m1, m1);
+    const __m256 c2 = _mm256_set_m128(m2, m2);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m256 source = LoadFloat3PairAVX2(src + i * stride, stride);
+        const __m256 n = NormalizeAVX2(Transform3x3AVX2(c0, c1, c2, source));
+        StoreFloat3SSE(&dst[i]._normal.x, _mm256_castps256_ps128(n));
+        StoreFloat3SSE(&dst[i + 1]._normal.x, _mm256_extractf128_ps(n, 1));
+    }
+
+    if (i < count) {
+        TransformNormalsSSE4(src + i * stride, stride, count - i, matrix, dst + i);
+    }
+}
+
+GFX_TARGET_AVX2 void TransformTangentsAVX2(const uint8_t* src, size_t stride, size_t count,
+                                           const glm::mat3& matrix, Model::Vertex* dst) {
+    const __m128 m0 = _mm_setr_ps(matrix[0][0], matrix[0][1], matrix[0][2], 0.0f);
+    const __m128 m1 = _mm_setr_ps(matrix[1][0], matrix[1][1], matrix[1][2], 0.0f);
+    const __m128 m2 = _mm_setr_ps(matrix[2][0], matrix[2][1], matrix[2][2], 0.0f);
+    const __m256 c0 = _mm256_set_m128(m0, m0);
+    const __m256 c1 = _mm256_set_m128(m1, m1);
+    const __m256 c2 = _mm256_set_m128(m2, m2);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const uint8_t* p = src + i * stride;
+        const __m256 t = _mm256_set_m128(_mm_loadu_ps(reinterpret_cast<const float*>(p + stride)),
+                                         _mm_loadu_ps(reinterpret_cast<const float*>(p)));
+        const __m256 n = NormalizeAVX2(Transform3x3AVX2(c0, c1, c2, t));
+        const __m256 r = _mm256_blend_ps(n, t, 0x88); // Keep handedness (w) in both lanes.
+        _mm_storeu_ps(&dst[i]._tangent.x, _mm256_castps256_ps128(r));
+        _mm_storeu_ps(&dst[i + 1]._tangent.x, _mm256_extractf128_ps(r, 1));
+    }
+
+    if (i < count) {
+        TransformTangentsSSE4(src + i * stride, stride, count - i, matrix, dst + i);
+    }
+}
+
+GFX_TARGET_AVX2 void AccumulateTangentFramesAVX2(const Model::Vertex* vertices,
+                                                 const uint32_t* indices, size_t triangleCount,
+                                                 uint32_t baseVertex, glm::vec4* frames) {
+    // Tangent in the low lane and bitangent in the high lane, so each vertex's frame is a single
+    // 256-bit read-modify-write.
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t i0 = indices[t * 3 + 0] - baseVertex;
+        const uint32_t i1 = indices[t * 3 + 1] - baseVertex;
+        const uint32_t i2 = indices[t * 3 + 2] - baseVertex;
+        const __m128 p0 = LoadFloat3SSE(reinterpret_cast<const uint8_t*>(&vertices[i0]._position));
+        const __m128 e1 = _mm_sub_ps(
+            LoadFloat3SSE(reinterpret_cast<const uint8_t*>(&vertices[i1]._position)), p0);
+        const __m128 e2 = _mm_sub_ps(
+            LoadFloat3SSE(reinterpret_cast<const uint8_t*>(&vertices[i2]._position)), p0);
+        const glm::vec2 d1 = vertices[i1]._texCoord0 - vertices[i0]._texCoord0;
+        const glm::vec2 d2 = vertices[i2]._texCoord0 - vertices[i0]._texCoord0;
+
+        const __m256 sign = _mm256_set1_ps(d1.x * d2.y - d2.x * d1.y < 0.0f ? -1.0f : 1.0f);
+        const __m256 a = _mm256_set_m128(e2, e1);
+        const __m256 b = _mm256_set_m128(e1, e2);
+        const __m256 scaleA = _mm256_set_m128(_mm_set1_ps(d1.x), _mm_set1_ps(d2.y));
+        const __m256 scaleB = _mm256_set_m128(_mm_set1_ps(d2.x), _mm_set1_ps(d1.y));
+        const __m256 frame = _mm256_mul_ps(
+            _mm256_sub_ps(_mm256_mul_ps(a, scaleA), _mm256_mul_ps(b, scaleB)), sign);
+        for (uint32_t i : {i0, i1, i2}) {
+            float* dst = &frames[2 * i].x;
+            _mm256_storeu_ps(dst, _mm256_add_ps(_mm256_loadu_ps(dst), frame));
+        }
+    }
+}
+
+// Eight boxes per iteration, same operation order as the scalar test.
+GFX_TARGET_AVX2 size_t CullAabbsAVX2(const vertex_kernels::AabbArrays& boxes, size_t count,
+                                     const glm::vec4 planes[6], uint8_t* visible) {
+    PlaneCorners corners[6];
+    for (int p = 0; p < 6; ++p) {
+        corners[p] = GetPlaneCorners(boxes, planes[p]);
+    }
+
+    const __m256 zero = _mm256_setzero_ps();
+    size_t visibleCount = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            const __m256 x =
+                _mm256_mul_ps(_mm256_set1_ps(planes[p].x), _mm256_loadu_ps(corners[p]._x + i));
+            const __m256 y =
+                _mm256_mul_ps(_mm256_set1_ps(planes[p].y), _mm256_loadu_ps(corners[p]._y + i));
+            const __m256 z =
+                _mm256_mul_ps(_mm256_set1_ps(planes[p].z), _mm256_loadu_ps(corners[p]._z + i));
+            const __m256 distance =
+                _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(x, y), z), _mm256_set1_ps(planes[p].w));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, zero, _CMP_GE_OQ));
+        }
+        const unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(inside));
+        for (size_t lane = 0; lane < 8; ++lane) {
+            visible[i + lane] = static_cast<uint8_t>((mask >> lane) & 1u);
+        }
+        visibleCount += static_cast<size_t>(std::popcount(mask));
+    }
+    return visibleCount + CullAabbsScalar(boxes, i, count, planes, visible);
+}
+
+#endif // GFX_VERTEX_KERNELS_X86
+
+} // namespace
+
+//----------------------------------------------------------------------
+
+namespace vertex_kernels {
+
+Isa GetSupportedIsa() {
+    static const Isa supported = DetectIsa();
+    return supported;
+}
+
+Isa GetActiveIsa() {
+    const int active = s_activeIsa.load(std::memory_order_relaxed);
+    return active < 0 ? GetSupportedIsa() : static_cast<Isa>(active);
+}
+
+void SetActiveIsa(Isa isa) {
+    const Isa supported = GetSupportedIsa();
+    s_activeIsa.store(static_cast<int>(isa > supported ? supported : isa),
+                      std::memory_order_relaxed);
+}
+
+const char* GetIsaName(Isa isa) {
+    switch (isa) {
+    case Isa::SSE4:
+        return "sse4";
+    case Isa::AVX2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+bool ParseIsa(std::string_view name, Isa& isa) {
+    for (Isa candidate : {Isa::Scalar, Isa::SSE4, Isa::AVX2}) {
+        if (name == GetIsaName(candidate)) {
+            isa = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TransformPositions(const uint8_t* src, size_t stride, size_t count, const glm::mat4& matrix,
+                        Model::Vertex* dst, glm::vec3& minBounds, glm::vec3& maxBounds) {
+    switch (GetActiveIsa()) {
+#if defined(GFX_VERTEX_KERNELS_X86)
+    case Isa::AVX2:
+        TransformPositionsAVX2(src, stride, count, matrix, dst, minBounds, maxBounds);
+        break;
+    case Isa::SSE4:
+        TransformPositionsSSE4(src, stride, count, matrix, dst, minBounds, maxBounds);
+        break;
+#endif
+    default:
+        TransformPositionsScalar(src, stride, count, matrix, dst, minBounds, maxBounds);
+        break;
+    }
+}
+
+void TransformNormals(const uint8_t* src, size_t stride, size_t count, const glm::mat3& matrix,
+                      Model::Vertex* dst) {
+    switch (GetActiveIsa()) {
+#if defined(GFX_VERTEX_KERNELS_X86)
+    case Isa::AVX2:
+        TransformNormalsAVX2(src, stride, count, matrix, dst);
+        break;
+    case Isa::SSE4:
+        TransformNormalsSSE4(src, stride, count, matrix, dst);
+        break;
+#endif
+    default:
+        TransformNormalsScalar(src, stride, count, matrix, dst);
+        break;
+    }
+}
+
+void AccumulateTangentFrames(const Model::Vertex* vertices, const uint32_t* indices,
+                             size_t triangleCount, uint32_t baseVertex, glm::vec4* frames) {
+    switch (GetActiveIsa()) {
+#if defined(GFX_VERTEX_KERNELS_X86)
+    case Isa::AVX2:
+        AccumulateTangentFramesAVX2(vertices, indices, triangleCount, baseVertex, frames);
+        break;
+    case Isa::SSE4:
+        AccumulateTangentFramesSSE4(vertices, indices, triangleCount, baseVertex, frames);
+        break;
+#endif
+    default:
+        AccumulateTangentFramesScalar(vertices, indices, triangleCount, baseVertex, frames);
+        break;
+    }
+}
+
+void OrthonormalizeTangentFrames(const glm::vec4* frames, size_t count, Model::Vertex* dst) {
+    switch (GetActiveIsa()) {
+#if defined(GFX_VERTEX_KERNELS_X86)
+    case Isa::AVX2: // Per-vertex work with two branches; 128-bit lanes are as wide as it gets.
+    case Isa::SSE4:
+        OrthonormalizeTangentFramesSSE4(frames, count, dst);
+        break;
+#endif
+    default:
+        OrthonormalizeTangentFramesScalar(frames, count, dst);
+        break;
+    }
+}
+
+void TransformTangents(const uint8_t* src, size_t stride, size_t count, const glm::mat3& matrix,
+                       Model::Vertex* dst) {
+    switch (GetActiveIsa()) {
+#if defined(GFX_VERTEX_KERNELS_X86)
+    case Isa::AVX2:
+        TransformTangentsAVX2(src, stride, count, matrix, dst);
+        break;
+    case Isa::SSE4:
+        TransformTangentsSSE4(src, stride, count, matrix, dst);
+        break;
+#endif
+    default:
+        TransformTangentsScalar(src, stride, count, matrix, dst);
+        break;
+    }
+}
+
+size_t CullAabbs(const AabbArrays& boxes, size_t count, const glm::vec4 planes[6],
+                 uint8_t* visible) {
+    switch (GetActiveIsa()) {
+#if defined(GFX_VERTEX_KERNELS_X86)
+    case Isa::AVX2:
+        return CullAabbsAVX2(boxes, count, planes, visible);
+    case Isa::SSE4:
+        return CullAabbsSSE4(boxes, count, planes, visible);
+#endif
+    default:
+        return CullAabbsScalar(boxes, 0, count, planes, visible);
+    }
+}
+
+} // namespace vertex_kernels
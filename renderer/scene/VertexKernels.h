@@ -0,0 +1,72 @@
+/// @file  VertexKernels.h
+/// @brief Batched vertex attribute transform and bounds culling kernels with runtime ISA
+///        selection.
+
+#pragma once
+
+// Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Third-Party Library Headers
+#include <glm/glm.hpp>
+
+// Project Headers
+#include "Model.h"
+
+namespace vertex_kernels {
+
+// Instruction sets the kernels are compiled for. Only Scalar is available on non-x86 targets.
+enum class Isa { Scalar = 0, SSE4, AVX2 };
+
+// Best instruction set supported by the running CPU.
+Isa GetSupportedIsa();
+
+// Instruction set used by the kernels. Defaults to the best supported one.
+Isa GetActiveIsa();
+
+// Overrides the active instruction set (clamped to what the CPU supports).
+void SetActiveIsa(Isa isa);
+
+const char* GetIsaName(Isa isa);
+bool ParseIsa(std::string_view name, Isa& isa);
+
+// Transforms `count` float3 positions read with a byte stride, writes them to dst[i]._position
+// and folds them into [minBounds, maxBounds].
+void TransformPositions(const uint8_t* src, size_t stride, size_t count, const glm::mat4& matrix,
+                        Model::Vertex* dst, glm::vec3& minBounds, glm::vec3& maxBounds);
+
+// Transforms and renormalizes `count` float3 normals into dst[i]._normal.
+void TransformNormals(const uint8_t* src, size_t stride, size_t count, const glm::mat3& matrix,
+                      Model::Vertex* dst);
+
+// Transforms and renormalizes the xyz of `count` float4 tangents into dst[i]._tangent,
+// preserving the handedness in w.
+void TransformTangents(const uint8_t* src, size_t stride, size_t count, const glm::mat3& matrix,
+                       Model::Vertex* dst);
+
+// Adds each triangle's tangent and bitangent (dP/du and dP/dv, unnormalized so that larger
+// triangles weigh more) to frames[2 * v] and frames[2 * v + 1] of its three vertices, where
+// v = index - baseVertex. `vertices` starts at baseVertex.
+void AccumulateTangentFrames(const Model::Vertex* vertices, const uint32_t* indices,
+                             size_t triangleCount, uint32_t baseVertex, glm::vec4* frames);
+
+// Orthonormalizes `count` accumulated frames against dst[i]._normal (Gram-Schmidt) and writes
+// the unit tangent and its handedness to dst[i]._tangent. Vertices without a usable frame get
+// any tangent perpendicular to the normal.
+void OrthonormalizeTangentFrames(const glm::vec4* frames, size_t count, Model::Vertex* dst);
+
+// Axis-aligned boxes in structure-of-arrays form: box i spans _min[axis][i] to _max[axis][i].
+struct AabbArrays {
+    const float* _min[3]{};
+    const float* _max[3]{};
+};
+
+// Tests `count` boxes against six planes (xyz pointing inwards, e.g. from a frustum) and sets
+// visible[i] to 1 if box i reaches inside all of them, 0 otherwise. Returns the number of
+// visible boxes. AVX2 tests eight boxes at a time and SSE4 four; all paths agree exactly.
+size_t CullAabbs(const AabbArrays& boxes, size_t count, const glm::vec4 planes[6],
+                 uint8_t* visible);
+
+} // namespace vertex_kernels
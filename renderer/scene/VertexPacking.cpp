@@ -0,0 +1,161 @@
+// Class Header
+#include "VertexPacking.h"
+
+// Standard Library Headers
+#include <algorithm>
+#include <cmath>
+
+// Project Headers
+#include "ThreadPool.h"
+
+//----------------------------------------------------------------------
+// Internal Utility Functions
+
+namespace {
+
+float SignNotZero(float value) {
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+// Angle between two directions in degrees (zero-length inputs are treated as exact).
+float AngleBetween(const glm::vec3& a, const glm::vec3& b) {
+    const float lengths = glm::length(a) * glm::length(b);
+    if (lengths <= 0.0f) {
+        return 0.0f;
+    }
+    const float cosine = std::clamp(glm::dot(a, b) / lengths, -1.0f, 1.0f);
+    return glm::degrees(std::acos(cosine));
+}
+
+float MaxComponent(const glm::vec3& v) {
+    return std::max(v.x, std::max(v.y, v.z));
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// Vertex Packing Functions
+
+namespace vertex_packing {
+
+glm::vec2 OctahedralEncode(const glm::vec3& direction) {
+    const float l1 = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+    if (l1 <= 0.0f) {
+        return glm::vec2(0.0f); // Decodes to +Z
+    }
+
+    glm::vec2 encoded = glm::vec2(direction.x, direction.y) / l1;
+    if (direction.z < 0.0f) {
+        // Fold the lower hemisphere over the diagonals.
+        encoded = glm::vec2((1.0f - std::abs(encoded.y)) * SignNotZero(encoded.x),
+                            (1.0f - std::abs(encoded.x)) * SignNotZero(encoded.y));
+    }
+    return encoded;
+}
+
+glm::vec3 OctahedralDecode(const glm::vec2& encoded) {
+    glm::vec3 direction(encoded.x, encoded.y,
+                        1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+    const float fold = std::max(-direction.z, 0.0f);
+    direction.x += direction.x >= 0.0f ? -fold : fold;
+    direction.y += direction.y >= 0.0f ? -fold : fold;
+    return glm::normalize(direction);
+}
+
+PackStats PackVertices(const std::vector<Model::SubMesh>& subMeshes,
+                       const std::vector<Model::Vertex>& vertices,
+                       std::vector<PackedVertex>& packedVertices,
+                       std::vector<Dequantization>& dequantization) {
+    packedVertices.assign(vertices.size(), PackedVertex{});
+    dequantization.assign(subMeshes.size(), Dequantization{});
+
+    std::vector<PackStats> subMeshStats(subMeshes.size());
+
+    // Submeshes own disjoint vertex ranges, so they can be packed independently.
+    ThreadPool::Shared().ParallelFor(subMeshes.size(), [&](size_t s) {
+        const Model::SubMesh& subMesh = subMeshes[s];
+        const size_t first = std::min<size_t>(subMesh._firstVertex, vertices.size());
+        const size_t last = std::min<size_t>(first + subMesh._vertexCount, vertices.size());
+
+        const glm::vec3 extent = glm::max(subMesh._maxBounds - subMesh._minBounds, glm::vec3(0.0f));
+        const glm::vec3 invExtent(extent.x > 0.0f ? 1.0f / extent.x : 0.0f,
+                                  extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+                                  extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+        dequantization[s] = {._offset = subMesh._minBounds, ._scale = extent};
+
+        PackStats& stats = subMeshStats[s];
+        for (size_t i = first; i < last; ++i) {
+            const Model::Vertex& src = vertices[i];
+            PackedVertex& dst = packedVertices[i];
+
+            const glm::vec3 unorm = (src._position - subMesh._minBounds) * invExtent;
+            const float handedness = src._tangent.w < 0.0f ? 0.0f : 1.0f;
+            dst._positionXY = glm::packUnorm2x16(glm::vec2(unorm.x, unorm.y));
+            dst._positionZW = glm::packUnorm2x16(glm::vec2(unorm.z, handedness));
+            dst._normal = glm::packSnorm2x16(OctahedralEncode(src._normal));
+            dst._tangent = glm::packSnorm2x16(OctahedralEncode(glm::vec3(src._tangent)));
+            dst._texCoord0 = glm::packHalf2x16(src._texCoord0);
+            dst._texCoord1 = glm::packHalf2x16(src._texCoord1);
+            dst._color = glm::packUnorm4x8(src._color);
+
+            // Decode again the way the shader does to track the worst-case error.
+            const glm::vec2 xy = glm::unpackUnorm2x16(dst._positionXY);
+            const glm::vec2 zw = glm::unpackUnorm2x16(dst._positionZW);
+            const glm::vec3 position = subMesh._minBounds + extent * glm::vec3(xy, zw.x);
+            stats._maxPositionError =
+                std::max(stats._maxPositionError, MaxComponent(glm::abs(position - src._position)));
+
+            const glm::vec3 normal = OctahedralDecode(glm::unpackSnorm2x16(dst._normal));
+            const glm::vec3 tangent = OctahedralDecode(glm::unpackSnorm2x16(dst._tangent));
+            stats._maxNormalError =
+                std::max({stats._maxNormalError, AngleBetween(normal, src._normal),
+                          AngleBetween(tangent, glm::vec3(src._tangent))});
+
+            const glm::vec2 uvError =
+                glm::max(glm::abs(glm::unpackHalf2x16(dst._texCoord0) - src._texCoord0),
+                         glm::abs(glm::unpackHalf2x16(dst._texCoord1) - src._texCoord1));
+            stats._maxTexCoordError =
+                std::max({stats._maxTexCoordError, uvError.x, uvError.y});
+        }
+    });
+
+    PackStats total;
+    for (const PackStats& stats : subMeshStats) {
+        total._maxPositionError = std::max(total._maxPositionError, stats._maxPositionError);
+        total._maxNormalError = std::max(total._maxNormalError, stats._maxNormalError);
+        total._maxTexCoordError = std::max(total._maxTexCoordError, stats._maxTexCoordError);
+    }
+    return total;
+}
+
+void SplitStreams(const std::vector<Model::Vertex>& vertices, std::vector<glm::vec3>& positions,
+                  std::vector<VertexAttributes>& attributes) {
+    positions.resize(vertices.size());
+    attributes.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Model::Vertex& src = vertices[i];
+        positions[i] = src._position;
+        attributes[i] = {._normal = src._normal,
+                         ._tangent = src._tangent,
+                         ._texCoord0 = src._texCoord0,
+                         ._texCoord1 = src._texCoord1,
+                         ._color = src._color};
+    }
+}
+
+void SplitStreams(const std::vector<PackedVertex>& vertices, std::vector<PackedPosition>& positions,
+                  std::vector<PackedAttributes>& attributes) {
+    positions.resize(vertices.size());
+    attributes.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const PackedVertex& src = vertices[i];
+        positions[i] = {._positionXY = src._positionXY, ._positionZW = src._positionZW};
+        attributes[i] = {._normal = src._normal,
+                         ._tangent = src._tangent,
+                         ._texCoord0 = src._texCoord0,
+                         ._texCoord1 = src._texCoord1,
+                         ._color = src._color};
+    }
+}
+
+} // namespace vertex_packing
@@ -0,0 +1,84 @@
+/// @file  VertexPacking.h
+/// @brief Quantized and split vertex layouts for GPU upload and the encoders that produce them.
+
+#pragma once
+
+// Standard Library Headers
+#include <cstdint>
+#include <vector>
+
+// Third-Party Library Headers
+#include <glm/glm.hpp>
+
+// Project Headers
+#include "Model.h"
+
+namespace vertex_packing {
+
+// 28-byte counterpart of Model::Vertex (88 bytes). Every field is a pair of 16-bit or four 8-bit
+// components, matching the WebGPU vertex formats noted next to each member.
+struct PackedVertex {
+    uint32_t _positionXY{0}; // Unorm16x4 (with _positionZW): xyz within the submesh bounds,
+    uint32_t _positionZW{0}; // w = tangent handedness (0 = -1, 1 = +1)
+    uint32_t _normal{0};     // Snorm16x2, octahedral
+    uint32_t _tangent{0};    // Snorm16x2, octahedral
+    uint32_t _texCoord0{0};  // Float16x2
+    uint32_t _texCoord1{0};  // Float16x2
+    uint32_t _color{0};      // Unorm8x4
+};
+static_assert(sizeof(PackedVertex) == 28, "PackedVertex must stay tightly packed");
+
+// Split-stream layouts: positions in their own tightly packed stream so depth-only passes fetch
+// 12 (or 8 when packed) bytes per vertex, and the shading attributes in a second stream.
+struct VertexAttributes {
+    glm::vec3 _normal{0.0f, 0.0f, 1.0f};
+    glm::vec4 _tangent{0.0f, 0.0f, 0.0f, 1.0f};
+    glm::vec2 _texCoord0{0.0f};
+    glm::vec2 _texCoord1{0.0f};
+    glm::vec4 _color{1.0f};
+};
+
+struct PackedPosition {
+    uint32_t _positionXY{0}; // Same encoding as PackedVertex
+    uint32_t _positionZW{0};
+};
+
+struct PackedAttributes {
+    uint32_t _normal{0};
+    uint32_t _tangent{0};
+    uint32_t _texCoord0{0};
+    uint32_t _texCoord1{0};
+    uint32_t _color{0};
+};
+
+// Per-submesh position decode: position = _offset + _scale * unorm.xyz.
+struct Dequantization {
+    glm::vec3 _offset{0.0f};
+    glm::vec3 _scale{1.0f};
+};
+
+// Worst-case round-trip error over all packed vertices.
+struct PackStats {
+    float _maxPositionError{0.0f}; // Model units
+    float _maxNormalError{0.0f};   // Degrees, normals and tangents
+    float _maxTexCoordError{0.0f}; // UV units
+};
+
+// Maps a unit vector onto the [-1, 1] square (octahedral encoding) and back.
+glm::vec2 OctahedralEncode(const glm::vec3& direction);
+glm::vec3 OctahedralDecode(const glm::vec2& encoded);
+
+// Packs the vertices of every submesh against that submesh's bounds. `dequantization` receives
+// one entry per submesh; vertices outside all submesh ranges are left zeroed.
+PackStats PackVertices(const std::vector<Model::SubMesh>& subMeshes,
+                       const std::vector<Model::Vertex>& vertices,
+                       std::vector<PackedVertex>& packedVertices,
+                       std::vector<Dequantization>& dequantization);
+
+// Splits interleaved vertices into a position stream and an attribute stream.
+void SplitStreams(const std::vector<Model::Vertex>& vertices, std::vector<glm::vec3>& positions,
+                  std::vector<VertexAttributes>& attributes);
+void SplitStreams(const std::vector<PackedVertex>& vertices, std::vector<PackedPosition>& positions,
+                  std::vector<PackedAttributes>& attributes);
+
+} // namespace vertex_packing
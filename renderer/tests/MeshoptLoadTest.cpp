@@ -0,0 +1,188 @@
+/// @file  MeshoptLoadTest.cpp
+/// @brief Loads an EXT_meshopt_compression model through every Model::Load path.
+
+// Standard Library Headers
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Project Headers
+#include "Model.h"
+
+//----------------------------------------------------------------------
+// Internal Constants and Utility Functions
+
+namespace {
+
+constexpr float kPositions[3][3] = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+constexpr uint16_t kIndices[3] = {0, 1, 2};
+constexpr size_t kVertexStride = sizeof(kPositions[0]);
+constexpr size_t kVertexCount = 3;
+constexpr size_t kIndexCount = 3;
+constexpr size_t kFallbackSize = 1024; // Larger than the BIN chunk, as decoded data usually is
+
+void AppendU32(std::vector<uint8_t>& bytes, uint32_t value) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&value);
+    bytes.insert(bytes.end(), data, data + sizeof(value));
+}
+
+// Vertex codec with every byte group stored raw (8 bits per value); fits one block.
+std::vector<uint8_t> EncodeVertices() {
+    const auto* vertices = reinterpret_cast<const uint8_t*>(kPositions);
+    std::vector<uint8_t> encoded = {0xa0};
+    for (size_t k = 0; k < kVertexStride; ++k) {
+        encoded.push_back(3); // One group of 16 values, 8 bits each
+        uint8_t previous = vertices[k];
+        for (size_t i = 0; i < 16; ++i) {
+            const uint8_t value = i < kVertexCount ? vertices[i * kVertexStride + k] : previous;
+            const auto delta = static_cast<uint8_t>(value - previous);
+            encoded.push_back(static_cast<uint8_t>((delta << 1) ^ (delta & 0x80 ? 0xff : 0)));
+            previous = value;
+        }
+    }
+    // Tail: padded to 32 bytes, ending with the first vertex.
+    encoded.insert(encoded.end(), 32 - kVertexStride, 0);
+    encoded.insert(encoded.end(), vertices, vertices + kVertexStride);
+    return encoded;
+}
+
+// Index sequence codec with small positive deltas against baseline 0.
+std::vector<uint8_t> EncodeIndices() {
+    std::vector<uint8_t> encoded = {0xd1};
+    uint32_t last = 0;
+    for (uint16_t index : kIndices) {
+        encoded.push_back(static_cast<uint8_t>((index - last) << 2));
+        last = index;
+    }
+    encoded.insert(encoded.end(), 4, 0);
+    return encoded;
+}
+
+// Both compressed streams go in buffer 0, 4-byte aligned; the fallback buffer they decode into
+// has no bytes in the file.
+struct Fixture {
+    std::vector<uint8_t> _bin;
+    std::string _json;
+};
+
+Fixture BuildFixture(const std::string& binUri) {
+    Fixture fixture;
+    const std::vector<uint8_t> vertices = EncodeVertices();
+    const std::vector<uint8_t> indices = EncodeIndices();
+    fixture._bin = vertices;
+    fixture._bin.resize((fixture._bin.size() + 3) & ~size_t{3}, 0);
+    const size_t indicesOffset = fixture._bin.size();
+    fixture._bin.insert(fixture._bin.end(), indices.begin(), indices.end());
+    fixture._bin.resize((fixture._bin.size() + 3) & ~size_t{3}, 0);
+
+    const size_t vertexBytes = kVertexCount * kVertexStride;
+    const std::string uri = binUri.empty() ? "" : "\"uri\":\"" + binUri + "\",";
+    fixture._json =
+        R"({"asset":{"version":"2.0"},)"
+        R"("extensionsUsed":["EXT_meshopt_compression"],)"
+        R"("extensionsRequired":["EXT_meshopt_compression"],)"
+        R"("buffers":[{)" + uri + R"("byteLength":)" + std::to_string(fixture._bin.size()) +
+        R"(},{"byteLength":)" + std::to_string(kFallbackSize) +
+        R"(,"extensions":{"EXT_meshopt_compression":{"fallback":true}}}],)"
+        R"("bufferViews":[)"
+        R"({"buffer":1,"byteOffset":0,"byteLength":)" + std::to_string(vertexBytes) +
+        R"(,"byteStride":12,"extensions":{"EXT_meshopt_compression":{"buffer":0,)"
+        R"("byteOffset":0,"byteLength":)" + std::to_string(vertices.size()) +
+        R"(,"byteStride":12,"count":3,"mode":"ATTRIBUTES"}}},)"
+        R"({"buffer":1,"byteOffset":)" + std::to_string(vertexBytes) +
+        R"(,"byteLength":6,"extensions":{"EXT_meshopt_compression":{"buffer":0,)"
+        R"("byteOffset":)" + std::to_string(indicesOffset) +
+        R"(,"byteLength":)" + std::to_string(indices.size()) +
+        R"(,"byteStride":2,"count":3,"mode":"INDICES"}}}],)"
+        R"("accessors":[)"
+        R"({"bufferView":0,"componentType":5126,"count":3,"type":"VEC3",)"
+        R"("min":[0,0,0],"max":[1,1,0]},)"
+        R"({"bufferView":1,"componentType":5123,"count":3,"type":"SCALAR"}],)"
+        R"("materials":[{}],)"
+        R"("meshes":[{"primitives":[{"attributes":{"POSITION":0},"indices":1,"material":0}]}],)"
+        R"("nodes":[{"mesh":0}],"scenes":[{"nodes":[0]}],"scene":0})";
+    return fixture;
+}
+
+std::vector<uint8_t> BuildGlb(const Fixture& fixture) {
+    std::string json = fixture._json;
+    json.resize((json.size() + 3) & ~size_t{3}, ' ');
+    std::vector<uint8_t> glb;
+    AppendU32(glb, 0x46546C67); // "glTF"
+    AppendU32(glb, 2);
+    AppendU32(glb, static_cast<uint32_t>(12 + 8 + json.size() + 8 + fixture._bin.size()));
+    AppendU32(glb, static_cast<uint32_t>(json.size()));
+    AppendU32(glb, 0x4E4F534A); // "JSON"
+    glb.insert(glb.end(), json.begin(), json.end());
+    AppendU32(glb, static_cast<uint32_t>(fixture._bin.size()));
+    AppendU32(glb, 0x004E4942); // "BIN\0"
+    glb.insert(glb.end(), fixture._bin.begin(), fixture._bin.end());
+    return glb;
+}
+
+void WriteFile(const std::filesystem::path& path, const void* data, size_t size) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+bool CheckModel(const char* name, const Model& model) {
+    const std::vector<Model::Vertex>& vertices = model.GetVertices();
+    const std::vector<uint32_t>& indices = model.GetIndices();
+    bool ok = vertices.size() == kVertexCount && indices.size() == kIndexCount;
+    for (size_t i = 0; ok && i < kIndexCount; ++i) {
+        const Model::Vertex& vertex = vertices[indices[i]];
+        ok = indices[i] == kIndices[i] &&
+             std::memcmp(&vertex._position, kPositions[i], kVertexStride) == 0;
+    }
+    std::cout << (ok ? "PASS " : "FAIL ") << name << std::endl;
+    return ok;
+}
+
+} // namespace
+
+//----------------------------------------------------------------------
+// Entry Point
+
+int main() {
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "gfx_meshopt_load_test";
+    std::filesystem::create_directories(directory);
+
+    bool ok = true;
+
+    // GLB from memory: the fallback buffer is larger than the BIN chunk.
+    const std::vector<uint8_t> glb = BuildGlb(BuildFixture(""));
+    {
+        Model model;
+        model.Load("meshopt.glb", glb.data(), static_cast<uint32_t>(glb.size()));
+        ok = CheckModel("glb from memory", model) && ok;
+    }
+
+    // GLB from file (memory-mapped where the platform supports it).
+    {
+        const std::filesystem::path path = directory / "meshopt.glb";
+        WriteFile(path, glb.data(), glb.size());
+        Model model;
+        model.Load(path.generic_string());
+        ok = CheckModel("glb from file", model) && ok;
+    }
+
+    // .gltf: a uri-less fallback buffer is otherwise rejected outright.
+    {
+        const Fixture fixture = BuildFixture("meshopt.bin");
+        WriteFile(directory / "meshopt.bin", fixture._bin.data(), fixture._bin.size());
+        const std::filesystem::path path = directory / "meshopt.gltf";
+        WriteFile(path, fixture._json.data(), fixture._json.size());
+        Model model;
+        model.Load(path.generic_string());
+        ok = CheckModel("gltf from file", model) && ok;
+    }
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    return ok ? 0 : 1;
+}
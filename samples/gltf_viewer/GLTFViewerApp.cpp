@@ -14,18 +14,67 @@
 #include "BackendRegistry.h"
 #include "application/Camera.h"
 #include "application/OrbitControls.h"
+#include "renderer/scene/VertexKernels.h"
 
 namespace {
 
 constexpr uint32_t kDefaultWidth = 800;
 constexpr uint32_t kDefaultHeight = 600;
 
+// Frames between --frame-stats reports.
+constexpr uint32_t kFrameStatsInterval = 300;
+
 void RepositionCamera(Camera& camera, const Model& model) {
     glm::vec3 minBounds{}, maxBounds{};
     model.GetBounds(minBounds, maxBounds);
     camera.ResetToModel(minBounds, maxBounds);
 }
 
+// Returns the value of `--name=value` or `--name value`, or an empty view if absent.
+std::string_view FindArgValue(int argc, char** argv, std::string_view name) {
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg{argv[i]};
+        if (!arg.starts_with(name)) {
+            continue;
+        }
+        if (arg.size() > name.size() && arg[name.size()] == '=') {
+            return arg.substr(name.size() + 1);
+        }
+        if (arg.size() == name.size() && i + 1 < argc) {
+            return argv[i + 1];
+        }
+    }
+    return {};
+}
+
+bool HasArg(int argc, char** argv, std::string_view name) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view{argv[i]} == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Optional override of the vertex transform kernels (e.g. to compare against scalar code).
+void ApplyVertexKernelsArg(int argc, char** argv) {
+    const std::string_view value = FindArgValue(argc, argv, "--vertex-kernels");
+    if (value.empty()) {
+        return;
+    }
+
+    vertex_kernels::Isa isa{};
+    if (!vertex_kernels::ParseIsa(value, isa)) {
+        std::cerr << "Unknown --vertex-kernels value '" << value
+                  << "' (expected scalar, sse4 or avx2)" << std::endl;
+        return;
+    }
+
+    vertex_kernels::SetActiveIsa(isa);
+    std::cout << "Vertex kernels: " << vertex_kernels::GetIsaName(vertex_kernels::GetActiveIsa())
+              << std::endl;
+}
+
 } // namespace
 
 // App factory used by the shared entrypoint in `gfx_app_entry` (AppEntryMain.cpp).
@@ -34,21 +83,42 @@ std::unique_ptr<Application> CreateApplication(int argc, char** argv) {
 }
 
 std::string GltfViewerApp::ParseBackendArg(int argc, char** argv) {
-    for (int i = 1; i < argc; ++i) {
-        std::string_view arg{argv[i]};
-        if (arg.starts_with("--backend=")) {
-            return std::string(arg.substr(10));
-        }
-        if (arg == "--backend" && i + 1 < argc) {
-            return argv[i + 1];
-        }
-    }
-    return ""; // Use registry default
+    return std::string(FindArgValue(argc, argv, "--backend")); // Empty: use registry default
 }
 
 GltfViewerApp::GltfViewerApp(int argc, char** argv) :
     Application(kDefaultWidth, kDefaultHeight, "gltf_viewer"),
-    _backendName(ParseBackendArg(argc, argv)) {}
+    _backendName(ParseBackendArg(argc, argv)) {
+    ApplyVertexKernelsArg(argc, argv);
+
+    // Mesh optimization applies to the default model and to dropped files alike.
+    Model::LoadOptions loadOptions;
+    loadOptions._reduceOverdraw = HasArg(argc, argv, "--reduce-overdraw");
+    loadOptions._optimizeMeshes =
+        loadOptions._reduceOverdraw || HasArg(argc, argv, "--optimize-meshes");
+    loadOptions._generateLods = HasArg(argc, argv, "--generate-lods");
+    loadOptions._buildMeshlets = HasArg(argc, argv, "--meshlet-culling");
+    if (HasArg(argc, argv, "--fast-tangents")) {
+        loadOptions._tangentGenerator = Model::TangentGenerator::Fast;
+    }
+    loadOptions._validateTangents = HasArg(argc, argv, "--validate-tangents");
+    loadOptions._regenerateTangents = HasArg(argc, argv, "--regenerate-tangents");
+    loadOptions._textureCacheDir = FindArgValue(argc, argv, "--texture-cache");
+    loadOptions._compressTextures =
+        !loadOptions._textureCacheDir.empty() || HasArg(argc, argv, "--compress-textures");
+    _model.SetLoadOptions(loadOptions);
+
+    _rendererOptions.packedVertices = HasArg(argc, argv, "--packed-vertices");
+    _rendererOptions.splitVertexStreams = HasArg(argc, argv, "--split-vertex-streams");
+    _rendererOptions.depthPrepass = HasArg(argc, argv, "--depth-prepass");
+    _rendererOptions.meshletCulling = loadOptions._buildMeshlets;
+    _rendererOptions.frustumCulling = !HasArg(argc, argv, "--no-frustum-culling");
+    _rendererOptions.occlusionCulling = HasArg(argc, argv, "--occlusion-culling");
+    _rendererOptions.gpuDrivenDraws =
+        _rendererOptions.occlusionCulling || HasArg(argc, argv, "--gpu-driven");
+    _rendererOptions.renderBundles = HasArg(argc, argv, "--render-bundles");
+    _printFrameStats = HasArg(argc, argv, "--frame-stats");
+}
 
 GltfViewerApp::~GltfViewerApp() = default;
 
@@ -69,6 +139,7 @@ void GltfViewerApp::OnInit() {
         return;
     }
 
+    _renderer->SetOptions(_rendererOptions);
     _renderer->Initialize(GetWindow(), _environment, _model);
 
     // Store the actual backend name (in case we used the default).
@@ -110,6 +181,7 @@ void GltfViewerApp::SwitchToNextBackend() {
     }
 
     // Initialize with the current model and environment.
+    _renderer->SetOptions(_rendererOptions);
     _renderer->Initialize(GetWindow(), _environment, _model);
 }
 
@@ -127,6 +199,19 @@ void GltfViewerApp::OnFrame(float dtSeconds) {
     };
 
     _renderer->Render(_model.GetTransform(), cameraInput);
+
+    if (_printFrameStats && ++_frameCount % kFrameStatsInterval == 0) {
+        const FrameStats stats = _renderer->GetFrameStats();
+        std::cout << "Frame stats: " << stats.culledSubMeshes << " of " << stats.subMeshes
+                  << " submeshes culled, " << stats.drawCalls << " draw calls, "
+                  << stats.opaqueMaterialBinds << " opaque material binds, "
+                  << stats.encodeMilliseconds << "ms encoding";
+        if (_rendererOptions.occlusionCulling) {
+            std::cout << ", " << stats.occludedSubMeshes << " occluded ("
+                      << stats.occludedTriangles << " triangles skipped)";
+        }
+        std::cout << std::endl;
+    }
 }
 
 void GltfViewerApp::OnResize(int width, int height) {
@@ -38,9 +38,12 @@ class GltfViewerApp final : public Application {
 
     std::string _backendName;
     bool _animateModel{true};
+    bool _printFrameStats{false};
+    uint32_t _frameCount{0};
     Camera _camera;
     Environment _environment;
     Model _model;
+    RendererOptions _rendererOptions;
     std::unique_ptr<IRenderer> _renderer;
     std::unique_ptr<OrbitControls> _controls;
 };